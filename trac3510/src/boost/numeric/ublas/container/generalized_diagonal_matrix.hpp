@@ -17,6 +17,7 @@
 
 #include <algorithm>
 //#include <boost/numeric/ublas/detail/matrix_assign.hpp>
+#include <boost/numeric/ublas/detail/expression_alias.hpp>
 #include <boost/numeric/ublas/detail/temporary.hpp>
 #include <boost/numeric/ublas/expression_types.hpp>
 #include <boost/numeric/ublas/fwd.hpp>
@@ -518,6 +519,15 @@ class generalized_diagonal_matrix: public matrix_container<generalized_diagonal_
 		BOOST_UBLAS_INLINE
 		generalized_diagonal_matrix& operator=(matrix_expression<ExprT> const& me)
 	{
+		// No temporary is needed if the shape does not change and the
+		// expression provably does not read our storage
+		if (me().size1() == size1_ && me().size2() == size2_ && !needs_temporary(me()))
+		{
+			matrix_assign<scalar_assign>(*this, me);
+
+			return *this;
+		}
+
 		self_type temporary(me, k_);
 
 		return assign_temporary(temporary);
@@ -538,6 +548,27 @@ class generalized_diagonal_matrix: public matrix_container<generalized_diagonal_
 		BOOST_UBLAS_INLINE
 		generalized_diagonal_matrix& operator=(vector_expression<ExprT> const& ve)
 	{
+		typedef typename ExprT::size_type ve_size_type;
+
+		ve_size_type ve_size = ve().size();
+
+		if (
+			ve_size == data().size()
+			&& size1_ == ve_size + r_
+			&& size2_ == ve_size + c_
+			&& !needs_temporary(ve())
+		) {
+			for (
+				ve_size_type i = 0;
+				i < ve_size;
+				++i
+			) {
+				(*this)(i+r_, i+c_) = ve()(i);
+			}
+
+			return *this;
+		}
+
 		self_type temporary(ve, k_);
 
 		return assign_temporary(temporary);
@@ -556,6 +587,11 @@ class generalized_diagonal_matrix: public matrix_container<generalized_diagonal_
 		BOOST_UBLAS_INLINE
 		generalized_diagonal_matrix& operator+=(matrix_expression<ExprT> const& me)
 	{
+		if (!needs_temporary(me()))
+		{
+			return plus_assign(me);
+		}
+
 		self_type temporary(*this + me, k_);
 
 		return assign_temporary(temporary);
@@ -576,6 +612,11 @@ class generalized_diagonal_matrix: public matrix_container<generalized_diagonal_
 		BOOST_UBLAS_INLINE
 		generalized_diagonal_matrix& operator-=(matrix_expression<ExprT> const& me)
 	{
+		if (!needs_temporary(me()))
+		{
+			return minus_assign(me);
+		}
+
 		self_type temporary(*this - me, k_);
 
 		return assign_temporary(temporary);
@@ -612,6 +653,23 @@ class generalized_diagonal_matrix: public matrix_container<generalized_diagonal_
 	}
 
 
+	/**
+	 * \brief Tell if assigning the given expression needs a temporary.
+	 *
+	 * This is the case when the expression may read the storage of this
+	 * matrix (the check is conservative, see
+	 * \c detail::expression_may_alias), and when the storage is a view, which
+	 * whole assignments detach.
+	 */
+	private: template <typename ExprT>
+		BOOST_UBLAS_INLINE
+		bool needs_temporary(ExprT const& e) const
+	{
+		return detail::array_is_view(data())
+			   || detail::expression_may_alias(e, detail::array_extent(data()));
+	}
+
+
 	//@} Assignment
 
 	//@{ Swapping
@@ -1635,6 +1693,156 @@ template<class ValueT, class LayoutT, class ArrayT>
 typename generalized_diagonal_matrix<ValueT,LayoutT,ArrayT>::const_value_type generalized_diagonal_matrix<ValueT,LayoutT,ArrayT>::zero_ = generalized_diagonal_matrix<ValueT,LayoutT,ArrayT>::value_type/*zero*/();
 
 
+namespace detail {
+
+/// \brief Alias analysis of generalized diagonal matrices: the stored diagonal.
+template <typename ValueT, typename LayoutT, typename ArrayT>
+struct storage_alias_traits< generalized_diagonal_matrix<ValueT, LayoutT, ArrayT> >
+{
+	static BOOST_UBLAS_INLINE
+		storage_extent extent(generalized_diagonal_matrix<ValueT, LayoutT, ArrayT> const& m)
+	{
+		return array_extent(m.data());
+	}
+};
+
+} // Namespace detail
+
+
+//@{ Direct solution and inversion
+
+/**
+ * \brief Solve the system \f$Dx=b\f$ in the least-squares sense.
+ * \tparam ValueT The type of matrix values.
+ * \tparam LayoutT The matrix layout type.
+ * \tparam ArrayT The type of the array storing the matrix.
+ * \tparam VectorT A model of VectorExpression.
+ * \param D A generalized diagonal matrix of size \f$m \times n\f$.
+ * \param b A vector expression of size \f$m\f$.
+ * \return The minimum-norm least-squares solution \f$x=D^{+}b\f$, a vector of
+ *  size \f$n\f$.
+ *
+ * Since the only non-zero entries of \a D are the \f$d_p\f$ at position
+ * \f$(p+r,p+c)\f$, the solution is computed with a single shifted elementwise
+ * division \f$x_{p+c}=b_{p+r}/d_p\f$, in \f$O(n)\f$ time and without any
+ * factorization.
+ * Zero diagonal entries and components of \a x not touched by the diagonal
+ * are set to zero, as prescribed by the pseudo-inverse.
+ * For a nonsingular square matrix with offset 0 this is the ordinary
+ * solution \f$x=D^{-1}b\f$.
+ */
+template <typename ValueT, typename LayoutT, typename ArrayT, typename VectorT>
+BOOST_UBLAS_INLINE
+vector<typename promote_traits<ValueT, typename VectorT::value_type>::promote_type> solve(generalized_diagonal_matrix<ValueT,LayoutT,ArrayT> const& D, vector_expression<VectorT> const& b)
+{
+	typedef generalized_diagonal_matrix<ValueT,LayoutT,ArrayT> matrix_type;
+	typedef typename matrix_type::size_type size_type;
+	typedef typename matrix_type::difference_type difference_type;
+	typedef typename promote_traits<ValueT, typename VectorT::value_type>::promote_type result_value_type;
+	typedef vector<result_value_type> result_type;
+
+	BOOST_UBLAS_CHECK(b().size() == D.size1(), bad_size());
+
+	const difference_type k(D.offset());
+	const size_type r(k < 0 ? -k : 0);
+	const size_type c(k > 0 ?  k : 0);
+	const size_type n(D.data().size());
+
+	result_type x(D.size2(), result_value_type/*zero*/());
+
+	for (size_type p = 0; p < n; ++p)
+	{
+		const ValueT d(D.data()[p]);
+
+		if (d != ValueT/*zero*/())
+		{
+			x(p+c) = b()(p+r) / d;
+		}
+	}
+
+	return x;
+}
+
+
+/**
+ * \brief Solve in-place the system \f$Dx=b\f$ for a square diagonal matrix.
+ * \tparam ValueT The type of matrix values.
+ * \tparam LayoutT The matrix layout type.
+ * \tparam ArrayT The type of the array storing the matrix.
+ * \tparam VectorT A model of Vector.
+ * \param D A square generalized diagonal matrix with offset 0.
+ * \param b On entry the right-hand side, on exit the solution.
+ *
+ * This is the allocation-free counterpart of \c solve for the main diagonal
+ * case, where the solution is a plain elementwise division.
+ * Raises \c singular if a diagonal entry is zero.
+ */
+template <typename ValueT, typename LayoutT, typename ArrayT, typename VectorT>
+BOOST_UBLAS_INLINE
+void inplace_solve(generalized_diagonal_matrix<ValueT,LayoutT,ArrayT> const& D, vector_expression<VectorT>& b)
+{
+	typedef generalized_diagonal_matrix<ValueT,LayoutT,ArrayT> matrix_type;
+	typedef typename matrix_type::size_type size_type;
+
+	BOOST_UBLAS_CHECK(D.offset() == 0, external_logic());
+	BOOST_UBLAS_CHECK(D.size1() == D.size2(), bad_size());
+	BOOST_UBLAS_CHECK(b().size() == D.size1(), bad_size());
+
+	const size_type n(D.data().size());
+
+	for (size_type p = 0; p < n; ++p)
+	{
+		const ValueT d(D.data()[p]);
+
+		if (d == ValueT/*zero*/())
+		{
+			singular().raise();
+		}
+
+		b()(p) /= d;
+	}
+}
+
+
+/**
+ * \brief Compute the (pseudo-)inverse of a generalized diagonal matrix.
+ * \tparam ValueT The type of matrix values.
+ * \tparam LayoutT The matrix layout type.
+ * \tparam ArrayT The type of the array storing the matrix.
+ * \param D A generalized diagonal matrix of size \f$m \times n\f$ and offset
+ *  \f$k\f$.
+ * \return The \f$n \times m\f$ generalized diagonal matrix with offset
+ *  \f$-k\f$ which is the Moore-Penrose pseudo-inverse \f$D^{+}\f$ of \a D.
+ *
+ * Each non-zero diagonal entry is replaced by its reciprocal, while zero
+ * entries are left to zero.
+ * For a nonsingular square matrix with offset 0 this is the ordinary inverse.
+ * The cost is \f$O(n)\f$ and the only allocation is the one of the result.
+ */
+template <typename ValueT, typename LayoutT, typename ArrayT>
+BOOST_UBLAS_INLINE
+generalized_diagonal_matrix<ValueT,LayoutT,ArrayT> inverse(generalized_diagonal_matrix<ValueT,LayoutT,ArrayT> const& D)
+{
+	typedef generalized_diagonal_matrix<ValueT,LayoutT,ArrayT> matrix_type;
+	typedef typename matrix_type::size_type size_type;
+
+	matrix_type R(D.size2(), D.size1(), -D.offset());
+
+	const size_type n(BOOST_UBLAS_SAME(D.data().size(), R.data().size()));
+
+	for (size_type p = 0; p < n; ++p)
+	{
+		const ValueT d(D.data()[p]);
+
+		R.data()[p] = (d != ValueT/*zero*/()) ? ValueT(1)/d : ValueT/*zero*/();
+	}
+
+	return R;
+}
+
+//@} Direct solution and inversion
+
+
 /*TODO: the code belowe is taken from banded.hpp
 // Generalized diagonal matrix adaptor class
 template <typename MatrixT>
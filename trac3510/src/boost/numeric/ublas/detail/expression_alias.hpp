@@ -0,0 +1,445 @@
+/**
+ *  \file expression_alias.hpp
+ *
+ *  \brief Conservative runtime alias analysis of expression trees.
+ *
+ *  Copyright (c) 2009, Marco Guazzone
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *  \author Marco Guazzone, marco.guazzone@gmail.com
+ */
+
+#ifndef BOOST_NUMERIC_UBLAS_DETAIL_EXPRESSION_ALIAS_HPP
+#define BOOST_NUMERIC_UBLAS_DETAIL_EXPRESSION_ALIAS_HPP
+
+#include <boost/numeric/ublas/detail/config.hpp>
+#include <boost/numeric/ublas/fwd.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_expression.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/storage/array_view.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_expression.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <functional>
+
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+/**
+ * \brief Range of memory addresses that an expression may read or write.
+ *
+ * An extent is either a half-open range of bytes, possibly empty, or
+ * \e unknown.
+ * An unknown extent overlaps with every non-empty extent; this is what is
+ * assumed for expressions whose storage cannot be inspected.
+ *
+ * \author Marco Guazzone, marco.guazzone@gmail.com
+ */
+class storage_extent
+{
+	public: BOOST_UBLAS_INLINE
+		storage_extent(void const* begin, void const* end)
+		: begin_(static_cast<char const*>(begin)),
+		  end_(static_cast<char const*>(end)),
+		  unknown_(false)
+	{
+	}
+
+
+	/// \brief The extent of an expression without storage.
+	public: static BOOST_UBLAS_INLINE
+		storage_extent empty()
+	{
+		return storage_extent(0, 0);
+	}
+
+
+	/// \brief The extent of an expression whose storage cannot be inspected.
+	public: static BOOST_UBLAS_INLINE
+		storage_extent unknown()
+	{
+		storage_extent x(0, 0);
+		x.unknown_ = true;
+		return x;
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		bool is_empty() const
+	{
+		return !unknown_ && begin_ == end_;
+	}
+
+
+	/// \brief Tell if the two extents may share at least one byte.
+	public: BOOST_UBLAS_INLINE
+		bool overlaps(storage_extent const& x) const
+	{
+		if (is_empty() || x.is_empty())
+		{
+			return false;
+		}
+		if (unknown_ || x.unknown_)
+		{
+			return true;
+		}
+
+		// std::less gives a total order also on pointers to distinct objects
+		std::less<char const*> less;
+
+		return less(begin_, x.end_) && less(x.begin_, end_);
+	}
+
+
+	private: char const* begin_;
+	private: char const* end_;
+	private: bool unknown_;
+};
+
+
+/**
+ * \brief The extent of the elements of a contiguous storage array.
+ * \tparam ArrayT A storage array whose elements are contiguous in memory, like
+ *  \c unbounded_array, \c bounded_array or \c std::vector.
+ */
+template <typename ArrayT>
+BOOST_UBLAS_INLINE
+storage_extent array_extent(ArrayT const& a)
+{
+	if (a.size() == 0)
+	{
+		return storage_extent::empty();
+	}
+	return storage_extent(&a[0], &a[0]+a.size());
+}
+
+
+/**
+ * \brief Tell if a storage array refers to memory owned by someone else.
+ *
+ * Whole assignments to containers over such arrays replace the storage (see
+ * \c array_view), so they cannot be done in place even without aliasing.
+ */
+template <typename ArrayT>
+BOOST_UBLAS_INLINE
+bool array_is_view(ArrayT const&)
+{
+	return false;
+}
+
+
+template <typename ValueT>
+BOOST_UBLAS_INLINE
+bool array_is_view(array_view<ValueT> const& a)
+{
+	return a.is_view();
+}
+
+
+/**
+ * \brief Storage read by a leaf of an expression tree.
+ * \tparam ExprT The type of the leaf.
+ *
+ * The static function \c extent returns a superset of the storage read by the
+ * expression.
+ * The primary template is used for expressions which are not known to this
+ * analysis and returns an unknown extent; containers and proxies specialize it.
+ */
+template <typename ExprT>
+struct storage_alias_traits
+{
+	static BOOST_UBLAS_INLINE
+		storage_extent extent(ExprT const&)
+	{
+		return storage_extent::unknown();
+	}
+};
+
+
+/**
+ * \brief Alias test of an expression tree.
+ * \tparam ExprT The type of the expression.
+ *
+ * The static function \c may_alias returns \c false only if the expression
+ * provably does not read the given extent.
+ * The primary template treats the expression as a leaf; the nodes of
+ * expression trees specialize it by visiting their operands.
+ */
+template <typename ExprT>
+struct expression_alias_traits
+{
+	static BOOST_UBLAS_INLINE
+		bool may_alias(ExprT const& e, storage_extent const& x)
+	{
+		return storage_alias_traits<ExprT>::extent(e).overlaps(x);
+	}
+};
+
+
+/// \brief The storage of a container or of the container behind a proxy.
+template <typename ExprT>
+BOOST_UBLAS_INLINE
+storage_extent expression_extent(ExprT const& e)
+{
+	return storage_alias_traits<ExprT>::extent(e);
+}
+
+
+/**
+ * \brief Tell if evaluating an expression may read the given extent.
+ *
+ * When this function returns \c false, the expression can be assigned to a
+ * destination whose storage is \a x without an intermediate temporary.
+ */
+template <typename ExprT>
+BOOST_UBLAS_INLINE
+bool expression_may_alias(ExprT const& e, storage_extent const& x)
+{
+	return expression_alias_traits<ExprT>::may_alias(e, x);
+}
+
+
+//@{ Containers
+
+
+template <typename ValueT, typename ArrayT>
+struct storage_alias_traits< vector<ValueT, ArrayT> >
+{
+	static BOOST_UBLAS_INLINE
+		storage_extent extent(vector<ValueT, ArrayT> const& v)
+	{
+		return array_extent(v.data());
+	}
+};
+
+
+template <typename ValueT, typename LayoutT, typename ArrayT>
+struct storage_alias_traits< matrix<ValueT, LayoutT, ArrayT> >
+{
+	static BOOST_UBLAS_INLINE
+		storage_extent extent(matrix<ValueT, LayoutT, ArrayT> const& m)
+	{
+		return array_extent(m.data());
+	}
+};
+
+
+/// \brief Expressions without storage.
+struct no_storage_alias_traits
+{
+	template <typename ExprT>
+	static BOOST_UBLAS_INLINE
+		storage_extent extent(ExprT const&)
+	{
+		return storage_extent::empty();
+	}
+};
+
+
+template <typename ValueT, typename AllocT>
+struct storage_alias_traits< zero_vector<ValueT, AllocT> >: public no_storage_alias_traits
+{
+};
+
+
+template <typename ValueT, typename AllocT>
+struct storage_alias_traits< unit_vector<ValueT, AllocT> >: public no_storage_alias_traits
+{
+};
+
+
+template <typename ValueT, typename AllocT>
+struct storage_alias_traits< scalar_vector<ValueT, AllocT> >: public no_storage_alias_traits
+{
+};
+
+
+template <typename ValueT, typename AllocT>
+struct storage_alias_traits< zero_matrix<ValueT, AllocT> >: public no_storage_alias_traits
+{
+};
+
+
+template <typename ValueT, typename AllocT>
+struct storage_alias_traits< identity_matrix<ValueT, AllocT> >: public no_storage_alias_traits
+{
+};
+
+
+template <typename ValueT, typename AllocT>
+struct storage_alias_traits< scalar_matrix<ValueT, AllocT> >: public no_storage_alias_traits
+{
+};
+
+
+//@} Containers
+
+//@{ References and proxies (the whole referred container is considered)
+
+
+template <typename ExprT>
+struct storage_alias_traits< vector_reference<ExprT> >
+{
+	static BOOST_UBLAS_INLINE
+		storage_extent extent(vector_reference<ExprT> const& e)
+	{
+		return expression_extent(e.expression());
+	}
+};
+
+
+template <typename ExprT>
+struct storage_alias_traits< matrix_reference<ExprT> >
+{
+	static BOOST_UBLAS_INLINE
+		storage_extent extent(matrix_reference<ExprT> const& e)
+	{
+		return expression_extent(e.expression());
+	}
+};
+
+
+/// \brief Proxies exposing the proxied expression through \c data().
+struct proxy_storage_alias_traits
+{
+	template <typename ExprT>
+	static BOOST_UBLAS_INLINE
+		storage_extent extent(ExprT const& e)
+	{
+		return expression_extent(e.data());
+	}
+};
+
+
+template <typename VectorT>
+struct storage_alias_traits< vector_range<VectorT> >: public proxy_storage_alias_traits
+{
+};
+
+
+template <typename VectorT>
+struct storage_alias_traits< vector_slice<VectorT> >: public proxy_storage_alias_traits
+{
+};
+
+
+template <typename MatrixT>
+struct storage_alias_traits< matrix_row<MatrixT> >: public proxy_storage_alias_traits
+{
+};
+
+
+template <typename MatrixT>
+struct storage_alias_traits< matrix_column<MatrixT> >: public proxy_storage_alias_traits
+{
+};
+
+
+template <typename MatrixT>
+struct storage_alias_traits< matrix_range<MatrixT> >: public proxy_storage_alias_traits
+{
+};
+
+
+template <typename MatrixT>
+struct storage_alias_traits< matrix_slice<MatrixT> >: public proxy_storage_alias_traits
+{
+};
+
+
+//@} References and proxies
+
+//@{ Expression nodes
+//
+// Only nodes exposing their operands are visited; the others (like
+// vector_binary, whose accessors are private, and the scalar nodes) are
+// leaves with an unknown extent.
+
+
+/// \brief Nodes with a single operand returned by \c expression().
+struct unary_expression_alias_traits
+{
+	template <typename ExprT>
+	static BOOST_UBLAS_INLINE
+		bool may_alias(ExprT const& e, storage_extent const& x)
+	{
+		return expression_may_alias(e.expression(), x);
+	}
+};
+
+
+/// \brief Nodes with two operands returned by \c expression1() and \c expression2().
+struct binary_expression_alias_traits
+{
+	template <typename ExprT>
+	static BOOST_UBLAS_INLINE
+		bool may_alias(ExprT const& e, storage_extent const& x)
+	{
+		return expression_may_alias(e.expression1(), x)
+			   || expression_may_alias(e.expression2(), x);
+	}
+};
+
+
+template <typename ExprT, typename FunctorT>
+struct expression_alias_traits< vector_unary<ExprT, FunctorT> >: public unary_expression_alias_traits
+{
+};
+
+
+template <typename Expr1T, typename Expr2T, typename FunctorT>
+struct expression_alias_traits< vector_matrix_binary<Expr1T, Expr2T, FunctorT> >: public binary_expression_alias_traits
+{
+};
+
+
+template <typename ExprT, typename FunctorT>
+struct expression_alias_traits< matrix_unary1<ExprT, FunctorT> >: public unary_expression_alias_traits
+{
+};
+
+
+template <typename ExprT, typename FunctorT>
+struct expression_alias_traits< matrix_unary2<ExprT, FunctorT> >: public unary_expression_alias_traits
+{
+};
+
+
+template <typename Expr1T, typename Expr2T, typename FunctorT>
+struct expression_alias_traits< matrix_binary<Expr1T, Expr2T, FunctorT> >: public binary_expression_alias_traits
+{
+};
+
+
+template <typename Expr1T, typename Expr2T, typename FunctorT>
+struct expression_alias_traits< matrix_vector_binary1<Expr1T, Expr2T, FunctorT> >: public binary_expression_alias_traits
+{
+};
+
+
+template <typename Expr1T, typename Expr2T, typename FunctorT>
+struct expression_alias_traits< matrix_vector_binary2<Expr1T, Expr2T, FunctorT> >: public binary_expression_alias_traits
+{
+};
+
+
+template <typename Expr1T, typename Expr2T, typename FunctorT>
+struct expression_alias_traits< matrix_matrix_binary<Expr1T, Expr2T, FunctorT> >: public binary_expression_alias_traits
+{
+};
+
+
+//@} Expression nodes
+
+} // Namespace detail
+
+}}} // Namespace boost::numeric::ublas
+
+
+#endif // BOOST_NUMERIC_UBLAS_DETAIL_EXPRESSION_ALIAS_HPP
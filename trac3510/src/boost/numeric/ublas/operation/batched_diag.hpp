@@ -0,0 +1,228 @@
+/**
+ * \file batched_diag.hpp
+ *
+ * \brief Diagonal extraction and update over a batch of equally-sized dense
+ *  matrices.
+ *
+ * A batch is a contiguous array storing \f$n\f$ dense matrices of the same
+ * size and layout one after the other (e.g., the diagonal blocks of a
+ * block-Jacobi preconditioner).
+ * The \a k-th diagonals of all the matrices are gathered into a single vector
+ * of size \f$n m\f$, where \f$m\f$ is the length of each diagonal, so that the
+ * diagonal of the \f$b\f$-th matrix occupies the elements \f$[bm,(b+1)m)\f$.
+ * After a vectorized operation on this vector, the result can be scattered
+ * back into the batch.
+ *
+ * No proxy object is created per matrix.
+ * When compiled with OpenMP, matrices of the batch are processed in parallel.
+ *
+ * Copyright (c) 2009, Marco Guazzone
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * \author Marco Guazzone, marco.guazzone@gmail.com
+ */
+
+#ifndef BOOST_NUMERIC_UBLAS_OPERATION_BATCHED_DIAG_HPP
+#define BOOST_NUMERIC_UBLAS_OPERATION_BATCHED_DIAG_HPP
+
+
+#include <algorithm>
+#include <boost/mpl/bool.hpp>
+#include <boost/numeric/ublas/detail/config.hpp>
+#include <boost/numeric/ublas/exception.hpp>
+#include <boost/numeric/ublas/expression_types.hpp>
+#include <boost/numeric/ublas/functional.hpp>
+#include <boost/numeric/ublas/fwd.hpp>
+#include <cstddef>
+
+
+namespace boost { namespace numeric { namespace ublas {
+
+/**
+ * \brief Length of the \a k-th diagonal of a \a size1 by \a size2 matrix.
+ * \param size1 The number of rows.
+ * \param size2 The number of columns.
+ * \param k The offset from the main diagonal.
+ * \return The number of elements of the \a k-th diagonal.
+ */
+BOOST_UBLAS_INLINE
+::std::size_t batched_diag_size(::std::size_t size1, ::std::size_t size2, ::std::ptrdiff_t k)
+{
+	::std::size_t r(k < 0 ? -k : 0);
+	::std::size_t c(k > 0 ?  k : 0);
+
+	if (r >= size1 || c >= size2)
+	{
+		return 0;
+	}
+
+	return (::std::min)(size1 - r, size2 - c);
+}
+
+
+namespace detail {
+
+/// \brief Apply \a F to a diagonal element of the batch.
+template <template <class T1, class T2> class F, typename ValueT, typename VectorValueT>
+BOOST_UBLAS_INLINE
+void batched_diag_apply_element(ValueT& x, VectorValueT const& y, boost::mpl::true_)
+{
+	F<ValueT&, VectorValueT>::apply(x, y);
+}
+
+
+/// \brief Apply \a F to an element of the strided-batch vector.
+template <template <class T1, class T2> class F, typename ValueT, typename VectorValueT>
+BOOST_UBLAS_INLINE
+void batched_diag_apply_element(ValueT const& x, VectorValueT& y, boost::mpl::false_)
+{
+	F<VectorValueT&, ValueT>::apply(y, x);
+}
+
+
+/**
+ * \brief Apply \a F element-wise between the \a k-th diagonals of a batch and
+ *  a strided-batch vector.
+ *
+ * The target of \a F is the batch when \a ToBatch is \c true, and the vector
+ * otherwise.
+ */
+template <template <class T1, class T2> class F, bool ToBatch, typename LayoutT, typename ValueT, typename VectorT>
+BOOST_UBLAS_INLINE
+void batched_diag_apply(ValueT* blocks, ::std::size_t nblocks, ::std::size_t size1, ::std::size_t size2, ::std::ptrdiff_t k, VectorT& v)
+{
+	typedef ::std::ptrdiff_t difference_type;
+	typedef ::std::size_t size_type;
+
+	const size_type m(batched_diag_size(size1, size2, k));
+
+	BOOST_UBLAS_CHECK(v.size() == nblocks*m, bad_size());
+
+	if (m == 0)
+	{
+		return;
+	}
+
+	const size_type r(k < 0 ? -k : 0);
+	const size_type c(k > 0 ?  k : 0);
+	const difference_type block_size(size1*size2);
+	const difference_type first(LayoutT::address(r, size1, c, size2));
+	const difference_type stride(LayoutT::address(1, size1, 1, size2));
+	const difference_type n(nblocks);
+	const difference_type dm(m);
+
+#ifdef _OPENMP
+#	pragma omp parallel for schedule(static)
+#endif // _OPENMP
+	for (difference_type b = 0; b < n; ++b)
+	{
+		ValueT* p(blocks + b*block_size + first);
+		const difference_type j0(b*dm);
+
+		for (difference_type i = 0; i < dm; ++i, p += stride)
+		{
+			batched_diag_apply_element<F>(*p, v(j0+i), boost::mpl::bool_<ToBatch>());
+		}
+	}
+}
+
+} // Namespace detail
+
+
+/**
+ * \brief Gather the \a k-th diagonals of a batch of dense matrices.
+ * \tparam LayoutT The layout type of the matrices (e.g., row_major).
+ * \tparam ValueT The type of matrix elements.
+ * \tparam VectorT A model of VectorExpression.
+ * \param blocks Pointer to the first element of the first matrix.
+ * \param nblocks The number of matrices in the batch.
+ * \param size1 The number of rows of each matrix.
+ * \param size2 The number of columns of each matrix.
+ * \param k The offset from the main diagonal:
+ *  - \a k = 0 represents the main diagonal,
+ *  - \a k > 0 is the offset above the main diagonal,
+ *  - \a k < 0 is the offset below the main diagonal.
+ *  .
+ * \param d The output vector, of size
+ *  \c nblocks*batched_diag_size(size1,size2,k).
+ * \param l The matrix layout.
+ */
+template <typename LayoutT, typename ValueT, typename VectorT>
+BOOST_UBLAS_INLINE
+void batched_diag(ValueT const* blocks, ::std::size_t nblocks, ::std::size_t size1, ::std::size_t size2, ::std::ptrdiff_t k, vector_expression<VectorT>& d, LayoutT /*l*/)
+{
+	detail::batched_diag_apply<scalar_assign, false, LayoutT>(blocks, nblocks, size1, size2, k, d());
+}
+
+
+/**
+ * \brief Gather the \a k-th diagonals of a batch of row-major dense matrices.
+ * \see batched_diag(ValueT const*, std::size_t, std::size_t, std::size_t, std::ptrdiff_t, vector_expression<VectorT>&, LayoutT)
+ */
+template <typename ValueT, typename VectorT>
+BOOST_UBLAS_INLINE
+void batched_diag(ValueT const* blocks, ::std::size_t nblocks, ::std::size_t size1, ::std::size_t size2, ::std::ptrdiff_t k, vector_expression<VectorT>& d)
+{
+	batched_diag(blocks, nblocks, size1, size2, k, d, row_major());
+}
+
+
+/**
+ * \brief Scatter a strided-batch vector into the \a k-th diagonals of a batch
+ *  of dense matrices.
+ * \tparam F The assignment functor (e.g., scalar_assign, scalar_plus_assign).
+ * \tparam LayoutT The layout type of the matrices (e.g., row_major).
+ * \tparam ValueT The type of matrix elements.
+ * \tparam VectorT A model of VectorExpression.
+ * \param blocks Pointer to the first element of the first matrix.
+ * \param nblocks The number of matrices in the batch.
+ * \param size1 The number of rows of each matrix.
+ * \param size2 The number of columns of each matrix.
+ * \param k The offset from the main diagonal.
+ * \param d The input vector, of size
+ *  \c nblocks*batched_diag_size(size1,size2,k); element \f$bm+p\f$ is
+ *  assigned to the \f$p\f$-th diagonal element of the \f$b\f$-th matrix.
+ * \param l The matrix layout.
+ *
+ * The vector expression \a d is evaluated element by element, so it must not
+ * depend on the diagonals being updated.
+ */
+template <template <class T1, class T2> class F, typename LayoutT, typename ValueT, typename VectorT>
+BOOST_UBLAS_INLINE
+void batched_diag_assign(ValueT* blocks, ::std::size_t nblocks, ::std::size_t size1, ::std::size_t size2, ::std::ptrdiff_t k, vector_expression<VectorT> const& d, LayoutT /*l*/)
+{
+	detail::batched_diag_apply<F, true, LayoutT>(blocks, nblocks, size1, size2, k, d());
+}
+
+
+/**
+ * \brief Scatter a strided-batch vector into the \a k-th diagonals of a batch
+ *  of row-major dense matrices.
+ * \see batched_diag_assign(ValueT*, std::size_t, std::size_t, std::size_t, std::ptrdiff_t, vector_expression<VectorT> const&, LayoutT)
+ */
+template <template <class T1, class T2> class F, typename ValueT, typename VectorT>
+BOOST_UBLAS_INLINE
+void batched_diag_assign(ValueT* blocks, ::std::size_t nblocks, ::std::size_t size1, ::std::size_t size2, ::std::ptrdiff_t k, vector_expression<VectorT> const& d)
+{
+	batched_diag_assign<F>(blocks, nblocks, size1, size2, k, d, row_major());
+}
+
+
+/**
+ * \brief Scatter a strided-batch vector into the \a k-th diagonals of a batch
+ *  of row-major dense matrices, overwriting them.
+ */
+template <typename ValueT, typename VectorT>
+BOOST_UBLAS_INLINE
+void batched_diag_assign(ValueT* blocks, ::std::size_t nblocks, ::std::size_t size1, ::std::size_t size2, ::std::ptrdiff_t k, vector_expression<VectorT> const& d)
+{
+	batched_diag_assign<scalar_assign>(blocks, nblocks, size1, size2, k, d, row_major());
+}
+
+}}} // Namespace boost::numeric::ublas
+
+
+#endif // BOOST_NUMERIC_UBLAS_OPERATION_BATCHED_DIAG_HPP
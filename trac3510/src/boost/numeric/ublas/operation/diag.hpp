@@ -20,7 +20,9 @@
 
 #include <boost/numeric/ublas/container/generalized_diagonal_matrix.hpp>
 #include <boost/numeric/ublas/fwd.hpp>
+#include <boost/numeric/ublas/operation/diagonal_scaling.hpp>
 #include <boost/numeric/ublas/proxy/matrix_diagonal.hpp>
+#include <boost/numeric/ublas/storage/array_view.hpp>
 
 
 namespace boost { namespace numeric { namespace ublas {
@@ -247,6 +249,164 @@ typename vector_matrix_diag_traits<VectorT,row_major>::result_type diag(vector_e
 //[/FIXME]
 
 
+/**
+ * \brief A traits class for vector-to-diagonal-matrix views.
+ * \tparam VectorT A model of VectorExpression with contiguous storage.
+ * \tparam Layout A matrix layout type.
+ */
+template <typename VectorT, typename LayoutT>
+struct vector_matrix_diag_view_traits
+{
+	typedef typename VectorT::value_type value_type;
+	typedef typename VectorT::difference_type difference_type;
+	typedef typename VectorT::size_type size_type;
+	typedef LayoutT layout_type;
+	typedef array_view<value_type> array_type;
+	typedef generalized_diagonal_matrix<value_type, layout_type, array_type> result_type;
+};
+
+
+/**
+ * \brief Create a square matrix of order \f$n+abs(k)\f$, whose \a k-th
+ *  diagonal refers to the elements of \a v.
+ * \tparam VectorT A model of VectorExpression with contiguous storage.
+ * \tparam LayoutT The layout type of the resulting matrix (e.g., row_major).
+ * \param v A vector expression.
+ * \param k The offset from the main diagonal:
+ *  - \a k = 0 represents the main diagonal,
+ *  - \a k > 0 is the offset above the main diagonal,
+ *  - \a k < 0 is the offset below the main diagonal.
+ *  .
+ *  Default to zero.
+ * \param l The matrix layout.
+ * \return A square diagonal matrix whose \a k-th diagonal shares the storage
+ *  of \a v.
+ *
+ * Unlike \c diag, no element is copied: writes to the diagonal of the
+ * returned matrix update \a v, and \a v must outlive the returned matrix.
+ * Assigning a whole expression to the returned matrix, instead, replaces its
+ * storage and detaches it from \a v.
+ */
+template <typename VectorT, typename LayoutT>
+BOOST_UBLAS_INLINE
+typename vector_matrix_diag_view_traits<VectorT,LayoutT>::result_type diag_view(vector_expression<VectorT>& v, typename vector_matrix_diag_view_traits<VectorT,LayoutT>::difference_type k=0, LayoutT /*l*/=LayoutT())
+{
+	typedef vector_matrix_diag_view_traits<VectorT,LayoutT> traits;
+	typedef typename traits::size_type size_type;
+	typedef typename traits::array_type array_type;
+	typedef typename traits::result_type result_type;
+
+	size_type d(k > 0 ? k : -k);
+
+	return result_type(
+			v().size() + d,
+			k,
+			array_type(v().size(), v().data().begin())
+	);
+}
+
+
+/**
+ * \brief Create a square matrix of order \f$n+abs(k)\f$, whose \a k-th
+ *  diagonal refers to the elements of \a v.
+ * \tparam VectorT A model of VectorExpression with contiguous storage.
+ * \param v A vector expression.
+ * \param k The offset from the main diagonal:
+ *  - \a k = 0 represents the main diagonal,
+ *  - \a k > 0 is the offset above the main diagonal,
+ *  - \a k < 0 is the offset below the main diagonal.
+ *  .
+ *  Default to zero.
+ * \return A square diagonal matrix whose \a k-th diagonal shares the storage
+ *  of \a v and with a row-major layout.
+ */
+template <typename VectorT>
+BOOST_UBLAS_INLINE
+typename vector_matrix_diag_view_traits<VectorT,row_major>::result_type diag_view(vector_expression<VectorT>& v, typename vector_matrix_diag_view_traits<VectorT,row_major>::difference_type k=0)
+{
+	typedef vector_matrix_diag_view_traits<VectorT,row_major> traits;
+	typedef typename traits::size_type size_type;
+	typedef typename traits::array_type array_type;
+	typedef typename traits::result_type result_type;
+
+	size_type d(k > 0 ? k : -k);
+
+	return result_type(
+			v().size() + d,
+			k,
+			array_type(v().size(), v().data().begin())
+	);
+}
+
+
+/**
+ * \brief Create a rectangular matrix whose \a k-th diagonal refers to the
+ *  elements of \a v.
+ * \tparam VectorT A model of VectorExpression with contiguous storage.
+ * \tparam LayoutT The layout type of the resulting matrix (e.g., row_major).
+ * \param v A vector expression. If too long only its leading part is viewed.
+ * \param size1 The number of rows of the resulting matrix.
+ * \param size2 The number of columns of the resulting matrix.
+ * \param k The offset from the main diagonal:
+ *  - \a k = 0 represents the main diagonal,
+ *  - \a k > 0 is the offset above the main diagonal,
+ *  - \a k < 0 is the offset below the main diagonal.
+ *  .
+ *  Default to zero.
+ * \param l The matrix layout.
+ * \return A rectangular diagonal matrix whose \a k-th diagonal shares the
+ *  storage of \a v.
+ */
+template <typename VectorT, typename LayoutT>
+BOOST_UBLAS_INLINE
+typename vector_matrix_diag_view_traits<VectorT,LayoutT>::result_type diag_view(vector_expression<VectorT>& v, typename vector_matrix_diag_view_traits<VectorT,LayoutT>::size_type size1, typename vector_matrix_diag_view_traits<VectorT,LayoutT>::size_type size2, typename vector_matrix_diag_view_traits<VectorT,LayoutT>::difference_type k=0, LayoutT /*l*/=LayoutT())
+{
+	typedef vector_matrix_diag_view_traits<VectorT,LayoutT> traits;
+	typedef typename traits::array_type array_type;
+	typedef typename traits::result_type result_type;
+
+	return result_type(
+			size1,
+			size2,
+			k,
+			array_type(v().size(), v().data().begin())
+	);
+}
+
+
+/**
+ * \brief Create a rectangular matrix whose \a k-th diagonal refers to the
+ *  elements of \a v.
+ * \tparam VectorT A model of VectorExpression with contiguous storage.
+ * \param v A vector expression. If too long only its leading part is viewed.
+ * \param size1 The number of rows of the resulting matrix.
+ * \param size2 The number of columns of the resulting matrix.
+ * \param k The offset from the main diagonal:
+ *  - \a k = 0 represents the main diagonal,
+ *  - \a k > 0 is the offset above the main diagonal,
+ *  - \a k < 0 is the offset below the main diagonal.
+ *  .
+ *  Default to zero.
+ * \return A rectangular diagonal matrix whose \a k-th diagonal shares the
+ *  storage of \a v and with a row-major layout.
+ */
+template <typename VectorT>
+BOOST_UBLAS_INLINE
+typename vector_matrix_diag_view_traits<VectorT,row_major>::result_type diag_view(vector_expression<VectorT>& v, typename vector_matrix_diag_view_traits<VectorT,row_major>::size_type size1, typename vector_matrix_diag_view_traits<VectorT,row_major>::size_type size2, typename vector_matrix_diag_view_traits<VectorT,row_major>::difference_type k=0)
+{
+	typedef vector_matrix_diag_view_traits<VectorT,row_major> traits;
+	typedef typename traits::array_type array_type;
+	typedef typename traits::result_type result_type;
+
+	return result_type(
+			size1,
+			size2,
+			k,
+			array_type(v().size(), v().data().begin())
+	);
+}
+
+
 /**
  * \brief Create a view of the \a k-th diagonal of a matrix.
  * \tparam MatrixT A model of MatrixExpression.
@@ -283,7 +443,7 @@ template<typename MatrixT>
 BOOST_UBLAS_INLINE
 matrix_diagonal<MatrixT const> const diag(matrix_expression<MatrixT> const& me, typename MatrixT::difference_type k=0)
 {
-	return matrix_diagonal<MatrixT const>(me, k);
+	return matrix_diagonal<MatrixT const>(me(), k);
 }
 
 }}} // Namespace boost::numeric::ublas
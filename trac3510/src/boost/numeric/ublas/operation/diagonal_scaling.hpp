@@ -0,0 +1,479 @@
+/**
+ * \file diagonal_scaling.hpp
+ *
+ * \brief Fused products between generalized diagonal matrices and matrix
+ *  expressions.
+ *
+ * Products like \f$D_1 A\f$, \f$A D_2\f$ and \f$D_1 A D_2\f$, where \f$D_1\f$
+ * and \f$D_2\f$ are generalized diagonal matrices, are represented by a single
+ * \c matrix_diagonal_scaling expression.
+ * When assigned, each element of \f$A\f$ is read once and multiplied by the
+ * matching diagonal entries, without materializing any intermediate product.
+ *
+ * Copyright (c) 2009, Marco Guazzone
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * \author Marco Guazzone, marco.guazzone@gmail.com
+ */
+
+#ifndef BOOST_NUMERIC_UBLAS_OPERATION_DIAGONAL_SCALING_HPP
+#define BOOST_NUMERIC_UBLAS_OPERATION_DIAGONAL_SCALING_HPP
+
+#include <boost/numeric/ublas/container/generalized_diagonal_matrix.hpp>
+#include <boost/numeric/ublas/detail/config.hpp>
+#include <boost/numeric/ublas/detail/iterator.hpp>
+#include <boost/numeric/ublas/exception.hpp>
+#include <boost/numeric/ublas/expression_types.hpp>
+#include <boost/numeric/ublas/fwd.hpp>
+#include <boost/numeric/ublas/matrix_expression.hpp>
+#include <boost/numeric/ublas/traits.hpp>
+
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+/**
+ * \brief A generalized diagonal factor of a fused diagonal scaling.
+ * \tparam DiagT The generalized diagonal matrix type, or \c void for the
+ *  identity.
+ * \tparam ValueT The value type of the scaled operand.
+ *
+ * The factor maps an index of the product to the index of the scaled operand
+ * and accumulates the corresponding diagonal entry in a scale factor.
+ * If \f$D\f$ has offset \f$k\f$, its \f$p\f$-th diagonal entry is at
+ * \f$(p+r,p+c)\f$, with \f$r=\max\{-k,0\}\f$ and \f$c=\max\{k,0\}\f$, so that
+ * \f$(DA)_{ij}=d_{i-r}a_{i-r+c,j}\f$ and \f$(AD)_{ij}=a_{i,j-c+r}d_{j-c}\f$.
+ */
+template <typename DiagT, typename ValueT>
+class diagonal_factor
+{
+	public: typedef DiagT diagonal_type;
+	public: typedef typename DiagT::size_type size_type;
+	public: typedef typename DiagT::difference_type difference_type;
+	public: typedef typename promote_traits<ValueT, typename DiagT::value_type>::promote_type value_type;
+
+
+	public: BOOST_UBLAS_INLINE
+		explicit diagonal_factor(diagonal_type const& d)
+		: d_(&d),
+		  r_(d.offset() < 0 ? -d.offset() : 0),
+		  c_(d.offset() > 0 ?  d.offset() : 0)
+	{
+		// Empty
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		diagonal_type const& diagonal() const
+	{
+		return *d_;
+	}
+
+
+	/// Number of rows of \f$DA\f$.
+	public: template <typename SizeT>
+		BOOST_UBLAS_INLINE
+		size_type size1(SizeT /*operand_size1*/) const
+	{
+		return d_->size1();
+	}
+
+
+	/// Number of columns of \f$AD\f$.
+	public: template <typename SizeT>
+		BOOST_UBLAS_INLINE
+		size_type size2(SizeT /*operand_size2*/) const
+	{
+		return d_->size2();
+	}
+
+
+	/// Map row \a i of \f$DA\f$ to the row of \f$A\f$; \c false if the row is zero.
+	public: template <typename SizeT, typename ScaleT>
+		BOOST_UBLAS_INLINE
+		bool left(SizeT i, SizeT& ei, ScaleT& s) const
+	{
+		if (i < r_ || (i - r_) >= d_->data().size())
+		{
+			return false;
+		}
+		ei = i - r_ + c_;
+		s *= d_->data()[i - r_];
+		return true;
+	}
+
+
+	/// Map column \a j of \f$AD\f$ to the column of \f$A\f$; \c false if the column is zero.
+	public: template <typename SizeT, typename ScaleT>
+		BOOST_UBLAS_INLINE
+		bool right(SizeT j, SizeT& ej, ScaleT& s) const
+	{
+		if (j < c_ || (j - c_) >= d_->data().size())
+		{
+			return false;
+		}
+		ej = j - c_ + r_;
+		s *= d_->data()[j - c_];
+		return true;
+	}
+
+
+	private: diagonal_type const* d_;
+	private: size_type r_;
+	private: size_type c_;
+};
+
+
+/// \brief Specialization of \c diagonal_factor for the identity factor.
+template <typename ValueT>
+class diagonal_factor<void, ValueT>
+{
+	public: typedef void diagonal_type;
+	public: typedef ValueT value_type;
+
+
+	public: template <typename SizeT>
+		BOOST_UBLAS_INLINE
+		SizeT size1(SizeT operand_size1) const
+	{
+		return operand_size1;
+	}
+
+
+	public: template <typename SizeT>
+		BOOST_UBLAS_INLINE
+		SizeT size2(SizeT operand_size2) const
+	{
+		return operand_size2;
+	}
+
+
+	public: template <typename SizeT, typename ScaleT>
+		BOOST_UBLAS_INLINE
+		bool left(SizeT i, SizeT& ei, ScaleT& /*s*/) const
+	{
+		ei = i;
+		return true;
+	}
+
+
+	public: template <typename SizeT, typename ScaleT>
+		BOOST_UBLAS_INLINE
+		bool right(SizeT j, SizeT& ej, ScaleT& /*s*/) const
+	{
+		ej = j;
+		return true;
+	}
+};
+
+} // Namespace detail
+
+
+/**
+ * \brief Fused product \f$D_1 A D_2\f$ of a matrix expression by generalized
+ *  diagonal matrices.
+ * \tparam MatrixT A model of MatrixExpression.
+ * \tparam LeftDiagT The type of the left generalized diagonal matrix, or
+ *  \c void if there is no left factor.
+ * \tparam RightDiagT The type of the right generalized diagonal matrix, or
+ *  \c void if there is no right factor.
+ *
+ * Element \f$(i,j)\f$ is computed as \f$d_1 a d_2\f$, where \f$a\f$ is the
+ * (shifted) element of \f$A\f$ selected by the diagonal offsets.
+ * Instances are created by the \c prod overloads below and hold references to
+ * their operands, like any other uBLAS expression.
+ *
+ * \author Marco Guazzone, marco.guazzone@gmail.com
+ */
+template <typename MatrixT, typename LeftDiagT, typename RightDiagT>
+class matrix_diagonal_scaling: public matrix_expression< matrix_diagonal_scaling<MatrixT, LeftDiagT, RightDiagT> >
+{
+	private: typedef matrix_diagonal_scaling<MatrixT, LeftDiagT, RightDiagT> self_type;
+#ifdef BOOST_UBLAS_ENABLE_PROXY_SHORTCUTS
+	public: using matrix_expression<self_type>::operator();
+#endif // BOOST_UBLAS_ENABLE_PROXY_SHORTCUTS
+	public: typedef MatrixT expression_type;
+	public: typedef typename MatrixT::const_closure_type expression_closure_type;
+	public: typedef detail::diagonal_factor<LeftDiagT, typename MatrixT::value_type> left_factor_type;
+	public: typedef detail::diagonal_factor<RightDiagT, typename left_factor_type::value_type> right_factor_type;
+	public: typedef typename MatrixT::size_type size_type;
+	public: typedef typename MatrixT::difference_type difference_type;
+	public: typedef typename right_factor_type::value_type value_type;
+	public: typedef value_type const_reference;
+	public: typedef const_reference reference;
+	public: typedef const self_type const_closure_type;
+	public: typedef const_closure_type closure_type;
+	public: typedef typename MatrixT::orientation_category orientation_category;
+	public: typedef unknown_storage_tag storage_category;
+	// Iterator types
+	public: typedef indexed_const_iterator1<self_type, dense_random_access_iterator_tag> const_iterator1;
+	public: typedef const_iterator1 iterator1;
+	public: typedef indexed_const_iterator2<self_type, dense_random_access_iterator_tag> const_iterator2;
+	public: typedef const_iterator2 iterator2;
+	public: typedef reverse_iterator_base1<const_iterator1> const_reverse_iterator1;
+	public: typedef reverse_iterator_base2<const_iterator2> const_reverse_iterator2;
+
+
+	//@{ Construction and destruction
+
+	public: BOOST_UBLAS_INLINE
+		matrix_diagonal_scaling(expression_closure_type const& e, left_factor_type const& left, right_factor_type const& right)
+		: e_(e),
+		  left_(left),
+		  right_(right)
+	{
+		// Empty
+	}
+
+	//@} Construction and destruction
+
+	//@{ Accessors
+
+	public: BOOST_UBLAS_INLINE
+		size_type size1() const
+	{
+		return left_.size1(e_.size1());
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		size_type size2() const
+	{
+		return right_.size2(e_.size2());
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		expression_closure_type const& expression() const
+	{
+		return e_;
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		left_factor_type const& left_factor() const
+	{
+		return left_;
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		right_factor_type const& right_factor() const
+	{
+		return right_;
+	}
+
+	//@} Accessors
+
+	//@{ Element access
+
+	public: BOOST_UBLAS_INLINE
+		const_reference operator()(size_type i, size_type j) const
+	{
+		size_type ei;
+		size_type ej;
+		value_type s(1);
+
+		if (left_.left(i, ei, s) && right_.right(j, ej, s))
+		{
+			return s * e_(ei, ej);
+		}
+
+		return value_type/*zero*/();
+	}
+
+	//@} Element access
+
+	//@{ Closure comparison
+
+	public: BOOST_UBLAS_INLINE
+		bool same_closure(matrix_diagonal_scaling const& mds) const
+	{
+		return e_.same_closure(mds.e_);
+	}
+
+	//@} Closure comparison
+
+	//@{ Iterators
+
+	public: BOOST_UBLAS_INLINE
+		const_iterator1 find1(int /*rank*/, size_type i, size_type j) const
+	{
+		return const_iterator1(*this, i, j);
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		const_iterator2 find2(int /*rank*/, size_type i, size_type j) const
+	{
+		return const_iterator2(*this, i, j);
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		const_iterator1 begin1() const
+	{
+		return find1(0, 0, 0);
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		const_iterator1 end1() const
+	{
+		return find1(0, size1(), 0);
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		const_iterator2 begin2() const
+	{
+		return find2(0, 0, 0);
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		const_iterator2 end2() const
+	{
+		return find2(0, 0, size2());
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		const_reverse_iterator1 rbegin1() const
+	{
+		return const_reverse_iterator1(end1());
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		const_reverse_iterator1 rend1() const
+	{
+		return const_reverse_iterator1(begin1());
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		const_reverse_iterator2 rbegin2() const
+	{
+		return const_reverse_iterator2(end2());
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		const_reverse_iterator2 rend2() const
+	{
+		return const_reverse_iterator2(begin2());
+	}
+
+	//@} Iterators
+
+	//@{ Data members
+
+	private: expression_closure_type e_; ///< The scaled expression.
+	private: left_factor_type left_; ///< The left diagonal factor.
+	private: right_factor_type right_; ///< The right diagonal factor.
+
+	//@} Data members
+};
+
+
+/**
+ * \brief Product \f$DA\f$ of a generalized diagonal matrix by a matrix
+ *  expression.
+ * \return A fused expression which scales (and shifts) the rows of \a me.
+ */
+template <typename ValueT, typename LayoutT, typename ArrayT, typename MatrixT>
+BOOST_UBLAS_INLINE
+matrix_diagonal_scaling<MatrixT, generalized_diagonal_matrix<ValueT,LayoutT,ArrayT>, void> prod(generalized_diagonal_matrix<ValueT,LayoutT,ArrayT> const& D, matrix_expression<MatrixT> const& me)
+{
+	typedef matrix_diagonal_scaling<MatrixT, generalized_diagonal_matrix<ValueT,LayoutT,ArrayT>, void> result_type;
+	typedef typename result_type::expression_closure_type expression_closure_type;
+	typedef typename result_type::left_factor_type left_factor_type;
+	typedef typename result_type::right_factor_type right_factor_type;
+
+	BOOST_UBLAS_CHECK(D.size2() == me().size1(), bad_size());
+
+	return result_type(expression_closure_type(me()), left_factor_type(D), right_factor_type());
+}
+
+
+/**
+ * \brief Product \f$AD\f$ of a matrix expression by a generalized diagonal
+ *  matrix.
+ * \return A fused expression which scales (and shifts) the columns of \a me.
+ */
+template <typename MatrixT, typename ValueT, typename LayoutT, typename ArrayT>
+BOOST_UBLAS_INLINE
+matrix_diagonal_scaling<MatrixT, void, generalized_diagonal_matrix<ValueT,LayoutT,ArrayT> > prod(matrix_expression<MatrixT> const& me, generalized_diagonal_matrix<ValueT,LayoutT,ArrayT> const& D)
+{
+	typedef matrix_diagonal_scaling<MatrixT, void, generalized_diagonal_matrix<ValueT,LayoutT,ArrayT> > result_type;
+	typedef typename result_type::expression_closure_type expression_closure_type;
+	typedef typename result_type::left_factor_type left_factor_type;
+	typedef typename result_type::right_factor_type right_factor_type;
+
+	BOOST_UBLAS_CHECK(me().size2() == D.size1(), bad_size());
+
+	return result_type(expression_closure_type(me()), left_factor_type(), right_factor_type(D));
+}
+
+
+/**
+ * \brief Product \f$D_1 (A D_2)\f$ fused into a single two-sided scaling of
+ *  \f$A\f$.
+ */
+template <typename ValueT, typename LayoutT, typename ArrayT, typename MatrixT, typename RightDiagT>
+BOOST_UBLAS_INLINE
+matrix_diagonal_scaling<MatrixT, generalized_diagonal_matrix<ValueT,LayoutT,ArrayT>, RightDiagT> prod(generalized_diagonal_matrix<ValueT,LayoutT,ArrayT> const& D, matrix_diagonal_scaling<MatrixT, void, RightDiagT> const& mds)
+{
+	typedef matrix_diagonal_scaling<MatrixT, generalized_diagonal_matrix<ValueT,LayoutT,ArrayT>, RightDiagT> result_type;
+	typedef typename result_type::left_factor_type left_factor_type;
+	typedef typename result_type::right_factor_type right_factor_type;
+
+	BOOST_UBLAS_CHECK(D.size2() == mds.size1(), bad_size());
+
+	return result_type(mds.expression(), left_factor_type(D), right_factor_type(mds.right_factor().diagonal()));
+}
+
+
+/**
+ * \brief Product \f$(D_1 A) D_2\f$ fused into a single two-sided scaling of
+ *  \f$A\f$.
+ */
+template <typename MatrixT, typename LeftDiagT, typename ValueT, typename LayoutT, typename ArrayT>
+BOOST_UBLAS_INLINE
+matrix_diagonal_scaling<MatrixT, LeftDiagT, generalized_diagonal_matrix<ValueT,LayoutT,ArrayT> > prod(matrix_diagonal_scaling<MatrixT, LeftDiagT, void> const& mds, generalized_diagonal_matrix<ValueT,LayoutT,ArrayT> const& D)
+{
+	typedef matrix_diagonal_scaling<MatrixT, LeftDiagT, generalized_diagonal_matrix<ValueT,LayoutT,ArrayT> > result_type;
+	typedef typename result_type::left_factor_type left_factor_type;
+	typedef typename result_type::right_factor_type right_factor_type;
+
+	BOOST_UBLAS_CHECK(mds.size2() == D.size1(), bad_size());
+
+	return result_type(mds.expression(), left_factor_type(mds.left_factor().diagonal()), right_factor_type(D));
+}
+
+
+/**
+ * \brief Product of two generalized diagonal matrices.
+ *
+ * Both operands are diagonal, so neither is a scaling of a general matrix:
+ * the usual matrix-matrix product expression is returned.
+ */
+template <typename ValueT1, typename LayoutT1, typename ArrayT1, typename ValueT2, typename LayoutT2, typename ArrayT2>
+BOOST_UBLAS_INLINE
+typename matrix_matrix_binary_traits<ValueT1, generalized_diagonal_matrix<ValueT1,LayoutT1,ArrayT1>, ValueT2, generalized_diagonal_matrix<ValueT2,LayoutT2,ArrayT2> >::result_type prod(generalized_diagonal_matrix<ValueT1,LayoutT1,ArrayT1> const& D1, generalized_diagonal_matrix<ValueT2,LayoutT2,ArrayT2> const& D2)
+{
+	typedef matrix_expression< generalized_diagonal_matrix<ValueT1,LayoutT1,ArrayT1> > expression1_type;
+	typedef matrix_expression< generalized_diagonal_matrix<ValueT2,LayoutT2,ArrayT2> > expression2_type;
+
+	return prod(static_cast<expression1_type const&>(D1), static_cast<expression2_type const&>(D2));
+}
+
+}}} // Namespace boost::numeric::ublas
+
+
+#endif // BOOST_NUMERIC_UBLAS_OPERATION_DIAGONAL_SCALING_HPP
@@ -16,19 +16,102 @@
 #define BOOST_NUMERIC_UBLAS_PROXY_MATRIX_DIAGONAL_HPP
 
 #include <algorithm>
+#include <boost/mpl/bool.hpp>
 #include <boost/mpl/if.hpp>
 #include <boost/numeric/ublas/detail/config.hpp>
+#include <boost/numeric/ublas/detail/expression_alias.hpp>
 #include <boost/numeric/ublas/detail/temporary.hpp>
 #include <boost/numeric/ublas/detail/vector_assign.hpp>
 #include <boost/numeric/ublas/expression_types.hpp>
 #include <boost/numeric/ublas/exception.hpp>
 #include <boost/numeric/ublas/fwd.hpp>
+#include <boost/numeric/ublas/storage.hpp>
 #include <boost/static_assert.hpp>
 #include <boost/type_traits/is_const.hpp>
+#include <cstddef>
 
 
 namespace boost { namespace numeric { namespace ublas {
 
+namespace detail {
+
+/**
+ * \brief Tell if the diagonals of a matrix type are equally spaced in memory.
+ * \tparam MatrixT A model of MatrixExpression.
+ *
+ * When \c value is \c true, the class also provides the \c pointer,
+ * \c const_pointer and \c layout_type types and the static functions
+ * \c begin and \c stride, which respectively return the address of the first
+ * stored element and the distance between two consecutive elements of a
+ * diagonal.
+ */
+template <typename MatrixT>
+struct matrix_diagonal_stride_traits
+{
+	static const bool value = false;
+};
+
+
+/// \brief Stride traits for dense matrices with contiguous storage.
+template <typename MatrixT, typename LayoutT>
+struct dense_matrix_diagonal_stride_traits
+{
+	static const bool value = true;
+	typedef typename MatrixT::value_type* pointer;
+	typedef typename MatrixT::value_type const* const_pointer;
+	typedef typename MatrixT::difference_type difference_type;
+	typedef LayoutT layout_type;
+
+
+	static BOOST_UBLAS_INLINE
+		pointer begin(MatrixT& m)
+	{
+		return m.data().begin();
+	}
+
+
+	static BOOST_UBLAS_INLINE
+		const_pointer begin(MatrixT const& m)
+	{
+		return m.data().begin();
+	}
+
+
+	static BOOST_UBLAS_INLINE
+		difference_type stride(MatrixT const& m)
+	{
+		return layout_type::address(1, m.size1(), 1, m.size2());
+	}
+};
+
+
+template <typename ValueT, typename LayoutT, typename AllocT>
+struct matrix_diagonal_stride_traits< matrix<ValueT, LayoutT, unbounded_array<ValueT,AllocT> > >: public dense_matrix_diagonal_stride_traits<matrix<ValueT, LayoutT, unbounded_array<ValueT,AllocT> >, LayoutT>
+{
+};
+
+
+template <typename ValueT, typename LayoutT, typename AllocT>
+struct matrix_diagonal_stride_traits< matrix<ValueT, LayoutT, unbounded_array<ValueT,AllocT> > const>: public dense_matrix_diagonal_stride_traits<matrix<ValueT, LayoutT, unbounded_array<ValueT,AllocT> >, LayoutT>
+{
+	typedef ValueT const* pointer;
+};
+
+
+template <typename ValueT, typename LayoutT, std::size_t N, typename AllocT>
+struct matrix_diagonal_stride_traits< matrix<ValueT, LayoutT, bounded_array<ValueT,N,AllocT> > >: public dense_matrix_diagonal_stride_traits<matrix<ValueT, LayoutT, bounded_array<ValueT,N,AllocT> >, LayoutT>
+{
+};
+
+
+template <typename ValueT, typename LayoutT, std::size_t N, typename AllocT>
+struct matrix_diagonal_stride_traits< matrix<ValueT, LayoutT, bounded_array<ValueT,N,AllocT> > const>: public dense_matrix_diagonal_stride_traits<matrix<ValueT, LayoutT, bounded_array<ValueT,N,AllocT> >, LayoutT>
+{
+	typedef ValueT const* pointer;
+};
+
+} // Namespace detail
+
 /**
  * \brief Matrix based diagonal vector class
  * \tparam MatrixT A model of MatrixExpression.
@@ -43,13 +126,24 @@ namespace boost { namespace numeric { namespace ublas {
  * - \c k < 0, the \c k-th diagonal under the main diagonal is extracted;
  * .
  *
+ * If the elements of a diagonal of \a MatrixT are equally spaced in memory
+ * (see \c detail::matrix_diagonal_stride_traits), the iterators of this class
+ * keep a pointer to the first element, the stride and the index, so that loops
+ * over the diagonal of a dense matrix reduce to a single strided loop.
+ * The address of an element is computed only when it is dereferenced, so that
+ * no pointer past the end of the storage is ever formed.
+ * Otherwise, iterators advance a pair of row and column iterators of the
+ * underlying matrix.
+ *
  * \author Marco Guazzone, marco.guazzone@gmail.com
  */
 template <typename MatrixT>
 class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 {
-	public: class const_iterator;
-	public: class iterator;
+	public: class const_dual_iterator;
+	public: class dual_iterator;
+	public: class const_strided_iterator;
+	public: class strided_iterator;
 
 
 	private: typedef matrix_diagonal<MatrixT> self_type;
@@ -90,6 +184,18 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 									typename MatrixT::const_iterator2,
 									typename MatrixT::iterator2
 							>::type subiterator2_type;
+	private: typedef detail::matrix_diagonal_stride_traits<MatrixT> stride_traits;
+	private: typedef boost::mpl::bool_<stride_traits::value> is_strided_type;
+	public: typedef typename boost::mpl::if_c<
+									stride_traits::value,
+									const_strided_iterator,
+									const_dual_iterator
+							>::type const_iterator;
+	public: typedef typename boost::mpl::if_c<
+									stride_traits::value,
+									strided_iterator,
+									dual_iterator
+							>::type iterator;
 	// Reverse iterator
 	public: typedef reverse_iterator_base<const_iterator> const_reverse_iterator;
 	public: typedef reverse_iterator_base<iterator> reverse_iterator;
@@ -212,6 +318,11 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 		matrix_diagonal& operator=(matrix_diagonal const& mr)
 	{
 		// ISSUE need a temporary, proxy can be overlaping alias
+		if (!may_alias(mr))
+		{
+			vector_assign<scalar_assign>(*this, mr);
+			return *this;
+		}
 		vector_assign<scalar_assign>(
 			*this,
 			typename vector_temporary_traits<matrix_type>::type(mr)
@@ -233,6 +344,11 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 		BOOST_UBLAS_INLINE
 		matrix_diagonal& operator=(vector_expression<AE> const& ae)
 	{
+		if (!may_alias(ae()))
+		{
+			vector_assign<scalar_assign>(*this, ae);
+			return *this;
+		}
 		vector_assign<scalar_assign>(
 			*this,
 			typename vector_temporary_traits<matrix_type>::type(ae)
@@ -254,6 +370,11 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 		BOOST_UBLAS_INLINE
 		matrix_diagonal& operator+=(vector_expression<AE> const& ae)
 	{
+		if (!may_alias(ae()))
+		{
+			vector_assign<scalar_plus_assign>(*this, ae);
+			return *this;
+		}
 		vector_assign<scalar_assign>(
 			*this,
 			typename vector_temporary_traits<matrix_type>::type(*this + ae)
@@ -275,6 +396,11 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 		BOOST_UBLAS_INLINE
 		matrix_diagonal& operator-=(vector_expression<AE> const& ae)
 	{
+		if (!may_alias(ae()))
+		{
+			vector_assign<scalar_minus_assign>(*this, ae);
+			return *this;
+		}
 		vector_assign<scalar_assign>(
 			*this,
 			typename vector_temporary_traits<matrix_type>::type(*this - ae)
@@ -309,6 +435,22 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 		return *this;
 	}
 
+
+	/**
+	 * \brief Tell if the given expression may read the storage of the
+	 *  underlying matrix.
+	 *
+	 * The check is conservative: the whole storage of the underlying matrix
+	 * is considered, and it is unknown (thus overlapping with everything)
+	 * for matrix types not handled by \c detail::storage_alias_traits.
+	 */
+	private: template <typename ExprT>
+		BOOST_UBLAS_INLINE
+		bool may_alias(ExprT const& e) const
+	{
+		return detail::expression_may_alias(e, detail::expression_extent(data_));
+	}
+
 	//@} Assignment
 
 	//@{ Closure comparison
@@ -359,21 +501,73 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 	public: BOOST_UBLAS_INLINE
 		const_iterator find(size_type j) const
+	{
+		return find(j, is_strided_type());
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		iterator find(size_type j)
+	{
+		return find(j, is_strided_type());
+	}
+
+
+	private: BOOST_UBLAS_INLINE
+		const_dual_iterator find(size_type j, boost::mpl::false_) const
 	{
 		const_subiterator1_type it1(data_.find1(2, j+r_, c_));
 		const_subiterator2_type it2(data_.find2(1, r_, j+c_));
 
-		return const_iterator(*this, it1, it2);
+		return const_dual_iterator(*this, it1, it2);
 	}
 
 
-	public: BOOST_UBLAS_INLINE
-		iterator find(size_type j)
+	private: BOOST_UBLAS_INLINE
+		dual_iterator find(size_type j, boost::mpl::false_)
 	{
 		subiterator1_type it1(data_.find1(2, j+r_, c_));
 		subiterator2_type it2(data_.find2(1, r_, j+c_));
 
-		return iterator(*this, it1, it2);
+		return dual_iterator(*this, it1, it2);
+	}
+
+
+	private: BOOST_UBLAS_INLINE
+		const_strided_iterator find(size_type j, boost::mpl::true_) const
+	{
+		if (size() == 0)
+		{
+			return const_strided_iterator(*this, 0, 0, 0);
+		}
+
+		difference_type stride(stride_traits::stride(data_.expression()));
+
+		return const_strided_iterator(
+				*this,
+				stride_traits::begin(data_.expression()) + stride_traits::layout_type::address(r_, data_.size1(), c_, data_.size2()),
+				stride,
+				j
+			);
+	}
+
+
+	private: BOOST_UBLAS_INLINE
+		strided_iterator find(size_type j, boost::mpl::true_)
+	{
+		if (size() == 0)
+		{
+			return strided_iterator(*this, 0, 0, 0);
+		}
+
+		difference_type stride(stride_traits::stride(data_.expression()));
+
+		return strided_iterator(
+				*this,
+				stride_traits::begin(data_.expression()) + stride_traits::layout_type::address(r_, data_.size1(), c_, data_.size2()),
+				stride,
+				j
+			);
 	}
 
 
@@ -433,8 +627,8 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 	}
 
 
-	public: class const_iterator: 	public container_const_reference<matrix_diagonal>,
-									public iterator_base_traits<typename const_subiterator1_type::iterator_category>::template iterator_base<const_iterator, value_type>::type
+	public: class const_dual_iterator: 	public container_const_reference<matrix_diagonal>,
+									public iterator_base_traits<typename const_subiterator1_type::iterator_category>::template iterator_base<const_dual_iterator, value_type>::type
 	{
 		public: typedef typename const_subiterator1_type::value_type value_type;
 		public: typedef typename const_subiterator1_type::difference_type difference_type;
@@ -453,7 +647,7 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 		// Construction and destruction
 		public: BOOST_UBLAS_INLINE
-			const_iterator()
+			const_dual_iterator()
 			: container_const_reference<self_type>(),
 			  it1_(),
 			  it2_()
@@ -462,7 +656,7 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 
 		public: BOOST_UBLAS_INLINE
-			const_iterator(self_type const& mr, const_subiterator1_type const& it1, const_subiterator2_type const& it2)
+			const_dual_iterator(self_type const& mr, const_subiterator1_type const& it1, const_subiterator2_type const& it2)
 			: container_const_reference<self_type>(mr),
 			  it1_(it1),
 			  it2_(it2)
@@ -471,7 +665,7 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 
 		public: BOOST_UBLAS_INLINE
-			const_iterator(typename self_type::iterator const& it)  // ISSUE self_type:: stops VC8 using std::iterator here
+			const_dual_iterator(typename self_type::dual_iterator const& it)  // ISSUE self_type:: stops VC8 using std::iterator here
 			: container_const_reference<self_type>(it()),
 			  it1_(it.it1_),
 			  it2_(it.it2_)
@@ -481,7 +675,7 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 		// Arithmetic
 		public: BOOST_UBLAS_INLINE
-			const_iterator& operator++()
+			const_dual_iterator& operator++()
 		{
 			++it1_;
 			++it2_;
@@ -490,7 +684,7 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 
 		public: BOOST_UBLAS_INLINE
-			const_iterator& operator--()
+			const_dual_iterator& operator--()
 		{
 			--it1_;
 			--it2_;
@@ -499,16 +693,16 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 
 		public: BOOST_UBLAS_INLINE
-			const_iterator& operator+=(difference_type n)
+			const_dual_iterator& operator+=(difference_type n)
 		{
 			it1_ += n;
-			it1_ += n;
+			it2_ += n;
 			return *this;
 		}
 
 
 		public: BOOST_UBLAS_INLINE
-			const_iterator& operator-=(difference_type n)
+			const_dual_iterator& operator-=(difference_type n)
 		{
 			it1_ -= n;
 			it2_ -= n;
@@ -517,7 +711,7 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 
 		public: BOOST_UBLAS_INLINE
-			difference_type operator-(const_iterator const& it) const
+			difference_type operator-(const_dual_iterator const& it) const
 		{
 			BOOST_UBLAS_CHECK((*this)().same_closure (it()), external_logic());
 			return BOOST_UBLAS_SAME(it1_ - it.it1_, it2_ - it.it2_);
@@ -554,7 +748,7 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 		// Assignment
 		public: BOOST_UBLAS_INLINE
-			const_iterator& operator=(const_iterator const& it)
+			const_dual_iterator& operator=(const_dual_iterator const& it)
 		{
 			container_const_reference<self_type>::assign(&it());
 			it1_ = it.it1_;
@@ -565,7 +759,7 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 		// Comparison
 		public: BOOST_UBLAS_INLINE
-			bool operator==(const_iterator const& it) const
+			bool operator==(const_dual_iterator const& it) const
 		{
 			BOOST_UBLAS_CHECK((*this)().same_closure(it()), external_logic());
 			return it1_ == it.it1_ && it2_ == it.it2_;
@@ -573,7 +767,7 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 
 		public: BOOST_UBLAS_INLINE
-			bool operator<(const_iterator const& it) const
+			bool operator<(const_dual_iterator const& it) const
 		{
 			BOOST_UBLAS_CHECK((*this)().same_closure(it()), external_logic());
 			return it1_ < it.it1_ && it2_ < it.it2_;
@@ -585,8 +779,8 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 	};
 
 
-	public: class iterator: 	public container_reference<matrix_diagonal>,
-								public iterator_base_traits<typename subiterator1_type::iterator_category>::template iterator_base<iterator, value_type>::type
+	public: class dual_iterator: 	public container_reference<matrix_diagonal>,
+								public iterator_base_traits<typename subiterator1_type::iterator_category>::template iterator_base<dual_iterator, value_type>::type
 	{
 		public: typedef typename subiterator1_type::value_type value_type;
 		public: typedef typename subiterator1_type::difference_type difference_type;
@@ -605,7 +799,7 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 		// Construction and destruction
 		public: BOOST_UBLAS_INLINE
-			iterator ()
+			dual_iterator ()
 			: container_reference<self_type>(),
 			  it1_(),
 			  it2_()
@@ -614,7 +808,7 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 
 		public: BOOST_UBLAS_INLINE
-			iterator(self_type& mr, subiterator1_type const& it1, subiterator2_type const& it2)
+			dual_iterator(self_type& mr, subiterator1_type const& it1, subiterator2_type const& it2)
 			: container_reference<self_type>(mr),
 			  it1_(it1),
 			  it2_(it2)
@@ -624,7 +818,7 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 		// Arithmetic
 		public: BOOST_UBLAS_INLINE
-			iterator &operator++()
+			dual_iterator &operator++()
 		{
 			++it1_;
 			++it2_;
@@ -633,7 +827,7 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 
 		public: BOOST_UBLAS_INLINE
-			iterator& operator--()
+			dual_iterator& operator--()
 		{
 			--it1_;
 			--it2_;
@@ -642,7 +836,7 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 
 		public: BOOST_UBLAS_INLINE
-			iterator& operator+=(difference_type n)
+			dual_iterator& operator+=(difference_type n)
 		{
 			it1_ += n;
 			it2_ += n;
@@ -651,7 +845,7 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 
 		public: BOOST_UBLAS_INLINE
-			iterator& operator-=(difference_type n)
+			dual_iterator& operator-=(difference_type n)
 		{
 			it1_ -= n;
 			it2_ -= n;
@@ -660,7 +854,7 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 
 		public: BOOST_UBLAS_INLINE
-			difference_type operator-(iterator const& it) const
+			difference_type operator-(dual_iterator const& it) const
 		{
 			BOOST_UBLAS_CHECK((*this)().same_closure(it()), external_logic());
 			return BOOST_UBLAS_SAME(it1_ - it.it1_, it2_ - it.it2_);
@@ -692,7 +886,7 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 		// Assignment
 		public: BOOST_UBLAS_INLINE
-			iterator& operator=(iterator const& it)
+			dual_iterator& operator=(dual_iterator const& it)
 		{
 			container_reference<self_type>::assign(&it());
 			it1_ = it.it1_;
@@ -703,7 +897,7 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 		// Comparison
 		public: BOOST_UBLAS_INLINE
-			bool operator==(iterator const& it) const
+			bool operator==(dual_iterator const& it) const
 		{
 			BOOST_UBLAS_CHECK((*this)().same_closure(it()), external_logic());
 			return it1_ == it.it1_ && it2_ == it.it2_;
@@ -711,7 +905,7 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 
 		public: BOOST_UBLAS_INLINE
-			bool operator<(iterator const& it) const
+			bool operator<(dual_iterator const& it) const
 		{
 			BOOST_UBLAS_CHECK((*this)().same_closure(it()), external_logic());
 			return it1_ < it.it1_ && it2_ < it.it2_;
@@ -720,9 +914,297 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 
 		private: subiterator1_type it1_;
 		private: subiterator2_type it2_;
-		private: friend class const_iterator; // See the const_interator(iterator const&) constructor
+		private: friend class const_dual_iterator; // See the const_dual_iterator(dual_iterator const&) constructor
+	};
+
+
+	public: class const_strided_iterator:	public container_const_reference<matrix_diagonal>,
+											public random_access_iterator_base<dense_random_access_iterator_tag, const_strided_iterator, value_type>
+	{
+		public: typedef typename matrix_diagonal::value_type value_type;
+		public: typedef typename matrix_diagonal::difference_type difference_type;
+		public: typedef typename matrix_diagonal::const_reference reference;
+		public: typedef typename matrix_diagonal::value_type const* pointer;
+
+
+		// Construction and destruction
+		public: BOOST_UBLAS_INLINE
+			const_strided_iterator()
+			: container_const_reference<self_type>(),
+			  base_(0),
+			  stride_(0),
+			  j_(0)
+		{
+		}
+
+
+		public: BOOST_UBLAS_INLINE
+			const_strided_iterator(self_type const& mr, pointer base, difference_type stride, size_type j)
+			: container_const_reference<self_type>(mr),
+			  base_(base),
+			  stride_(stride),
+			  j_(j)
+		{
+		}
+
+
+		public: BOOST_UBLAS_INLINE
+			const_strided_iterator(typename self_type::strided_iterator const& it)  // ISSUE self_type:: stops VC8 using std::iterator here
+			: container_const_reference<self_type>(it()),
+			  base_(it.base_),
+			  stride_(it.stride_),
+			  j_(it.j_)
+		{
+		}
+
+
+		// Arithmetic
+		public: BOOST_UBLAS_INLINE
+			const_strided_iterator& operator++()
+		{
+			++j_;
+			return *this;
+		}
+
+
+		public: BOOST_UBLAS_INLINE
+			const_strided_iterator& operator--()
+		{
+			--j_;
+			return *this;
+		}
+
+
+		public: BOOST_UBLAS_INLINE
+			const_strided_iterator& operator+=(difference_type n)
+		{
+			j_ += n;
+			return *this;
+		}
+
+
+		public: BOOST_UBLAS_INLINE
+			const_strided_iterator& operator-=(difference_type n)
+		{
+			j_ -= n;
+			return *this;
+		}
+
+
+		public: BOOST_UBLAS_INLINE
+			difference_type operator-(const_strided_iterator const& it) const
+		{
+			BOOST_UBLAS_CHECK((*this)().same_closure (it()), external_logic());
+			return difference_type(j_) - difference_type(it.j_);
+		}
+
+
+		// Dereference
+		public: BOOST_UBLAS_INLINE
+			const_reference operator*() const
+		{
+			BOOST_UBLAS_CHECK(j_ < (*this)().size(), bad_index());
+			return base_[difference_type(j_)*stride_];
+		}
+
+
+		public: BOOST_UBLAS_INLINE
+			const_reference operator[](difference_type n) const
+		{
+			return *(*this + n);
+		}
+
+
+		// Index
+		public: BOOST_UBLAS_INLINE
+			size_type index() const
+		{
+			return j_;
+		}
+
+
+		/// The distance between two consecutive elements in memory.
+		public: BOOST_UBLAS_INLINE
+			difference_type stride() const
+		{
+			return stride_;
+		}
+
+
+		// Assignment
+		public: BOOST_UBLAS_INLINE
+			const_strided_iterator& operator=(const_strided_iterator const& it)
+		{
+			container_const_reference<self_type>::assign(&it());
+			base_ = it.base_;
+			stride_ = it.stride_;
+			j_ = it.j_;
+			return *this;
+		}
+
+
+		// Comparison
+		public: BOOST_UBLAS_INLINE
+			bool operator==(const_strided_iterator const& it) const
+		{
+			BOOST_UBLAS_CHECK((*this)().same_closure(it()), external_logic());
+			return j_ == it.j_;
+		}
+
+
+		public: BOOST_UBLAS_INLINE
+			bool operator<(const_strided_iterator const& it) const
+		{
+			BOOST_UBLAS_CHECK((*this)().same_closure(it()), external_logic());
+			return j_ < it.j_;
+		}
+
+
+		private: pointer base_; // The first element of the diagonal
+		private: difference_type stride_;
+		private: size_type j_;
+	};
+
+
+	public: class strided_iterator:	public container_reference<matrix_diagonal>,
+									public random_access_iterator_base<dense_random_access_iterator_tag, strided_iterator, value_type>
+	{
+		public: typedef typename matrix_diagonal::value_type value_type;
+		public: typedef typename matrix_diagonal::difference_type difference_type;
+		public: typedef typename matrix_diagonal::reference reference;
+		public: typedef typename stride_traits::pointer pointer;
+
+
+		// Construction and destruction
+		public: BOOST_UBLAS_INLINE
+			strided_iterator()
+			: container_reference<self_type>(),
+			  base_(0),
+			  stride_(0),
+			  j_(0)
+		{
+		}
+
+
+		public: BOOST_UBLAS_INLINE
+			strided_iterator(self_type& mr, pointer base, difference_type stride, size_type j)
+			: container_reference<self_type>(mr),
+			  base_(base),
+			  stride_(stride),
+			  j_(j)
+		{
+		}
+
+
+		// Arithmetic
+		public: BOOST_UBLAS_INLINE
+			strided_iterator& operator++()
+		{
+			++j_;
+			return *this;
+		}
+
+
+		public: BOOST_UBLAS_INLINE
+			strided_iterator& operator--()
+		{
+			--j_;
+			return *this;
+		}
+
+
+		public: BOOST_UBLAS_INLINE
+			strided_iterator& operator+=(difference_type n)
+		{
+			j_ += n;
+			return *this;
+		}
+
+
+		public: BOOST_UBLAS_INLINE
+			strided_iterator& operator-=(difference_type n)
+		{
+			j_ -= n;
+			return *this;
+		}
+
+
+		public: BOOST_UBLAS_INLINE
+			difference_type operator-(strided_iterator const& it) const
+		{
+			BOOST_UBLAS_CHECK((*this)().same_closure(it()), external_logic());
+			return difference_type(j_) - difference_type(it.j_);
+		}
+
+
+		// Dereference
+		public: BOOST_UBLAS_INLINE
+			reference operator*() const
+		{
+			BOOST_UBLAS_CHECK(j_ < (*this)().size(), bad_index());
+			return base_[difference_type(j_)*stride_];
+		}
+
+
+		public: BOOST_UBLAS_INLINE
+			reference operator[](difference_type n) const
+		{
+			return *(*this + n);
+		}
+
+
+		// Index
+		public: BOOST_UBLAS_INLINE
+			size_type index() const
+		{
+			return j_;
+		}
+
+
+		/// The distance between two consecutive elements in memory.
+		public: BOOST_UBLAS_INLINE
+			difference_type stride() const
+		{
+			return stride_;
+		}
+
+
+		// Assignment
+		public: BOOST_UBLAS_INLINE
+			strided_iterator& operator=(strided_iterator const& it)
+		{
+			container_reference<self_type>::assign(&it());
+			base_ = it.base_;
+			stride_ = it.stride_;
+			j_ = it.j_;
+			return *this;
+		}
+
+
+		// Comparison
+		public: BOOST_UBLAS_INLINE
+			bool operator==(strided_iterator const& it) const
+		{
+			BOOST_UBLAS_CHECK((*this)().same_closure(it()), external_logic());
+			return j_ == it.j_;
+		}
+
+
+		public: BOOST_UBLAS_INLINE
+			bool operator<(strided_iterator const& it) const
+		{
+			BOOST_UBLAS_CHECK((*this)().same_closure(it()), external_logic());
+			return j_ < it.j_;
+		}
+
+
+		private: pointer base_;
+		private: difference_type stride_;
+		private: size_type j_;
+		private: friend class const_strided_iterator; // See the const_strided_iterator(strided_iterator const&) constructor
 	};
 
+
 	//@} Iterators
 
 	//@{ Data members
@@ -735,6 +1217,22 @@ class matrix_diagonal: public vector_expression< matrix_diagonal<MatrixT> >
 	//@} Data members
 };
 
+
+namespace detail {
+
+/// \brief Alias analysis of matrix diagonals: the whole underlying matrix.
+template <typename MatrixT>
+struct storage_alias_traits< matrix_diagonal<MatrixT> >
+{
+	static BOOST_UBLAS_INLINE
+		storage_extent extent(matrix_diagonal<MatrixT> const& e)
+	{
+		return expression_extent(e.data());
+	}
+};
+
+} // Namespace detail
+
 }}} // Namespace boost::numeric::ublas
 
 
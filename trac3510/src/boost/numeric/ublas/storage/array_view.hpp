@@ -0,0 +1,352 @@
+/**
+ * \file array_view.hpp
+ *
+ * \brief Non-owning storage array over an existing chunk of memory.
+ *
+ * Copyright (c) 2009, Marco Guazzone
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * \author Marco Guazzone, marco.guazzone@gmail.com
+ */
+
+#ifndef BOOST_NUMERIC_UBLAS_STORAGE_ARRAY_VIEW_HPP
+#define BOOST_NUMERIC_UBLAS_STORAGE_ARRAY_VIEW_HPP
+
+
+#include <algorithm>
+#include <boost/numeric/ublas/detail/config.hpp>
+#include <boost/numeric/ublas/exception.hpp>
+#include <boost/numeric/ublas/storage.hpp>
+#include <cstddef>
+#include <iterator>
+
+
+namespace boost { namespace numeric { namespace ublas {
+
+/**
+ * \brief Storage array which refers to memory owned by someone else.
+ * \tparam ValueT The type of stored elements.
+ *
+ * Like \c array_adaptor, this class adapts a plain chunk of memory to the
+ * Storage concept; unlike \c array_adaptor, the memory is neither copied nor
+ * released.
+ * Copying a view yields another view over the same memory, so that a
+ * container holding an \c array_view can be returned by value without
+ * copying its elements.
+ *
+ * Resizing a view to a size not greater than the current one simply shrinks
+ * the view; growing it (as well as default- or size-construction) makes the
+ * array allocate and own its memory, like an \c unbounded_array.
+ * Assignment copies elements, whereas \c swap exchanges the referred memory.
+ *
+ * The caller is responsible for keeping the viewed memory alive.
+ *
+ * \author Marco Guazzone, marco.guazzone@gmail.com
+ */
+template <typename ValueT>
+class array_view: public storage_array< array_view<ValueT> >
+{
+	private: typedef array_view<ValueT> self_type;
+	public: typedef ::std::size_t size_type;
+	public: typedef ::std::ptrdiff_t difference_type;
+	public: typedef ValueT value_type;
+	public: typedef value_type const& const_reference;
+	public: typedef value_type& reference;
+	public: typedef value_type const* const_pointer;
+	public: typedef value_type* pointer;
+	public: typedef const_pointer const_iterator;
+	public: typedef pointer iterator;
+	public: typedef ::std::reverse_iterator<const_iterator> const_reverse_iterator;
+	public: typedef ::std::reverse_iterator<iterator> reverse_iterator;
+
+
+	//@{ Construction and destruction
+
+	public: BOOST_UBLAS_INLINE
+		array_view()
+		: size_(0),
+		  own_(true),
+		  data_(0)
+	{
+		// Empty
+	}
+
+
+	public: explicit BOOST_UBLAS_INLINE
+		array_view(size_type size)
+		: size_(size),
+		  own_(true),
+		  data_(size ? new value_type[size] : 0)
+	{
+		// Empty
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		array_view(size_type size, value_type const& init)
+		: size_(size),
+		  own_(true),
+		  data_(size ? new value_type[size] : 0)
+	{
+		::std::fill(data_, data_ + size_, init);
+	}
+
+
+	/// Create a view over \a size elements starting at \a data.
+	public: BOOST_UBLAS_INLINE
+		array_view(size_type size, pointer data)
+		: size_(size),
+		  own_(false),
+		  data_(data)
+	{
+		// Empty
+	}
+
+
+	/// A view is copied as a view; an owning array is copied deeply.
+	public: BOOST_UBLAS_INLINE
+		array_view(array_view const& a)
+		: storage_array<self_type>(),
+		  size_(a.size_),
+		  own_(a.own_),
+		  data_(a.own_ ? (a.size_ ? new value_type[a.size_] : 0) : a.data_)
+	{
+		if (own_)
+		{
+			::std::copy(a.data_, a.data_ + a.size_, data_);
+		}
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		~array_view()
+	{
+		if (own_)
+		{
+			delete[] data_;
+		}
+	}
+
+	//@} Construction and destruction
+
+	//@{ Resizing
+
+	public: BOOST_UBLAS_INLINE
+		void resize(size_type size)
+	{
+		resize_internal(size, value_type/*zero*/(), false);
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		void resize(size_type size, value_type init)
+	{
+		resize_internal(size, init, true);
+	}
+
+
+	private: BOOST_UBLAS_INLINE
+		void resize_internal(size_type size, value_type init, bool preserve)
+	{
+		if (size == size_)
+		{
+			return;
+		}
+		if (!own_ && size < size_)
+		{
+			// Keep on viewing the leading part of the memory
+			size_ = size;
+			return;
+		}
+
+		pointer data = size ? new value_type[size] : 0;
+
+		if (preserve)
+		{
+			::std::copy(data_, data_ + (::std::min)(size, size_), data);
+			::std::fill(data + (::std::min)(size, size_), data + size, init);
+		}
+		if (own_)
+		{
+			delete[] data_;
+		}
+		size_ = size;
+		own_ = true;
+		data_ = data;
+	}
+
+	//@} Resizing
+
+	//@{ Accessors
+
+	public: BOOST_UBLAS_INLINE
+		size_type size() const
+	{
+		return size_;
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		size_type max_size() const
+	{
+		return size_type(-1) / sizeof(value_type);
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		bool empty() const
+	{
+		return size_ == 0;
+	}
+
+
+	/// Tell if the array refers to memory it does not own.
+	public: BOOST_UBLAS_INLINE
+		bool is_view() const
+	{
+		return !own_;
+	}
+
+	//@} Accessors
+
+	//@{ Element access
+
+	public: BOOST_UBLAS_INLINE
+		const_reference operator[](size_type i) const
+	{
+		BOOST_UBLAS_CHECK(i < size_, bad_index());
+
+		return data_[i];
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		reference operator[](size_type i)
+	{
+		BOOST_UBLAS_CHECK(i < size_, bad_index());
+
+		return data_[i];
+	}
+
+	//@} Element access
+
+	//@{ Assignment
+
+	public: BOOST_UBLAS_INLINE
+		array_view& operator=(array_view const& a)
+	{
+		if (this != &a)
+		{
+			resize(a.size_);
+			::std::copy(a.data_, a.data_ + a.size_, data_);
+		}
+		return *this;
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		array_view& assign_temporary(array_view& a)
+	{
+		swap(a);
+		return *this;
+	}
+
+	//@} Assignment
+
+	//@{ Swapping
+
+	public: BOOST_UBLAS_INLINE
+		void swap(array_view& a)
+	{
+		if (this != &a)
+		{
+			::std::swap(size_, a.size_);
+			::std::swap(own_, a.own_);
+			::std::swap(data_, a.data_);
+		}
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		friend void swap(array_view& a1, array_view& a2)
+	{
+		a1.swap(a2);
+	}
+
+	//@} Swapping
+
+	//@{ Iterators
+
+	public: BOOST_UBLAS_INLINE
+		const_iterator begin() const
+	{
+		return data_;
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		const_iterator end() const
+	{
+		return data_ + size_;
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		iterator begin()
+	{
+		return data_;
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		iterator end()
+	{
+		return data_ + size_;
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		const_reverse_iterator rbegin() const
+	{
+		return const_reverse_iterator(end());
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		const_reverse_iterator rend() const
+	{
+		return const_reverse_iterator(begin());
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		reverse_iterator rbegin()
+	{
+		return reverse_iterator(end());
+	}
+
+
+	public: BOOST_UBLAS_INLINE
+		reverse_iterator rend()
+	{
+		return reverse_iterator(begin());
+	}
+
+	//@} Iterators
+
+	//@{ Data members
+
+	private: size_type size_; ///< The number of elements.
+	private: bool own_; ///< \c true if \c data_ must be released by this array.
+	private: pointer data_; ///< The first element.
+
+	//@} Data members
+};
+
+}}} // Namespace boost::numeric::ublas
+
+
+#endif // BOOST_NUMERIC_UBLAS_STORAGE_ARRAY_VIEW_HPP
@@ -14,11 +14,19 @@
 
 #include <boost/numeric/ublas/container/generalized_diagonal_matrix.hpp>
 #include <boost/numeric/ublas/fwd.hpp>
+#include <boost/numeric/ublas/io.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/operation/batched_diag.hpp>
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/operation/diag.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <cmath>
+#include <cstddef>
 #include <iostream>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "libs/numeric/ublas/test/utils.hpp"
 
 
@@ -284,6 +292,69 @@ BOOST_UBLAS_TEST_DEF( test_low4_diagonal_view )
 }
 
 
+BOOST_UBLAS_TEST_DEF( test_strided_diagonal_view )
+{
+	BOOST_UBLAS_DEBUG_TRACE( "TEST Strided Diagonal -- View" );
+
+	typedef double value_type;
+	typedef boost::numeric::ublas::matrix<value_type, boost::numeric::ublas::column_major> matrix_type;
+	typedef boost::numeric::ublas::matrix_diagonal<matrix_type> diagonal_type;
+
+	matrix_type A(5,4);
+
+	A(0,0) = 0.555950; A(0,1) = 0.274690; A(0,2) = 0.540605; A(0,3) = 0.798938;
+	A(1,0) = 0.108929; A(1,1) = 0.830123; A(1,2) = 0.891726; A(1,3) = 0.895283;
+	A(2,0) = 0.948014; A(2,1) = 0.973234; A(2,2) = 0.216504; A(2,3) = 0.883152;
+	A(3,0) = 0.023787; A(3,1) = 0.675382; A(3,2) = 0.231751; A(3,3) = 0.450332;
+	A(4,0) = 1.023787; A(4,1) = 1.675382; A(4,2) = 1.231751; A(4,3) = 1.450332;
+
+
+	diagonal_type D = boost::numeric::ublas::diag(A, -1);
+
+	// Check the fast path is selected
+	BOOST_UBLAS_TEST_CHECK( (boost::is_same<diagonal_type::iterator, diagonal_type::strided_iterator>::value) );
+	BOOST_UBLAS_TEST_CHECK( D.begin().stride() == 6 );
+	BOOST_UBLAS_TEST_CHECK( (D.end() - D.begin()) == 4 );
+
+	// Check reverse iteration
+	diagonal_type const& cD(D);
+	diagonal_type::size_type ix(cD.size());
+	for (
+		diagonal_type::const_reverse_iterator it = cD.rbegin();
+		it != cD.rend();
+		++it
+	) {
+		--ix;
+		BOOST_UBLAS_DEBUG_TRACE( "diag(A,-1)(" << ix << ") = " << *it << " ==> " << A(ix+1,ix) );
+		BOOST_UBLAS_TEST_CHECK( it.index() == ix );
+		BOOST_UBLAS_TEST_CHECK( std::fabs(*it - A(ix+1,ix)) <= TOL );
+	}
+
+	// Check reductions
+	value_type expect_norm(std::fabs(A(1,0))+std::fabs(A(2,1))+std::fabs(A(3,2))+std::fabs(A(4,3)));
+	BOOST_UBLAS_DEBUG_TRACE( "norm_1(diag(A,-1)) = " << boost::numeric::ublas::norm_1(D) << " ==> " << expect_norm );
+	BOOST_UBLAS_TEST_CHECK( std::fabs(boost::numeric::ublas::norm_1(D) - expect_norm) <= TOL );
+	matrix_type const& cA(A);
+	BOOST_UBLAS_DEBUG_TRACE( "norm_1(diag(const A,-1)) = " << boost::numeric::ublas::norm_1(boost::numeric::ublas::diag(cA, -1)) << " ==> " << expect_norm );
+	BOOST_UBLAS_TEST_CHECK( std::fabs(boost::numeric::ublas::norm_1(boost::numeric::ublas::diag(cA, -1)) - expect_norm) <= TOL );
+
+	// Check writes through iterators and assignments
+	for (
+		diagonal_type::iterator it = D.begin();
+		it != D.end();
+		++it
+	) {
+		*it = value_type(it.index());
+	}
+	D *= 2.0;
+	for (diagonal_type::size_type i = 0; i < D.size(); ++i)
+	{
+		BOOST_UBLAS_DEBUG_TRACE( "A(" << (i+1) << "," << i << ") = " << A(i+1,i) << " ==> " << 2.0*i );
+		BOOST_UBLAS_TEST_CHECK( std::fabs(A(i+1,i) - 2.0*i) <= TOL );
+	}
+}
+
+
 //@} View //////////////////////////////////////////////////////////////////////
 
 //@{ Creation //////////////////////////////////////////////////////////////////
@@ -1069,6 +1140,436 @@ BOOST_UBLAS_TEST_DEF( test_low4_diagonal_create_rect )
 //@} Rectangular Creation //////////////////////////////////////////////////////
 
 
+//@{ View Creation /////////////////////////////////////////////////////////////
+
+
+BOOST_UBLAS_TEST_DEF( test_main_diagonal_create_view )
+{
+	BOOST_UBLAS_DEBUG_TRACE( "TEST Main Diagonal -- Create View" );
+
+	typedef double value_type;
+	typedef boost::numeric::ublas::vector<value_type> vector_type;
+	typedef boost::numeric::ublas::vector_matrix_diag_view_traits<vector_type,boost::numeric::ublas::row_major>::result_type matrix_type;
+
+	vector_type v(5);
+
+	v(0) = 0.555950;
+	v(1) = 0.108929;
+	v(2) = 0.948014;
+	v(3) = 0.023787;
+	v(4) = 1.023787;
+
+
+	matrix_type D = boost::numeric::ublas::diag_view(v);
+
+	// Check dimensions
+	BOOST_UBLAS_DEBUG_TRACE( "D.size1() = " << D.size1() << " ==> " << 5 );
+	BOOST_UBLAS_TEST_CHECK( D.size1() == 5 );
+	BOOST_UBLAS_DEBUG_TRACE( "D.size2() = " << D.size2() << " ==> " << 5 );
+	BOOST_UBLAS_TEST_CHECK( D.size2() == 5 );
+
+	// Check storage is shared
+	BOOST_UBLAS_TEST_CHECK( D.data().is_view() );
+	BOOST_UBLAS_TEST_CHECK( &D.data()[0] == &v(0) );
+
+	// Check writes go through
+	D(2,2) = 2.0;
+	BOOST_UBLAS_DEBUG_TRACE( "v(2) = " << v(2) << " ==> " << 2.0 );
+	BOOST_UBLAS_TEST_CHECK( std::fabs(v(2) - 2.0) <= TOL );
+	v(3) = 3.0;
+	BOOST_UBLAS_DEBUG_TRACE( "D(3,3) = " << D(3,3) << " ==> " << 3.0 );
+	BOOST_UBLAS_TEST_CHECK( std::fabs(D(3,3) - 3.0) <= TOL );
+
+	// Check Elements
+	matrix_type const& cD(D);
+	for (std::size_t i = 0; i < cD.size1(); ++i)
+	{
+		for (std::size_t j = 0; j < cD.size2(); ++j)
+		{
+			BOOST_UBLAS_TEST_CHECK( std::fabs(cD(i,j) - (i == j ? v(i) : value_type(0))) <= TOL );
+		}
+	}
+}
+
+
+BOOST_UBLAS_TEST_DEF( test_low1_diagonal_create_rect_view )
+{
+	BOOST_UBLAS_DEBUG_TRACE( "TEST First Lower Diagonal -- Create Rectangular View" );
+
+	typedef double value_type;
+	typedef boost::numeric::ublas::vector<value_type> vector_type;
+	typedef boost::numeric::ublas::vector_matrix_diag_view_traits<vector_type,boost::numeric::ublas::row_major>::result_type matrix_type;
+
+	vector_type v(5);
+
+	v(0) = 0.555950;
+	v(1) = 0.108929;
+	v(2) = 0.948014;
+	v(3) = 0.023787;
+	v(4) = 1.023787;
+
+
+	matrix_type D = boost::numeric::ublas::diag_view(v, 5, 4, -1);
+
+	// Check dimensions (v is truncated to the diagonal length)
+	BOOST_UBLAS_TEST_CHECK( D.size1() == 5 );
+	BOOST_UBLAS_TEST_CHECK( D.size2() == 4 );
+	BOOST_UBLAS_TEST_CHECK( D.offset() == -1 );
+	BOOST_UBLAS_TEST_CHECK( D.data().size() == 4 );
+	BOOST_UBLAS_TEST_CHECK( D.data().is_view() );
+
+	// Check a copy is still a view
+	matrix_type C(D);
+	C(2,1) = 2.0;
+	BOOST_UBLAS_DEBUG_TRACE( "v(1) = " << v(1) << " ==> " << 2.0 );
+	BOOST_UBLAS_TEST_CHECK( std::fabs(v(1) - 2.0) <= TOL );
+	BOOST_UBLAS_TEST_CHECK( std::fabs(D(2,1) - 2.0) <= TOL );
+
+	// Check whole assignment detaches from v
+	D = boost::numeric::ublas::zero_matrix<value_type>(5, 4);
+	BOOST_UBLAS_TEST_CHECK( !D.data().is_view() );
+	BOOST_UBLAS_TEST_CHECK( std::fabs(v(1) - 2.0) <= TOL );
+}
+
+
+//@} View Creation /////////////////////////////////////////////////////////////
+
+
+//@{ Diagonal Scaling /////////////////////////////////////////////////////////
+
+
+BOOST_UBLAS_TEST_DEF( test_left_diagonal_scaling )
+{
+	BOOST_UBLAS_DEBUG_TRACE( "TEST Left Diagonal Scaling" );
+
+	typedef double value_type;
+	typedef boost::numeric::ublas::vector<value_type> vector_type;
+	typedef boost::numeric::ublas::matrix<value_type> matrix_type;
+	typedef boost::numeric::ublas::generalized_diagonal_matrix<value_type> diagonal_matrix_type;
+
+	matrix_type A(5,4);
+
+	A(0,0) = 0.555950; A(0,1) = 0.274690; A(0,2) = 0.540605; A(0,3) = 0.798938;
+	A(1,0) = 0.108929; A(1,1) = 0.830123; A(1,2) = 0.891726; A(1,3) = 0.895283;
+	A(2,0) = 0.948014; A(2,1) = 0.973234; A(2,2) = 0.216504; A(2,3) = 0.883152;
+	A(3,0) = 0.023787; A(3,1) = 0.675382; A(3,2) = 0.231751; A(3,3) = 0.450332;
+	A(4,0) = 1.023787; A(4,1) = 1.675382; A(4,2) = 1.231751; A(4,3) = 1.450332;
+
+	vector_type v(5);
+
+	v(0) = 0.555950;
+	v(1) = 0.108929;
+	v(2) = 0.948014;
+	v(3) = 0.023787;
+	v(4) = 1.023787;
+
+	// 6x5 with first lower diagonal
+	diagonal_matrix_type D = boost::numeric::ublas::diag(v, 6, 5, -1);
+
+	matrix_type B = boost::numeric::ublas::prod(D, A);
+	matrix_type expect = boost::numeric::ublas::prod(matrix_type(D), A);
+
+	BOOST_UBLAS_DEBUG_TRACE( "D*A = " << B << " ==> " << expect );
+	BOOST_UBLAS_TEST_CHECK( B.size1() == expect.size1() );
+	BOOST_UBLAS_TEST_CHECK( B.size2() == expect.size2() );
+	for (matrix_type::size_type i = 0; i < expect.size1(); ++i)
+	{
+		for (matrix_type::size_type j = 0; j < expect.size2(); ++j)
+		{
+			BOOST_UBLAS_TEST_CHECK( std::fabs(B(i,j) - expect(i,j)) <= TOL );
+		}
+	}
+}
+
+
+BOOST_UBLAS_TEST_DEF( test_right_diagonal_scaling )
+{
+	BOOST_UBLAS_DEBUG_TRACE( "TEST Right Diagonal Scaling" );
+
+	typedef double value_type;
+	typedef boost::numeric::ublas::vector<value_type> vector_type;
+	typedef boost::numeric::ublas::matrix<value_type> matrix_type;
+	typedef boost::numeric::ublas::generalized_diagonal_matrix<value_type> diagonal_matrix_type;
+
+	matrix_type A(5,4);
+
+	A(0,0) = 0.555950; A(0,1) = 0.274690; A(0,2) = 0.540605; A(0,3) = 0.798938;
+	A(1,0) = 0.108929; A(1,1) = 0.830123; A(1,2) = 0.891726; A(1,3) = 0.895283;
+	A(2,0) = 0.948014; A(2,1) = 0.973234; A(2,2) = 0.216504; A(2,3) = 0.883152;
+	A(3,0) = 0.023787; A(3,1) = 0.675382; A(3,2) = 0.231751; A(3,3) = 0.450332;
+	A(4,0) = 1.023787; A(4,1) = 1.675382; A(4,2) = 1.231751; A(4,3) = 1.450332;
+
+	vector_type v(3);
+
+	v(0) = 0.274690;
+	v(1) = 0.830123;
+	v(2) = 0.973234;
+
+	// 4x4 with first upper diagonal
+	diagonal_matrix_type D = boost::numeric::ublas::diag(v, 1);
+
+	matrix_type B = boost::numeric::ublas::prod(A, D);
+	matrix_type expect = boost::numeric::ublas::prod(A, matrix_type(D));
+
+	BOOST_UBLAS_DEBUG_TRACE( "A*D = " << B << " ==> " << expect );
+	BOOST_UBLAS_TEST_CHECK( B.size1() == expect.size1() );
+	BOOST_UBLAS_TEST_CHECK( B.size2() == expect.size2() );
+	for (matrix_type::size_type i = 0; i < expect.size1(); ++i)
+	{
+		for (matrix_type::size_type j = 0; j < expect.size2(); ++j)
+		{
+			BOOST_UBLAS_TEST_CHECK( std::fabs(B(i,j) - expect(i,j)) <= TOL );
+		}
+	}
+}
+
+
+BOOST_UBLAS_TEST_DEF( test_two_sided_diagonal_scaling )
+{
+	BOOST_UBLAS_DEBUG_TRACE( "TEST Two-sided Diagonal Scaling" );
+
+	typedef double value_type;
+	typedef boost::numeric::ublas::vector<value_type> vector_type;
+	typedef boost::numeric::ublas::matrix<value_type> matrix_type;
+	typedef boost::numeric::ublas::generalized_diagonal_matrix<value_type> diagonal_matrix_type;
+
+	matrix_type A(5,4);
+
+	A(0,0) = 0.555950; A(0,1) = 0.274690; A(0,2) = 0.540605; A(0,3) = 0.798938;
+	A(1,0) = 0.108929; A(1,1) = 0.830123; A(1,2) = 0.891726; A(1,3) = 0.895283;
+	A(2,0) = 0.948014; A(2,1) = 0.973234; A(2,2) = 0.216504; A(2,3) = 0.883152;
+	A(3,0) = 0.023787; A(3,1) = 0.675382; A(3,2) = 0.231751; A(3,3) = 0.450332;
+	A(4,0) = 1.023787; A(4,1) = 1.675382; A(4,2) = 1.231751; A(4,3) = 1.450332;
+
+	vector_type v1(5);
+
+	v1(0) = 0.555950;
+	v1(1) = 0.108929;
+	v1(2) = 0.948014;
+	v1(3) = 0.023787;
+	v1(4) = 1.023787;
+
+	vector_type v2(3);
+
+	v2(0) = 0.274690;
+	v2(1) = 0.830123;
+	v2(2) = 0.973234;
+
+	diagonal_matrix_type D1 = boost::numeric::ublas::diag(v1);
+	// 4x3 with first lower diagonal
+	diagonal_matrix_type D2 = boost::numeric::ublas::diag(v2, 4, 3, -1);
+
+	matrix_type expect = boost::numeric::ublas::prod(matrix_type(D1), matrix_type(boost::numeric::ublas::prod(A, matrix_type(D2))));
+
+	// D1*(A*D2)
+	matrix_type B = boost::numeric::ublas::prod(D1, boost::numeric::ublas::prod(A, D2));
+
+	BOOST_UBLAS_DEBUG_TRACE( "D1*(A*D2) = " << B << " ==> " << expect );
+	BOOST_UBLAS_TEST_CHECK( B.size1() == expect.size1() );
+	BOOST_UBLAS_TEST_CHECK( B.size2() == expect.size2() );
+	for (matrix_type::size_type i = 0; i < expect.size1(); ++i)
+	{
+		for (matrix_type::size_type j = 0; j < expect.size2(); ++j)
+		{
+			BOOST_UBLAS_TEST_CHECK( std::fabs(B(i,j) - expect(i,j)) <= TOL );
+		}
+	}
+
+	// (D1*A)*D2
+	matrix_type C = boost::numeric::ublas::prod(boost::numeric::ublas::prod(D1, A), D2);
+
+	BOOST_UBLAS_DEBUG_TRACE( "(D1*A)*D2 = " << C << " ==> " << expect );
+	BOOST_UBLAS_TEST_CHECK( C.size1() == expect.size1() );
+	BOOST_UBLAS_TEST_CHECK( C.size2() == expect.size2() );
+	for (matrix_type::size_type i = 0; i < expect.size1(); ++i)
+	{
+		for (matrix_type::size_type j = 0; j < expect.size2(); ++j)
+		{
+			BOOST_UBLAS_TEST_CHECK( std::fabs(C(i,j) - expect(i,j)) <= TOL );
+		}
+	}
+}
+
+
+//@} Diagonal Scaling //////////////////////////////////////////////////////////
+
+
+//@{ Batched Diagonals ////////////////////////////////////////////////////////
+
+
+BOOST_UBLAS_TEST_DEF( test_batched_diagonal )
+{
+	BOOST_UBLAS_DEBUG_TRACE( "TEST Batched Diagonals" );
+
+	typedef double value_type;
+	typedef boost::numeric::ublas::vector<value_type> vector_type;
+	typedef boost::numeric::ublas::matrix<value_type> matrix_type;
+
+	const std::size_t nb(3);
+	const std::size_t n1(4);
+	const std::size_t n2(3);
+
+	// nb consecutive n1xn2 row-major matrices, with B_b(i,j) = 100b+10i+j
+	std::vector<value_type> blocks(nb*n1*n2);
+	for (std::size_t b = 0; b < nb; ++b)
+	{
+		for (std::size_t i = 0; i < n1; ++i)
+		{
+			for (std::size_t j = 0; j < n2; ++j)
+			{
+				blocks[b*n1*n2+i*n2+j] = 100.0*b+10.0*i+j;
+			}
+		}
+	}
+
+	// Gather the first lower diagonals
+	BOOST_UBLAS_TEST_CHECK( boost::numeric::ublas::batched_diag_size(n1, n2, -1) == 3 );
+	vector_type d(nb*3);
+	boost::numeric::ublas::batched_diag(&blocks[0], nb, n1, n2, -1, d);
+	for (std::size_t b = 0; b < nb; ++b)
+	{
+		for (std::size_t p = 0; p < 3; ++p)
+		{
+			value_type expect(100.0*b+10.0*(p+1)+p);
+			BOOST_UBLAS_DEBUG_TRACE( "d(" << (b*3+p) << ") = " << d(b*3+p) << " ==> " << expect );
+			BOOST_UBLAS_TEST_CHECK( std::fabs(d(b*3+p) - expect) <= TOL );
+		}
+	}
+
+	// Scatter back an updated diagonal
+	boost::numeric::ublas::batched_diag_assign(&blocks[0], nb, n1, n2, -1, 2.0*d);
+	boost::numeric::ublas::batched_diag_assign<boost::numeric::ublas::scalar_plus_assign>(&blocks[0], nb, n1, n2, -1, d);
+	for (std::size_t b = 0; b < nb; ++b)
+	{
+		matrix_type B(n1, n2);
+		std::copy(&blocks[b*n1*n2], &blocks[b*n1*n2]+n1*n2, B.data().begin());
+		for (std::size_t i = 0; i < n1; ++i)
+		{
+			for (std::size_t j = 0; j < n2; ++j)
+			{
+				value_type expect((i == j+1 ? 3.0 : 1.0)*(100.0*b+10.0*i+j));
+				BOOST_UBLAS_DEBUG_TRACE( "B_" << b << "(" << i << "," << j << ") = " << B(i,j) << " ==> " << expect );
+				BOOST_UBLAS_TEST_CHECK( std::fabs(B(i,j) - expect) <= TOL );
+			}
+		}
+	}
+
+	// Column-major upper diagonal, compared with diag()
+	typedef boost::numeric::ublas::matrix<value_type, boost::numeric::ublas::column_major> cm_matrix_type;
+	std::vector<cm_matrix_type> Bs(nb, cm_matrix_type(n1, n2));
+	std::vector<value_type> cm_blocks(nb*n1*n2);
+	for (std::size_t b = 0; b < nb; ++b)
+	{
+		for (std::size_t i = 0; i < n1; ++i)
+		{
+			for (std::size_t j = 0; j < n2; ++j)
+			{
+				Bs[b](i,j) = 100.0*b+10.0*i+j;
+			}
+		}
+		std::copy(Bs[b].data().begin(), Bs[b].data().end(), &cm_blocks[b*n1*n2]);
+	}
+	vector_type cd(nb*2);
+	boost::numeric::ublas::batched_diag(&cm_blocks[0], nb, n1, n2, 1, cd, boost::numeric::ublas::column_major());
+	for (std::size_t b = 0; b < nb; ++b)
+	{
+		vector_type expect(boost::numeric::ublas::diag(Bs[b], 1));
+		for (std::size_t p = 0; p < 2; ++p)
+		{
+			BOOST_UBLAS_DEBUG_TRACE( "cd(" << (b*2+p) << ") = " << cd(b*2+p) << " ==> " << expect(p) );
+			BOOST_UBLAS_TEST_CHECK( std::fabs(cd(b*2+p) - expect(p)) <= TOL );
+		}
+	}
+
+#ifdef _OPENMP
+	// Blocks partitioned among the threads: same results whatever their number
+	const std::size_t mb(61);
+	std::vector<value_type> many(mb*n1*n2);
+	for (std::size_t k = 0; k < many.size(); ++k)
+	{
+		many[k] = k;
+	}
+	for (int threads = 1; threads <= 8; ++threads)
+	{
+		omp_set_num_threads(threads);
+		vector_type md(mb*3);
+		boost::numeric::ublas::batched_diag(&many[0], mb, n1, n2, -1, md);
+		boost::numeric::ublas::batched_diag_assign<boost::numeric::ublas::scalar_plus_assign>(&many[0], mb, n1, n2, -1, md);
+		for (std::size_t b = 0; b < mb; ++b)
+		{
+			for (std::size_t p = 0; p < 3; ++p)
+			{
+				std::size_t k(b*n1*n2+(p+1)*n2+p);
+				BOOST_UBLAS_TEST_CHECK( md(b*3+p) == value_type(k) );
+				BOOST_UBLAS_TEST_CHECK( many[k] == 2*value_type(k) );
+			}
+		}
+		boost::numeric::ublas::batched_diag_assign(&many[0], mb, n1, n2, -1, md);
+	}
+	BOOST_UBLAS_DEBUG_TRACE( "batched diagonals with 1 to 8 threads checked" );
+#endif // _OPENMP
+}
+
+
+//@} Batched Diagonals ////////////////////////////////////////////////////////
+
+
+//@{ Assignment Aliasing ///////////////////////////////////////////////////////
+
+
+BOOST_UBLAS_TEST_DEF( test_diagonal_assign_alias )
+{
+	BOOST_UBLAS_DEBUG_TRACE( "TEST Diagonal -- Assignment Aliasing" );
+
+	typedef double value_type;
+	typedef boost::numeric::ublas::vector<value_type> vector_type;
+	typedef boost::numeric::ublas::matrix<value_type> matrix_type;
+
+	const std::size_t n(4);
+
+	matrix_type A(n, n);
+	matrix_type B(n, n);
+	vector_type x(n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		for (std::size_t j = 0; j < n; ++j)
+		{
+			A(i,j) = 10.0*i+j;
+			B(i,j) = 100.0+10.0*i+j;
+		}
+		x(i) = 1.0;
+	}
+
+	boost::numeric::ublas::detail::storage_extent a(boost::numeric::ublas::detail::expression_extent(A));
+	BOOST_UBLAS_TEST_CHECK( !boost::numeric::ublas::detail::expression_may_alias(boost::numeric::ublas::diag(B, 1), a) );
+	BOOST_UBLAS_TEST_CHECK( boost::numeric::ublas::detail::expression_may_alias(boost::numeric::ublas::diag(A, 1), a) );
+	BOOST_UBLAS_TEST_CHECK( boost::numeric::ublas::detail::expression_may_alias(boost::numeric::ublas::prod(A, x), a) );
+	BOOST_UBLAS_TEST_CHECK( !boost::numeric::ublas::detail::expression_may_alias(boost::numeric::ublas::prod(B, x), a) );
+
+	// Without aliasing the diagonal is assigned in place
+	boost::numeric::ublas::diag(A) = boost::numeric::ublas::diag(B);
+	boost::numeric::ublas::diag(A) += x;
+	boost::numeric::ublas::diag(A) -= boost::numeric::ublas::diag(B);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		BOOST_UBLAS_DEBUG_TRACE( "A(" << i << "," << i << ") = " << A(i,i) << " ==> " << 1.0 );
+		BOOST_UBLAS_TEST_CHECK( std::fabs(A(i,i) - 1.0) <= TOL );
+	}
+
+	// The row sums read the diagonal being assigned
+	vector_type s(boost::numeric::ublas::prod(A, x));
+	boost::numeric::ublas::diag(A) = boost::numeric::ublas::prod(A, x);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		BOOST_UBLAS_DEBUG_TRACE( "A(" << i << "," << i << ") = " << A(i,i) << " ==> " << s(i) );
+		BOOST_UBLAS_TEST_CHECK( std::fabs(A(i,i) - s(i)) <= TOL );
+	}
+}
+
+
+//@} Assignment Aliasing ///////////////////////////////////////////////////////
+
+
 int main()
 {
 	BOOST_UBLAS_TEST_BEGIN();
@@ -1081,6 +1582,7 @@ int main()
 	BOOST_UBLAS_TEST_DO( test_low2_diagonal_view );
 	BOOST_UBLAS_TEST_DO( test_low3_diagonal_view );
 	BOOST_UBLAS_TEST_DO( test_low4_diagonal_view );
+	BOOST_UBLAS_TEST_DO( test_strided_diagonal_view );
 
 	BOOST_UBLAS_TEST_DO( test_main_diagonal_create );
 	BOOST_UBLAS_TEST_DO( test_up1_diagonal_create );
@@ -1100,5 +1602,16 @@ int main()
 	BOOST_UBLAS_TEST_DO( test_low3_diagonal_create_rect );
 	BOOST_UBLAS_TEST_DO( test_low4_diagonal_create_rect );
 
+	BOOST_UBLAS_TEST_DO( test_main_diagonal_create_view );
+	BOOST_UBLAS_TEST_DO( test_low1_diagonal_create_rect_view );
+
+	BOOST_UBLAS_TEST_DO( test_left_diagonal_scaling );
+	BOOST_UBLAS_TEST_DO( test_right_diagonal_scaling );
+	BOOST_UBLAS_TEST_DO( test_two_sided_diagonal_scaling );
+
+	BOOST_UBLAS_TEST_DO( test_batched_diagonal );
+
+	BOOST_UBLAS_TEST_DO( test_diagonal_assign_alias );
+
 	BOOST_UBLAS_TEST_END();
 }
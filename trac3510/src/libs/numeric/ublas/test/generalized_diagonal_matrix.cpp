@@ -17,6 +17,7 @@
 #include <boost/numeric/ublas/matrix_expression.hpp>
 #include <boost/numeric/ublas/vector.hpp>
 #include <cmath>
+#include <cstddef>
 #include <iostream>
 #include "libs/numeric/ublas/test/utils.hpp"
 
@@ -2155,9 +2156,199 @@ BOOST_UBLAS_TEST_DEF( test_op_element_div_dense )
 }
 
 
+BOOST_UBLAS_TEST_DEF( test_op_solve )
+{
+	BOOST_UBLAS_DEBUG_TRACE( "TEST Operations -- Solve Main Diagonal" );
+
+	typedef double value_type;
+	typedef boost::numeric::ublas::generalized_diagonal_matrix<value_type> matrix_type;
+	typedef boost::numeric::ublas::vector<value_type> vector_type;
+
+	matrix_type D(4);
+
+	D(0,0) = 0.555950; /* 0 */            /* 0 */            /* 0 */
+	/* 0 */            D(1,1) = 0.830123; /* 0 */            /* 0 */
+	/* 0 */            /* 0 */            D(2,2) = 0.216504; /* 0 */
+	/* 0 */            /* 0 */            /* 0 */            D(3,3) = 0.450332;
+
+	vector_type b(4);
+
+	b(0) = 0.274690; b(1) = 0.891726; b(2) = 0.883152; b(3) = 0.798938;
+
+	vector_type x = boost::numeric::ublas::solve(D, b);
+
+	BOOST_UBLAS_TEST_CHECK( x.size() == 4 );
+	for (std::size_t i = 0; i < x.size(); ++i)
+	{
+		const value_type t = b(i)/static_cast<matrix_type const&>(D)(i,i);
+
+		BOOST_UBLAS_DEBUG_TRACE( "x(" << i << ") " << x(i) << " ==> " << t );
+		BOOST_UBLAS_TEST_CHECK( std::fabs(x(i) - t) <= TOL );
+	}
+
+	boost::numeric::ublas::inplace_solve(D, b);
+
+	for (std::size_t i = 0; i < b.size(); ++i)
+	{
+		BOOST_UBLAS_DEBUG_TRACE( "b(" << i << ") " << b(i) << " ==> " << x(i) );
+		BOOST_UBLAS_TEST_CHECK( std::fabs(b(i) - x(i)) <= TOL );
+	}
+}
+
+
+BOOST_UBLAS_TEST_DEF( test_op_solve_rect )
+{
+	BOOST_UBLAS_DEBUG_TRACE( "TEST Operations -- Solve Rectangular Lower Diagonal" );
+
+	typedef double value_type;
+	typedef boost::numeric::ublas::generalized_diagonal_matrix<value_type> matrix_type;
+	typedef boost::numeric::ublas::vector<value_type> vector_type;
+
+	matrix_type D(5, 4, -2);
+
+	/* 0 */            /* 0 */            /* 0 */            /* 0 */
+	/* 0 */            /* 0 */            /* 0 */            /* 0 */
+	D(2,0) = 0.948014; /* 0 */            /* 0 */            /* 0 */
+	/* 0 */            D(3,1) = 0.675382; /* 0 */            /* 0 */
+	/* 0 */            /* 0 */            D(4,2) = 1.231751; /* 0 */
+
+	vector_type b(5);
+
+	b(0) = 0.555950; b(1) = 0.108929; b(2) = 0.948014; b(3) = 0.023787; b(4) = 1.023787;
+
+	vector_type x = boost::numeric::ublas::solve(D, b);
+
+	vector_type t(4);
+
+	t(0) = b(2)/0.948014; t(1) = b(3)/0.675382; t(2) = b(4)/1.231751; t(3) = 0;
+
+	BOOST_UBLAS_TEST_CHECK( x.size() == 4 );
+	for (std::size_t i = 0; i < x.size(); ++i)
+	{
+		BOOST_UBLAS_DEBUG_TRACE( "x(" << i << ") " << x(i) << " ==> " << t(i) );
+		BOOST_UBLAS_TEST_CHECK( std::fabs(x(i) - t(i)) <= TOL );
+	}
+}
+
+
+BOOST_UBLAS_TEST_DEF( test_op_inverse )
+{
+	BOOST_UBLAS_DEBUG_TRACE( "TEST Operations -- Inverse" );
+
+	typedef double value_type;
+	typedef boost::numeric::ublas::generalized_diagonal_matrix<value_type> matrix_type;
+
+	matrix_type D(5, 4, -2);
+
+	/* 0 */            /* 0 */            /* 0 */            /* 0 */
+	/* 0 */            /* 0 */            /* 0 */            /* 0 */
+	D(2,0) = 0.948014; /* 0 */            /* 0 */            /* 0 */
+	/* 0 */            D(3,1) = 0;        /* 0 */            /* 0 */
+	/* 0 */            /* 0 */            D(4,2) = 1.231751; /* 0 */
+
+	matrix_type T(4, 5, 2);
+
+	/* 0 */ /* 0 */ T(0,2) = 1/0.948014; /* 0 */  /* 0 */
+	/* 0 */ /* 0 */ /* 0 */              T(1,3) = 0; /* 0 */
+	/* 0 */ /* 0 */ /* 0 */              /* 0 */  T(2,4) = 1/1.231751;
+	/* 0 */ /* 0 */ /* 0 */              /* 0 */  /* 0 */
+
+	matrix_type C = boost::numeric::ublas::inverse(D);
+
+	BOOST_UBLAS_TEST_CHECK( C.size1() == T.size1() );
+	BOOST_UBLAS_TEST_CHECK( C.size2() == T.size2() );
+	BOOST_UBLAS_TEST_CHECK( C.offset() == T.offset() );
+	for (std::size_t row = 0; row < C.size1(); ++row)
+	{
+		for (std::size_t col = 0; col < C.size2(); ++col)
+		{
+			const matrix_type::value_type c = static_cast<matrix_type const&>(C)(row,col); // FIXME: This type of cast is very boring!!
+			const matrix_type::value_type t = static_cast<matrix_type const&>(T)(row,col); // FIXME: This type of cast is very boring!!
+
+			BOOST_UBLAS_DEBUG_TRACE( "C(" << row << "," << col << ") " << c << " ==> " << t );
+			BOOST_UBLAS_TEST_CHECK( std::fabs(c - t) <= TOL );
+		}
+	}
+}
+
+
 //@} Matrix Operations /////////////////////////////////////////////////////////
 
 
+//@{ Assignment Aliasing ///////////////////////////////////////////////////////
+
+
+BOOST_UBLAS_TEST_DEF( test_assign_alias )
+{
+	BOOST_UBLAS_DEBUG_TRACE( "TEST Assignment Aliasing" );
+
+	typedef double value_type;
+	typedef boost::numeric::ublas::generalized_diagonal_matrix<value_type> matrix_type;
+	typedef boost::numeric::ublas::vector<value_type> vector_type;
+
+	const std::size_t n(4);
+
+	vector_type u(n-1);
+	vector_type v(n-1);
+	for (std::size_t i = 0; i < n-1; ++i)
+	{
+		u(i) = 1.0+i;
+		v(i) = 10.0*(1.0+i);
+	}
+
+	matrix_type A(u, 1);
+	matrix_type B(v, 1);
+	matrix_type C(v, 1);
+
+	// Disjoint leaves are detected, a self reference is not
+	boost::numeric::ublas::detail::storage_extent a(boost::numeric::ublas::detail::array_extent(A.data()));
+	BOOST_UBLAS_TEST_CHECK( !boost::numeric::ublas::detail::expression_may_alias(B + C, a) );
+	BOOST_UBLAS_TEST_CHECK( !boost::numeric::ublas::detail::expression_may_alias(boost::numeric::ublas::trans(B), a) );
+	BOOST_UBLAS_TEST_CHECK( boost::numeric::ublas::detail::expression_may_alias(B - A, a) );
+	BOOST_UBLAS_TEST_CHECK( boost::numeric::ublas::detail::expression_may_alias(boost::numeric::ublas::prod(B, A), a) );
+	BOOST_UBLAS_TEST_CHECK( !boost::numeric::ublas::detail::expression_may_alias(boost::numeric::ublas::zero_matrix<value_type>(n, n), a) );
+
+	// Assignment without temporary
+	A = B + C;
+	for (std::size_t i = 0; i < n-1; ++i)
+	{
+		BOOST_UBLAS_DEBUG_TRACE( "A(" << i << "," << (i+1) << ") = " << A(i,i+1) << " ==> " << 2*v(i) );
+		BOOST_UBLAS_TEST_CHECK( std::fabs(A(i,i+1) - 2*v(i)) <= TOL );
+	}
+	A += B;
+	A -= C;
+	A = u;
+	for (std::size_t i = 0; i < n-1; ++i)
+	{
+		BOOST_UBLAS_DEBUG_TRACE( "A(" << i << "," << (i+1) << ") = " << A(i,i+1) << " ==> " << u(i) );
+		BOOST_UBLAS_TEST_CHECK( std::fabs(A(i,i+1) - u(i)) <= TOL );
+	}
+
+	// Aliased assignment, still through a temporary
+	A = A + B;
+	A += A;
+	for (std::size_t i = 0; i < n-1; ++i)
+	{
+		BOOST_UBLAS_DEBUG_TRACE( "A(" << i << "," << (i+1) << ") = " << A(i,i+1) << " ==> " << 2*(u(i)+v(i)) );
+		BOOST_UBLAS_TEST_CHECK( std::fabs(A(i,i+1) - 2*(u(i)+v(i))) <= TOL );
+	}
+
+	// A shape change always goes through a temporary
+	matrix_type D(2, 1);
+	D = B + C;
+	BOOST_UBLAS_TEST_CHECK( D.size1() == B.size1() );
+	BOOST_UBLAS_TEST_CHECK( D.size2() == B.size2() );
+	for (std::size_t i = 0; i < n-1; ++i)
+	{
+		BOOST_UBLAS_DEBUG_TRACE( "D(" << i << "," << (i+1) << ") = " << D(i,i+1) << " ==> " << 2*v(i) );
+		BOOST_UBLAS_TEST_CHECK( std::fabs(D(i,i+1) - 2*v(i)) <= TOL );
+	}
+}
+
+
+//@} Assignment Aliasing ///////////////////////////////////////////////////////
+
+
 int main()
 {
 	BOOST_UBLAS_TEST_BEGIN();
@@ -2255,6 +2446,12 @@ int main()
 	BOOST_UBLAS_TEST_DO( test_op_prod );
 	BOOST_UBLAS_TEST_DO( test_op_element_prod_dense );
 	BOOST_UBLAS_TEST_DO( test_op_element_div_dense );
+	BOOST_UBLAS_TEST_DO( test_op_solve );
+	BOOST_UBLAS_TEST_DO( test_op_solve_rect );
+	BOOST_UBLAS_TEST_DO( test_op_inverse );
+
+	// Assignment aliasing tests
+	BOOST_UBLAS_TEST_DO( test_assign_alias );
 
 	BOOST_UBLAS_TEST_END();
 }
@@ -0,0 +1,399 @@
+//
+//  Copyright (c) 2000-2010
+//  Joerg Walter, Mathias Koch, Gunter Winkler
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+//  The authors gratefully acknowledge the support of
+//  GeNeSys mbH & Co. KG in producing this work.
+//
+
+#ifndef _BOOST_UBLAS_DEFERRED_ASSIGN_
+#define _BOOST_UBLAS_DEFERRED_ASSIGN_
+
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+// Deferred evaluation of sequences of assignments. The statements
+//
+//     deferred_vector_assign ()
+//         .assign (x, a + b)
+//         .assign (y, x * s)
+//         .minus_assign (z, x)
+//         .evaluate ();
+//
+// have the effect of x.assign (a + b); y.assign (x * s); z.minus_assign (x); but
+// are evaluated in a single traversal when all the destinations are dense containers
+// of the same size (and for matrices of the same orientation): for each index the
+// statements are applied in order, so a statement reading the destination of a
+// previous one at the same index gets the value just computed. Naming a shared subexpression by the
+// destination of an earlier statement thus eliminates it: above a and b are read
+// once and x is read back from the cache instead of being recomputed.
+//
+// Fusion requires every statement to read the destinations only at the index being
+// assigned: the statements are fused only if all their expressions are element wise
+// expressions of containers (see detail::deferred_elementwise). Statements with
+// products, transposes or ranges are evaluated one after the other, like the
+// assign () members of the containers.
+
+namespace boost { namespace numeric { namespace ublas {
+namespace detail {
+
+    // True for the expressions whose element at an index only depends on the elements
+    // of their operands at the same index: containers, and unary, binary and scalar
+    // operations of such expressions
+    template<class E>
+    struct deferred_elementwise {
+        static const bool value = false;
+    };
+    template<class E>
+    struct deferred_elementwise<const E> {
+        static const bool value = deferred_elementwise<E>::value;
+    };
+    template<class T, class A>
+    struct deferred_elementwise<vector<T, A> > {
+        static const bool value = true;
+    };
+    template<class T, std::size_t N>
+    struct deferred_elementwise<bounded_vector<T, N> > {
+        static const bool value = true;
+    };
+    template<class T, std::size_t N>
+    struct deferred_elementwise<c_vector<T, N> > {
+        static const bool value = true;
+    };
+    template<class T, class ALLOC>
+    struct deferred_elementwise<unit_vector<T, ALLOC> > {
+        static const bool value = true;
+    };
+    template<class T, class ALLOC>
+    struct deferred_elementwise<zero_vector<T, ALLOC> > {
+        static const bool value = true;
+    };
+    template<class T, class ALLOC>
+    struct deferred_elementwise<scalar_vector<T, ALLOC> > {
+        static const bool value = true;
+    };
+    template<class E>
+    struct deferred_elementwise<vector_reference<E> > {
+        static const bool value = deferred_elementwise<E>::value;
+    };
+    template<class E, class F>
+    struct deferred_elementwise<vector_unary<E, F> > {
+        static const bool value = deferred_elementwise<E>::value;
+    };
+    template<class E1, class E2, class F>
+    struct deferred_elementwise<vector_binary<E1, E2, F> > {
+        static const bool value = deferred_elementwise<E1>::value && deferred_elementwise<E2>::value;
+    };
+    template<class E1, class E2, class F>
+    struct deferred_elementwise<vector_binary_scalar1<E1, E2, F> > {
+        static const bool value = deferred_elementwise<E2>::value;
+    };
+    template<class E1, class E2, class F>
+    struct deferred_elementwise<vector_binary_scalar2<E1, E2, F> > {
+        static const bool value = deferred_elementwise<E1>::value;
+    };
+    template<class T, class L, class A>
+    struct deferred_elementwise<matrix<T, L, A> > {
+        static const bool value = true;
+    };
+    template<class T, std::size_t M, std::size_t N, class L>
+    struct deferred_elementwise<bounded_matrix<T, M, N, L> > {
+        static const bool value = true;
+    };
+    template<class T, std::size_t M, std::size_t N>
+    struct deferred_elementwise<c_matrix<T, M, N> > {
+        static const bool value = true;
+    };
+    template<class T, class ALLOC>
+    struct deferred_elementwise<identity_matrix<T, ALLOC> > {
+        static const bool value = true;
+    };
+    template<class T, class ALLOC>
+    struct deferred_elementwise<zero_matrix<T, ALLOC> > {
+        static const bool value = true;
+    };
+    template<class T, class ALLOC>
+    struct deferred_elementwise<scalar_matrix<T, ALLOC> > {
+        static const bool value = true;
+    };
+    template<class E>
+    struct deferred_elementwise<matrix_reference<E> > {
+        static const bool value = deferred_elementwise<E>::value;
+    };
+    // Not matrix_unary2: trans () and herm () read the elements at transposed indices
+    template<class E, class F>
+    struct deferred_elementwise<matrix_unary1<E, F> > {
+        static const bool value = deferred_elementwise<E>::value;
+    };
+    template<class E1, class E2, class F>
+    struct deferred_elementwise<matrix_binary<E1, E2, F> > {
+        static const bool value = deferred_elementwise<E1>::value && deferred_elementwise<E2>::value;
+    };
+    template<class E1, class E2, class F>
+    struct deferred_elementwise<matrix_binary_scalar1<E1, E2, F> > {
+        static const bool value = deferred_elementwise<E2>::value;
+    };
+    template<class E1, class E2, class F>
+    struct deferred_elementwise<matrix_binary_scalar2<E1, E2, F> > {
+        static const bool value = deferred_elementwise<E1>::value;
+    };
+
+    // Empty list of statements
+    struct deferred_nil {
+        static const bool fusable = true;
+
+        template<class O>
+        struct oriented {
+            static const bool value = true;
+        };
+
+        template<class S>
+        bool same_size (S) const {
+            return true;
+        }
+        template<class S>
+        bool same_size (S, S) const {
+            return true;
+        }
+        template<class S>
+        void apply (S) const {}
+        template<class S>
+        void apply (S, S) const {}
+        void sequential () const {}
+    };
+
+    // The statement v F= e after the statements N
+    template<template <class T1, class T2> class F, class V, class E, class N>
+    class vector_deferred_statement {
+    public:
+        typedef typename E::const_closure_type expression_closure_type;
+        typedef typename V::size_type size_type;
+        typedef F<typename V::reference, typename E::value_type> functor_type;
+
+        static const bool fusable = boost::is_convertible<typename V::storage_category, dense_proxy_tag>::value &&
+                                    deferred_elementwise<V>::value && deferred_elementwise<E>::value && N::fusable;
+
+        BOOST_UBLAS_INLINE
+        vector_deferred_statement (V &v, const E &e, const N &next):
+            v_ (v), e_ (e), next_ (next) {}
+
+        BOOST_UBLAS_INLINE
+        size_type size () const {
+            return v_.size ();
+        }
+        BOOST_UBLAS_INLINE
+        bool same_size (size_type size) const {
+            return v_.size () == size && e_.size () == size && next_.same_size (size);
+        }
+
+        BOOST_UBLAS_INLINE
+        void apply (size_type i) const {
+            next_.apply (i);
+            functor_type::apply (v_ (i), e_ (i));
+        }
+        BOOST_UBLAS_INLINE
+        void sequential () const {
+            next_.sequential ();
+            vector_assign<F> (v_, e_);
+        }
+
+    private:
+        V &v_;
+        expression_closure_type e_;
+        N next_;
+    };
+
+    // The statement m F= e after the statements N
+    template<template <class T1, class T2> class F, class M, class E, class N>
+    class matrix_deferred_statement {
+    public:
+        typedef typename E::const_closure_type expression_closure_type;
+        typedef typename M::size_type size_type;
+        typedef typename M::orientation_category orientation_category;
+        typedef F<typename M::reference, typename E::value_type> functor_type;
+
+        static const bool fusable = boost::is_convertible<typename M::storage_category, dense_proxy_tag>::value &&
+                                    deferred_elementwise<M>::value && deferred_elementwise<E>::value && N::fusable;
+
+        template<class O>
+        struct oriented {
+            static const bool value = boost::is_same<O, orientation_category>::value && N::template oriented<O>::value;
+        };
+
+        BOOST_UBLAS_INLINE
+        matrix_deferred_statement (M &m, const E &e, const N &next):
+            m_ (m), e_ (e), next_ (next) {}
+
+        BOOST_UBLAS_INLINE
+        size_type size1 () const {
+            return m_.size1 ();
+        }
+        BOOST_UBLAS_INLINE
+        size_type size2 () const {
+            return m_.size2 ();
+        }
+        BOOST_UBLAS_INLINE
+        bool same_size (size_type size1, size_type size2) const {
+            return m_.size1 () == size1 && e_.size1 () == size1 &&
+                   m_.size2 () == size2 && e_.size2 () == size2 && next_.same_size (size1, size2);
+        }
+
+        BOOST_UBLAS_INLINE
+        void apply (size_type i, size_type j) const {
+            next_.apply (i, j);
+            functor_type::apply (m_ (i, j), e_ (i, j));
+        }
+        BOOST_UBLAS_INLINE
+        void sequential () const {
+            next_.sequential ();
+            matrix_assign<F> (m_, e_);
+        }
+
+    private:
+        M &m_;
+        expression_closure_type e_;
+        N next_;
+    };
+
+    // Fused traversals
+    template<class S>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void fused_matrix_assign (const S &s, row_major_tag) {
+        typedef typename S::size_type size_type;
+        size_type size1 (s.size1 ()), size2 (s.size2 ());
+        for (size_type i = 0; i < size1; ++ i)
+            for (size_type j = 0; j < size2; ++ j)
+                s.apply (i, j);
+    }
+    template<class S>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void fused_matrix_assign (const S &s, column_major_tag) {
+        typedef typename S::size_type size_type;
+        size_type size1 (s.size1 ()), size2 (s.size2 ());
+        for (size_type j = 0; j < size2; ++ j)
+            for (size_type i = 0; i < size1; ++ i)
+                s.apply (i, j);
+    }
+    template<class S>
+    BOOST_UBLAS_INLINE
+    void fused_matrix_assign (const S &s, unknown_orientation_tag) {
+        fused_matrix_assign (s, row_major_tag ());
+    }
+
+}//namespace detail
+
+    // Statements on vectors recorded for a deferred evaluation
+    template<class S>
+    class vector_deferred_assign {
+    public:
+        BOOST_UBLAS_INLINE
+        explicit vector_deferred_assign (const S &s = S ()):
+            s_ (s) {}
+
+        template<class V, class E>
+        BOOST_UBLAS_INLINE
+        vector_deferred_assign<detail::vector_deferred_statement<scalar_assign, V, E, S> >
+        assign (V &v, const vector_expression<E> &e) const {
+            return vector_deferred_assign<detail::vector_deferred_statement<scalar_assign, V, E, S> > (
+                       detail::vector_deferred_statement<scalar_assign, V, E, S> (v, e (), s_));
+        }
+        template<class V, class E>
+        BOOST_UBLAS_INLINE
+        vector_deferred_assign<detail::vector_deferred_statement<scalar_plus_assign, V, E, S> >
+        plus_assign (V &v, const vector_expression<E> &e) const {
+            return vector_deferred_assign<detail::vector_deferred_statement<scalar_plus_assign, V, E, S> > (
+                       detail::vector_deferred_statement<scalar_plus_assign, V, E, S> (v, e (), s_));
+        }
+        template<class V, class E>
+        BOOST_UBLAS_INLINE
+        vector_deferred_assign<detail::vector_deferred_statement<scalar_minus_assign, V, E, S> >
+        minus_assign (V &v, const vector_expression<E> &e) const {
+            return vector_deferred_assign<detail::vector_deferred_statement<scalar_minus_assign, V, E, S> > (
+                       detail::vector_deferred_statement<scalar_minus_assign, V, E, S> (v, e (), s_));
+        }
+
+        // Evaluate the statements, in a single traversal if possible; true if they
+        // have been fused
+        // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+        bool evaluate () const {
+            typedef typename S::size_type size_type;
+            if (! S::fusable || ! s_.same_size (s_.size ())) {
+                s_.sequential ();
+                return false;
+            }
+            size_type size (s_.size ());
+            for (size_type i = 0; i < size; ++ i)
+                s_.apply (i);
+            return true;
+        }
+
+    private:
+        S s_;
+    };
+
+    // Statements on matrices recorded for a deferred evaluation
+    template<class S>
+    class matrix_deferred_assign {
+    public:
+        BOOST_UBLAS_INLINE
+        explicit matrix_deferred_assign (const S &s = S ()):
+            s_ (s) {}
+
+        template<class M, class E>
+        BOOST_UBLAS_INLINE
+        matrix_deferred_assign<detail::matrix_deferred_statement<scalar_assign, M, E, S> >
+        assign (M &m, const matrix_expression<E> &e) const {
+            return matrix_deferred_assign<detail::matrix_deferred_statement<scalar_assign, M, E, S> > (
+                       detail::matrix_deferred_statement<scalar_assign, M, E, S> (m, e (), s_));
+        }
+        template<class M, class E>
+        BOOST_UBLAS_INLINE
+        matrix_deferred_assign<detail::matrix_deferred_statement<scalar_plus_assign, M, E, S> >
+        plus_assign (M &m, const matrix_expression<E> &e) const {
+            return matrix_deferred_assign<detail::matrix_deferred_statement<scalar_plus_assign, M, E, S> > (
+                       detail::matrix_deferred_statement<scalar_plus_assign, M, E, S> (m, e (), s_));
+        }
+        template<class M, class E>
+        BOOST_UBLAS_INLINE
+        matrix_deferred_assign<detail::matrix_deferred_statement<scalar_minus_assign, M, E, S> >
+        minus_assign (M &m, const matrix_expression<E> &e) const {
+            return matrix_deferred_assign<detail::matrix_deferred_statement<scalar_minus_assign, M, E, S> > (
+                       detail::matrix_deferred_statement<scalar_minus_assign, M, E, S> (m, e (), s_));
+        }
+
+        // Evaluate the statements, in a single traversal in the orientation of the
+        // destinations if possible; true if they have been fused
+        // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+        bool evaluate () const {
+            typedef typename S::orientation_category orientation_category;
+            if (! S::fusable || ! S::template oriented<orientation_category>::value ||
+                ! s_.same_size (s_.size1 (), s_.size2 ())) {
+                s_.sequential ();
+                return false;
+            }
+            detail::fused_matrix_assign (s_, orientation_category ());
+            return true;
+        }
+
+    private:
+        S s_;
+    };
+
+    inline
+    vector_deferred_assign<detail::deferred_nil> deferred_vector_assign () {
+        return vector_deferred_assign<detail::deferred_nil> ();
+    }
+    inline
+    matrix_deferred_assign<detail::deferred_nil> deferred_matrix_assign () {
+        return matrix_deferred_assign<detail::deferred_nil> ();
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,190 @@
+//
+//  Copyright (c) 2000-2010
+//  Joerg Walter, Mathias Koch, Gunter Winkler
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+//  The authors gratefully acknowledge the support of
+//  GeNeSys mbH & Co. KG in producing this work.
+//
+
+#ifndef _BOOST_UBLAS_ASSIGN_STATISTICS_
+#define _BOOST_UBLAS_ASSIGN_STATISTICS_
+
+#include <boost/numeric/ublas/detail/config.hpp>
+#include <cstddef>
+#include <ctime>
+#include <ostream>
+#include <time.h>
+
+// Per thread statistics of the paths taken by vector_assign, matrix_assign and
+// make_conformant. Only collected with BOOST_UBLAS_ASSIGN_STATISTICS.
+#if defined (__GNUC__)
+#define BOOST_UBLAS_THREAD_LOCAL __thread
+#else
+// No thread local storage: the statistics are shared by all threads
+#define BOOST_UBLAS_THREAD_LOCAL
+#endif
+
+// Clock of the times: the processor time of the calling thread where POSIX has it,
+// the elapsed (wall) time otherwise, and the processor time of the whole process
+// (std::clock ()) without clock_gettime ()
+#if defined (CLOCK_THREAD_CPUTIME_ID)
+#define BOOST_UBLAS_ASSIGN_STATISTICS_CLOCK CLOCK_THREAD_CPUTIME_ID
+#elif defined (CLOCK_MONOTONIC)
+#define BOOST_UBLAS_ASSIGN_STATISTICS_CLOCK CLOCK_MONOTONIC
+#endif
+
+namespace boost { namespace numeric { namespace ublas {
+
+    enum assign_path {
+        assign_path_vector_assign_scalar_dense_proxy,
+        assign_path_vector_assign_scalar_packed_proxy,
+        assign_path_vector_assign_scalar_sparse_proxy,
+        assign_path_vector_assign_dense_proxy,
+        assign_path_vector_assign_packed_proxy,
+        assign_path_vector_assign_sparse,
+        assign_path_vector_assign_sparse_proxy,
+        assign_path_vector_make_conformant,
+        assign_path_matrix_assign_scalar_dense_proxy,
+        assign_path_matrix_assign_scalar_packed_proxy_row_major,
+        assign_path_matrix_assign_scalar_packed_proxy_column_major,
+        assign_path_matrix_assign_scalar_sparse_proxy_row_major,
+        assign_path_matrix_assign_scalar_sparse_proxy_column_major,
+        assign_path_matrix_assign_dense_proxy,
+        assign_path_matrix_assign_packed_proxy_row_major,
+        assign_path_matrix_assign_packed_proxy_column_major,
+        assign_path_matrix_assign_sparse_row_major,
+        assign_path_matrix_assign_sparse_column_major,
+        assign_path_matrix_assign_sparse_proxy_row_major,
+        assign_path_matrix_assign_sparse_proxy_column_major,
+        assign_path_matrix_make_conformant_row_major,
+        assign_path_matrix_make_conformant_column_major,
+        assign_path_matrix_make_conformant_compressed,
+        assign_path_matrix_make_conformant_mapped,
+        assign_path_count
+    };
+
+    inline
+    const char *assign_path_name (assign_path path) {
+        static const char *names [assign_path_count] = {
+            "vector_assign_scalar<dense_proxy>",
+            "vector_assign_scalar<packed_proxy>",
+            "vector_assign_scalar<sparse_proxy>",
+            "vector_assign<dense_proxy>",
+            "vector_assign<packed_proxy>",
+            "vector_assign<sparse>",
+            "vector_assign<sparse_proxy>",
+            "make_conformant<vector>",
+            "matrix_assign_scalar<dense_proxy>",
+            "matrix_assign_scalar<packed_proxy, row_major>",
+            "matrix_assign_scalar<packed_proxy, column_major>",
+            "matrix_assign_scalar<sparse_proxy, row_major>",
+            "matrix_assign_scalar<sparse_proxy, column_major>",
+            "matrix_assign<dense_proxy>",
+            "matrix_assign<packed_proxy, row_major>",
+            "matrix_assign<packed_proxy, column_major>",
+            "matrix_assign<sparse, row_major>",
+            "matrix_assign<sparse, column_major>",
+            "matrix_assign<sparse_proxy, row_major>",
+            "matrix_assign<sparse_proxy, column_major>",
+            "make_conformant<matrix, row_major>",
+            "make_conformant<matrix, column_major>",
+            "make_conformant<compressed_matrix>",
+            "make_conformant<mapped_matrix>"
+        };
+        return names [path];
+    }
+
+    // Calls of one path, the elements of their targets and the time spent in them,
+    // including the time of the nested paths (make_conformant)
+    struct assign_path_statistics {
+        unsigned long calls;
+        unsigned long elements;
+        double seconds;
+    };
+
+namespace detail {
+
+    template<class Dummy>
+    struct assign_statistics_registry {
+        static BOOST_UBLAS_THREAD_LOCAL assign_path_statistics paths [assign_path_count] [2];
+    };
+    template<class Dummy>
+    BOOST_UBLAS_THREAD_LOCAL assign_path_statistics assign_statistics_registry<Dummy>::paths [assign_path_count] [2];
+
+    // Seconds of the clock of the statistics
+    inline
+    double assign_statistics_seconds () {
+#ifdef BOOST_UBLAS_ASSIGN_STATISTICS_CLOCK
+        timespec t;
+        if (clock_gettime (BOOST_UBLAS_ASSIGN_STATISTICS_CLOCK, &t) != 0)
+            return 0.;
+        return double (t.tv_sec) + double (t.tv_nsec) * 1e-9;
+#else
+        return double (std::clock ()) / CLOCKS_PER_SEC;
+#endif
+    }
+
+    // Records one call of a path from its construction to its destruction
+    class assign_path_scope {
+    public:
+        BOOST_UBLAS_INLINE
+        assign_path_scope (assign_path path, bool computed, std::size_t elements):
+            statistics_ (assign_statistics_registry<bool>::paths [path] [computed]), start_ (assign_statistics_seconds ()) {
+            ++ statistics_.calls;
+            statistics_.elements += elements;
+        }
+        BOOST_UBLAS_INLINE
+        ~assign_path_scope () {
+            statistics_.seconds += assign_statistics_seconds () - start_;
+        }
+    private:
+        assign_path_statistics &statistics_;
+        double start_;
+    };
+
+}//namespace detail
+
+    // Statistics of the calling thread
+    inline
+    assign_path_statistics &assign_statistics (assign_path path, bool computed) {
+        return detail::assign_statistics_registry<bool>::paths [path] [computed];
+    }
+
+    inline
+    void reset_assign_statistics () {
+        for (int path = 0; path < assign_path_count; ++ path)
+            for (int computed = 0; computed < 2; ++ computed) {
+                assign_path_statistics &statistics = assign_statistics (assign_path (path), computed != 0);
+                statistics.calls = 0;
+                statistics.elements = 0;
+                statistics.seconds = 0.;
+            }
+    }
+
+    // One line for each path taken by the calling thread
+    inline
+    void dump_assign_statistics (std::ostream &os) {
+        for (int path = 0; path < assign_path_count; ++ path)
+            for (int computed = 0; computed < 2; ++ computed) {
+                const assign_path_statistics &statistics = assign_statistics (assign_path (path), computed != 0);
+                if (statistics.calls != 0)
+                    os << assign_path_name (assign_path (path)) << (computed ? " computed" : "")
+                       << ": " << statistics.calls << " calls, " << statistics.elements << " elements, "
+                       << statistics.seconds << " s" << std::endl;
+            }
+    }
+
+}}}
+
+#ifdef BOOST_UBLAS_ASSIGN_STATISTICS
+#define BOOST_UBLAS_ASSIGN_PATH(PATH, COMPUTED, ELEMENTS) \
+    detail::assign_path_scope assign_path_scope_ (PATH, COMPUTED, ELEMENTS)
+#else
+#define BOOST_UBLAS_ASSIGN_PATH(PATH, COMPUTED, ELEMENTS)
+#endif
+
+#endif
@@ -0,0 +1,646 @@
+//
+//  Copyright (c) 2000-2010
+//  Joerg Walter, Mathias Koch, Gunter Winkler
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+//  The authors gratefully acknowledge the support of
+//  GeNeSys mbH & Co. KG in producing this work.
+//
+
+#ifndef _BOOST_UBLAS_CBLAS_
+#define _BOOST_UBLAS_CBLAS_
+
+#ifdef BOOST_UBLAS_CBLAS
+
+#include <boost/numeric/ublas/vector_expression.hpp>
+#include <boost/numeric/ublas/matrix_expression.hpp>
+#include <boost/numeric/ublas/operation/size.hpp>
+#include <boost/numeric/ublas/detail/simd_assign.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <cblas.h>
+
+// Products, inner products and triangular solves of dense vectors and matrices of
+// float, double and their complex types with contiguous storage computed by the CBLAS
+// linked with the program: the assignments of prod (a, b) and prod (a, x) (gemm and
+// gemv), axpy_prod (), inner_prod () (dot) and inplace_solve () and solve () with a
+// triangular tag (trsv and trsm). A matrix is passed in its own orientation with the
+// leading dimension of its container, size<tag::leading> (); a product or a solve
+// with operands of different orientations transposes the ones which differ from the
+// result. Anything else, and the smaller operations, keep the generic loops.
+
+namespace boost { namespace numeric { namespace ublas {
+namespace detail {
+
+    // Value types of the CBLAS routines
+    template<class T>
+    struct cblas_value {
+        static const bool value = false;
+    };
+    template<>
+    struct cblas_value<float> {
+        static const bool value = true;
+    };
+    template<>
+    struct cblas_value<double> {
+        static const bool value = true;
+    };
+    template<>
+    struct cblas_value<std::complex<float> > {
+        static const bool value = true;
+    };
+    template<>
+    struct cblas_value<std::complex<double> > {
+        static const bool value = true;
+    };
+
+    // Elements of a dense matrix with contiguous storage: element (i, j) at
+    // data [i * ld + j] in row major order, at data [i + j * ld] otherwise
+    template<class P>
+    struct cblas_matrix {
+        P *data;
+        int size1, size2, ld;
+        bool row_major;
+    };
+
+    // Elements of a dense vector with contiguous storage
+    template<class P>
+    struct cblas_vector {
+        P *data;
+        int size;
+    };
+
+    // True if the CBLAS routines can be passed size
+    inline bool cblas_size (std::size_t size) {
+        return size <= std::size_t ((std::numeric_limits<int>::max) ());
+    }
+
+    template<class P, class T, class L, class A>
+    BOOST_UBLAS_INLINE
+    bool cblas_matrix_view (P *data, const matrix<T, L, A> &m,
+                            std::size_t start1, std::size_t start2, std::size_t size1, std::size_t size2,
+                            cblas_matrix<P> &v) {
+        // At least 1, even without elements
+        std::size_t ld ((std::max) (boost::numeric::ublas::size<tag::leading> (m), std::size_t (1)));
+        if (! data || ! cblas_size (ld) || ! cblas_size (size1) || ! cblas_size (size2))
+            return false;
+        v.row_major = boost::is_same<typename L::orientation_category, row_major_tag>::value;
+        v.data = data + (v.row_major ? start1 * ld + start2 : start1 + start2 * ld);
+        v.size1 = int (size1);
+        v.size2 = int (size2);
+        v.ld = int (ld);
+        return true;
+    }
+
+    template<class P>
+    BOOST_UBLAS_INLINE
+    bool cblas_vector_view (P *data, std::size_t start, std::size_t size, cblas_vector<P> &v) {
+        if (! data || ! cblas_size (size))
+            return false;
+        v.data = data + start;
+        v.size = int (size);
+        return true;
+    }
+
+    // Other expressions
+    template<class E, class P>
+    BOOST_UBLAS_INLINE
+    bool cblas_data (const E &, cblas_matrix<P> &) {
+        return false;
+    }
+    template<class E, class P>
+    BOOST_UBLAS_INLINE
+    bool cblas_data (const E &, cblas_vector<P> &) {
+        return false;
+    }
+    // Operands, held by reference in the expressions
+    template<class E, class P>
+    BOOST_UBLAS_INLINE
+    bool cblas_data (const matrix_reference<E> &m, cblas_matrix<P> &v) {
+        return cblas_data (m.expression (), v);
+    }
+    template<class E, class P>
+    BOOST_UBLAS_INLINE
+    bool cblas_data (const vector_reference<E> &u, cblas_vector<P> &v) {
+        return cblas_data (u.expression (), v);
+    }
+    // Operands
+    template<class T, class L, class A>
+    BOOST_UBLAS_INLINE
+    bool cblas_data (const matrix<T, L, A> &m, cblas_matrix<const T> &v) {
+        return cblas_matrix_view (simd_data (m.data ()), m, 0, 0, m.size1 (), m.size2 (), v);
+    }
+    template<class T, class L, class A>
+    BOOST_UBLAS_INLINE
+    bool cblas_data (const matrix_range<matrix<T, L, A> > &m, cblas_matrix<const T> &v) {
+        const matrix<T, L, A> &e = m.data ().expression ();
+        return cblas_matrix_view (simd_data (e.data ()), e, m.start1 (), m.start2 (), m.size1 (), m.size2 (), v);
+    }
+    template<class T, class L, class A>
+    BOOST_UBLAS_INLINE
+    bool cblas_data (const matrix_range<const matrix<T, L, A> > &m, cblas_matrix<const T> &v) {
+        const matrix<T, L, A> &e = m.data ().expression ();
+        return cblas_matrix_view (simd_data (e.data ()), e, m.start1 (), m.start2 (), m.size1 (), m.size2 (), v);
+    }
+    template<class T, class A>
+    BOOST_UBLAS_INLINE
+    bool cblas_data (const vector<T, A> &u, cblas_vector<const T> &v) {
+        return cblas_vector_view (simd_data (u.data ()), 0, u.size (), v);
+    }
+    template<class T, class A>
+    BOOST_UBLAS_INLINE
+    bool cblas_data (const vector_range<vector<T, A> > &u, cblas_vector<const T> &v) {
+        return cblas_vector_view (simd_data (u.data ().expression ().data ()), u.start (), u.size (), v);
+    }
+    template<class T, class A>
+    BOOST_UBLAS_INLINE
+    bool cblas_data (const vector_range<const vector<T, A> > &u, cblas_vector<const T> &v) {
+        return cblas_vector_view (simd_data (u.data ().expression ().data ()), u.start (), u.size (), v);
+    }
+    // Results
+    template<class T, class L, class A>
+    BOOST_UBLAS_INLINE
+    bool cblas_data (matrix<T, L, A> &m, cblas_matrix<T> &v) {
+        return cblas_matrix_view (simd_data (m.data ()), m, 0, 0, m.size1 (), m.size2 (), v);
+    }
+    template<class T, class L, class A>
+    BOOST_UBLAS_INLINE
+    bool cblas_data (matrix_range<matrix<T, L, A> > &m, cblas_matrix<T> &v) {
+        matrix<T, L, A> &e = m.data ().expression ();
+        return cblas_matrix_view (simd_data (e.data ()), e, m.start1 (), m.start2 (), m.size1 (), m.size2 (), v);
+    }
+    template<class T, class A>
+    BOOST_UBLAS_INLINE
+    bool cblas_data (vector<T, A> &u, cblas_vector<T> &v) {
+        return cblas_vector_view (simd_data (u.data ()), 0, u.size (), v);
+    }
+    template<class T, class A>
+    BOOST_UBLAS_INLINE
+    bool cblas_data (vector_range<vector<T, A> > &u, cblas_vector<T> &v) {
+        return cblas_vector_view (simd_data (u.data ().expression ().data ()), u.start (), u.size (), v);
+    }
+
+    // Storage spanned by the elements
+    template<class P>
+    BOOST_UBLAS_INLINE
+    P *cblas_end (const cblas_matrix<P> &m) {
+        if (m.size1 == 0 || m.size2 == 0)
+            return m.data;
+        return m.row_major ? m.data + std::ptrdiff_t (m.size1 - 1) * m.ld + m.size2 :
+                             m.data + std::ptrdiff_t (m.size2 - 1) * m.ld + m.size1;
+    }
+    template<class P>
+    BOOST_UBLAS_INLINE
+    P *cblas_end (const cblas_vector<P> &v) {
+        return v.data + v.size;
+    }
+
+    // True if the elements of the result may share storage with those of an operand
+    template<class R, class O>
+    BOOST_UBLAS_INLINE
+    bool cblas_overlap (const R &r, const O &o) {
+        const void *r_begin = r.data, *r_end = cblas_end (r);
+        const void *o_begin = o.data, *o_end = cblas_end (o);
+        std::less<const void *> less;
+        return less (r_begin, o_end) && less (o_begin, r_end);
+    }
+
+    inline CBLAS_ORDER cblas_order (bool row_major) {
+        return row_major ? CblasRowMajor : CblasColMajor;
+    }
+
+    // c = alpha * op (a) * op (b) + beta * c
+    inline void cblas_gemm (CBLAS_ORDER order, CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b, int m, int n, int k,
+                     float alpha, const float *a, int lda, const float *b, int ldb, float beta, float *c, int ldc) {
+        cblas_sgemm (order, trans_a, trans_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    }
+    inline void cblas_gemm (CBLAS_ORDER order, CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b, int m, int n, int k,
+                     double alpha, const double *a, int lda, const double *b, int ldb, double beta, double *c, int ldc) {
+        cblas_dgemm (order, trans_a, trans_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    }
+    inline void cblas_gemm (CBLAS_ORDER order, CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b, int m, int n, int k,
+                     std::complex<float> alpha, const std::complex<float> *a, int lda, const std::complex<float> *b, int ldb,
+                     std::complex<float> beta, std::complex<float> *c, int ldc) {
+        cblas_cgemm (order, trans_a, trans_b, m, n, k, &alpha, a, lda, b, ldb, &beta, c, ldc);
+    }
+    inline void cblas_gemm (CBLAS_ORDER order, CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b, int m, int n, int k,
+                     std::complex<double> alpha, const std::complex<double> *a, int lda, const std::complex<double> *b, int ldb,
+                     std::complex<double> beta, std::complex<double> *c, int ldc) {
+        cblas_zgemm (order, trans_a, trans_b, m, n, k, &alpha, a, lda, b, ldb, &beta, c, ldc);
+    }
+
+    // y = alpha * op (a) * x + beta * y
+    inline void cblas_gemv (CBLAS_ORDER order, CBLAS_TRANSPOSE trans, int m, int n,
+                     float alpha, const float *a, int lda, const float *x, float beta, float *y) {
+        cblas_sgemv (order, trans, m, n, alpha, a, lda, x, 1, beta, y, 1);
+    }
+    inline void cblas_gemv (CBLAS_ORDER order, CBLAS_TRANSPOSE trans, int m, int n,
+                     double alpha, const double *a, int lda, const double *x, double beta, double *y) {
+        cblas_dgemv (order, trans, m, n, alpha, a, lda, x, 1, beta, y, 1);
+    }
+    inline void cblas_gemv (CBLAS_ORDER order, CBLAS_TRANSPOSE trans, int m, int n,
+                     std::complex<float> alpha, const std::complex<float> *a, int lda, const std::complex<float> *x,
+                     std::complex<float> beta, std::complex<float> *y) {
+        cblas_cgemv (order, trans, m, n, &alpha, a, lda, x, 1, &beta, y, 1);
+    }
+    inline void cblas_gemv (CBLAS_ORDER order, CBLAS_TRANSPOSE trans, int m, int n,
+                     std::complex<double> alpha, const std::complex<double> *a, int lda, const std::complex<double> *x,
+                     std::complex<double> beta, std::complex<double> *y) {
+        cblas_zgemv (order, trans, m, n, &alpha, a, lda, x, 1, &beta, y, 1);
+    }
+
+    // x^T * y, without conjugation
+    inline float cblas_dot (int n, const float *x, const float *y) {
+        return cblas_sdot (n, x, 1, y, 1);
+    }
+    inline double cblas_dot (int n, const double *x, const double *y) {
+        return cblas_ddot (n, x, 1, y, 1);
+    }
+    inline std::complex<float> cblas_dot (int n, const std::complex<float> *x, const std::complex<float> *y) {
+        std::complex<float> t;
+        cblas_cdotu_sub (n, x, 1, y, 1, &t);
+        return t;
+    }
+    inline std::complex<double> cblas_dot (int n, const std::complex<double> *x, const std::complex<double> *y) {
+        std::complex<double> t;
+        cblas_zdotu_sub (n, x, 1, y, 1, &t);
+        return t;
+    }
+
+    // x = op (a)^-1 * x
+    inline void cblas_trsv (CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_TRANSPOSE trans, CBLAS_DIAG diag, int n,
+                     const float *a, int lda, float *x) {
+        cblas_strsv (order, uplo, trans, diag, n, a, lda, x, 1);
+    }
+    inline void cblas_trsv (CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_TRANSPOSE trans, CBLAS_DIAG diag, int n,
+                     const double *a, int lda, double *x) {
+        cblas_dtrsv (order, uplo, trans, diag, n, a, lda, x, 1);
+    }
+    inline void cblas_trsv (CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_TRANSPOSE trans, CBLAS_DIAG diag, int n,
+                     const std::complex<float> *a, int lda, std::complex<float> *x) {
+        cblas_ctrsv (order, uplo, trans, diag, n, a, lda, x, 1);
+    }
+    inline void cblas_trsv (CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_TRANSPOSE trans, CBLAS_DIAG diag, int n,
+                     const std::complex<double> *a, int lda, std::complex<double> *x) {
+        cblas_ztrsv (order, uplo, trans, diag, n, a, lda, x, 1);
+    }
+
+    // b = op (a)^-1 * b
+    inline void cblas_trsm (CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_TRANSPOSE trans, CBLAS_DIAG diag, int m, int n,
+                     const float *a, int lda, float *b, int ldb) {
+        cblas_strsm (order, CblasLeft, uplo, trans, diag, m, n, 1.f, a, lda, b, ldb);
+    }
+    inline void cblas_trsm (CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_TRANSPOSE trans, CBLAS_DIAG diag, int m, int n,
+                     const double *a, int lda, double *b, int ldb) {
+        cblas_dtrsm (order, CblasLeft, uplo, trans, diag, m, n, 1., a, lda, b, ldb);
+    }
+    inline void cblas_trsm (CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_TRANSPOSE trans, CBLAS_DIAG diag, int m, int n,
+                     const std::complex<float> *a, int lda, std::complex<float> *b, int ldb) {
+        std::complex<float> one (1);
+        cblas_ctrsm (order, CblasLeft, uplo, trans, diag, m, n, &one, a, lda, b, ldb);
+    }
+    inline void cblas_trsm (CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_TRANSPOSE trans, CBLAS_DIAG diag, int m, int n,
+                     const std::complex<double> *a, int lda, std::complex<double> *b, int ldb) {
+        std::complex<double> one (1);
+        cblas_ztrsm (order, CblasLeft, uplo, trans, diag, m, n, &one, a, lda, b, ldb);
+    }
+
+    // alpha and beta of r OP= t as r = alpha * t + beta * r
+    template<class T>
+    BOOST_UBLAS_INLINE
+    T cblas_alpha (int op) {
+        return op == simd_op_minus ? T (-1) : T (1);
+    }
+    template<class T>
+    BOOST_UBLAS_INLINE
+    T cblas_beta (int op) {
+        return op == simd_op_assign ? T (0) : T (1);
+    }
+
+    // m F= e with gemm if e is the product of dense matrices with contiguous storage
+    // of a supported value type, m is one too and shares no storage with them; false
+    // otherwise
+    template<template <class T1, class T2> class F, class M, class E>
+    BOOST_UBLAS_INLINE
+    bool cblas_matrix_assign (M &, const E &) {
+        return false;
+    }
+    template<template <class T1, class T2> class F, class M, class E1, class E2, class T>
+    BOOST_UBLAS_INLINE
+    bool cblas_matrix_assign (M &, const matrix_matrix_binary<E1, E2, matrix_matrix_prod<E1, E2, T> > &, boost::mpl::false_) {
+        return false;
+    }
+    template<template <class T1, class T2> class F, class M, class E1, class E2, class T>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    bool cblas_matrix_assign (M &m, const matrix_matrix_binary<E1, E2, matrix_matrix_prod<E1, E2, T> > &e, boost::mpl::true_) {
+        const int op = simd_op<F>::value;
+        if (op != simd_op_assign && op != simd_op_plus && op != simd_op_minus)
+            return false;
+        cblas_matrix<T> c;
+        cblas_matrix<const T> a, b;
+        if (! cblas_data (m, c) || ! cblas_data (e.expression1 (), a) || ! cblas_data (e.expression2 (), b))
+            return false;
+        BOOST_UBLAS_CHECK (c.size1 == a.size1 && c.size2 == b.size2 && a.size2 == b.size1, bad_size ());
+        if (std::size_t (c.size1) * std::size_t (c.size2) * std::size_t (a.size2) < BOOST_UBLAS_CBLAS_THRESHOLD)
+            return false;
+        if (cblas_overlap (c, a) || cblas_overlap (c, b))
+            return false;
+        cblas_gemm (cblas_order (c.row_major),
+                    a.row_major == c.row_major ? CblasNoTrans : CblasTrans,
+                    b.row_major == c.row_major ? CblasNoTrans : CblasTrans,
+                    c.size1, c.size2, a.size2,
+                    cblas_alpha<T> (op), a.data, a.ld, b.data, b.ld, cblas_beta<T> (op), c.data, c.ld);
+        return true;
+    }
+    template<template <class T1, class T2> class F, class M, class E1, class E2, class T>
+    BOOST_UBLAS_INLINE
+    bool cblas_matrix_assign (M &m, const matrix_matrix_binary<E1, E2, matrix_matrix_prod<E1, E2, T> > &e) {
+        typedef typename M::value_type value_type;
+        return cblas_matrix_assign<F> (m, e, boost::mpl::bool_<cblas_value<value_type>::value &&
+                                                               boost::is_same<value_type, T>::value> ());
+    }
+
+    // v F= e with gemv if e is the product of a dense matrix and a dense vector with
+    // contiguous storage of a supported value type, v is one too and shares no
+    // storage with them; false otherwise
+    template<class T, class V, class EM, class EV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    bool cblas_gemv_assign (int op, V &v, const EM &em, const EV &ev, bool trans) {
+        if (op != simd_op_assign && op != simd_op_plus && op != simd_op_minus)
+            return false;
+        cblas_vector<T> y;
+        cblas_matrix<const T> a;
+        cblas_vector<const T> x;
+        if (! cblas_data (v, y) || ! cblas_data (em, a) || ! cblas_data (ev, x))
+            return false;
+        BOOST_UBLAS_CHECK (y.size == (trans ? a.size2 : a.size1) && x.size == (trans ? a.size1 : a.size2), bad_size ());
+        if (std::size_t (a.size1) * std::size_t (a.size2) < BOOST_UBLAS_CBLAS_THRESHOLD)
+            return false;
+        if (cblas_overlap (y, a) || cblas_overlap (y, x))
+            return false;
+        cblas_gemv (cblas_order (a.row_major), trans ? CblasTrans : CblasNoTrans, a.size1, a.size2,
+                    cblas_alpha<T> (op), a.data, a.ld, x.data, cblas_beta<T> (op), y.data);
+        return true;
+    }
+    template<template <class T1, class T2> class F, class V, class E>
+    BOOST_UBLAS_INLINE
+    bool cblas_vector_assign (V &, const E &) {
+        return false;
+    }
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class T>
+    BOOST_UBLAS_INLINE
+    bool cblas_vector_assign (V &, const matrix_vector_binary1<E1, E2, matrix_vector_prod1<E1, E2, T> > &, boost::mpl::false_) {
+        return false;
+    }
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class T>
+    BOOST_UBLAS_INLINE
+    bool cblas_vector_assign (V &v, const matrix_vector_binary1<E1, E2, matrix_vector_prod1<E1, E2, T> > &e, boost::mpl::true_) {
+        return cblas_gemv_assign<T> (simd_op<F>::value, v, e.expression1 (), e.expression2 (), false);
+    }
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class T>
+    BOOST_UBLAS_INLINE
+    bool cblas_vector_assign (V &v, const matrix_vector_binary1<E1, E2, matrix_vector_prod1<E1, E2, T> > &e) {
+        typedef typename V::value_type value_type;
+        return cblas_vector_assign<F> (v, e, boost::mpl::bool_<cblas_value<value_type>::value &&
+                                                               boost::is_same<value_type, T>::value> ());
+    }
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class T>
+    BOOST_UBLAS_INLINE
+    bool cblas_vector_assign (V &, const matrix_vector_binary2<E1, E2, matrix_vector_prod2<E1, E2, T> > &, boost::mpl::false_) {
+        return false;
+    }
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class T>
+    BOOST_UBLAS_INLINE
+    bool cblas_vector_assign (V &v, const matrix_vector_binary2<E1, E2, matrix_vector_prod2<E1, E2, T> > &e, boost::mpl::true_) {
+        return cblas_gemv_assign<T> (simd_op<F>::value, v, e.expression2 (), e.expression1 (), true);
+    }
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class T>
+    BOOST_UBLAS_INLINE
+    bool cblas_vector_assign (V &v, const matrix_vector_binary2<E1, E2, matrix_vector_prod2<E1, E2, T> > &e) {
+        typedef typename V::value_type value_type;
+        return cblas_vector_assign<F> (v, e, boost::mpl::bool_<cblas_value<value_type>::value &&
+                                                               boost::is_same<value_type, T>::value> ());
+    }
+
+    // t = inner_prod (u, v) with dot if both have a supported value type; false otherwise
+    template<class T, class A1, class A2>
+    BOOST_UBLAS_INLINE
+    bool cblas_inner_prod (const vector<T, A1> &, const vector<T, A2> &, T &, boost::mpl::false_) {
+        return false;
+    }
+    template<class T, class A1, class A2>
+    BOOST_UBLAS_INLINE
+    bool cblas_inner_prod (const vector<T, A1> &u, const vector<T, A2> &v, T &t, boost::mpl::true_) {
+        cblas_vector<const T> x, y;
+        if (! cblas_data (u, x) || ! cblas_data (v, y))
+            return false;
+        BOOST_UBLAS_CHECK (x.size == y.size, bad_size ());
+        if (std::size_t (x.size) < BOOST_UBLAS_CBLAS_THRESHOLD)
+            return false;
+        t = cblas_dot (x.size, x.data, y.data);
+        return true;
+    }
+    template<class T, class A1, class A2>
+    BOOST_UBLAS_INLINE
+    bool cblas_inner_prod (const vector<T, A1> &u, const vector<T, A2> &v, T &t) {
+        return cblas_inner_prod (u, v, t, boost::mpl::bool_<cblas_value<T>::value> ());
+    }
+
+    // Triangle and diagonal of the triangular tags
+    template<class C>
+    struct cblas_triangular;
+    template<>
+    struct cblas_triangular<lower_tag> {
+        static const bool lower = true;
+        static const bool unit = false;
+    };
+    template<>
+    struct cblas_triangular<upper_tag> {
+        static const bool lower = false;
+        static const bool unit = false;
+    };
+    template<>
+    struct cblas_triangular<unit_lower_tag> {
+        static const bool lower = true;
+        static const bool unit = true;
+    };
+    template<>
+    struct cblas_triangular<unit_upper_tag> {
+        static const bool lower = false;
+        static const bool unit = true;
+    };
+
+    // Triangle of a in the order of the solve: a matrix of the other orientation is
+    // passed transposed, its lower triangle as an upper one
+    template<class T>
+    BOOST_UBLAS_INLINE
+    CBLAS_UPLO cblas_uplo (const cblas_matrix<const T> &a, bool row_major, bool lower) {
+        return (a.row_major == row_major) == lower ? CblasLower : CblasUpper;
+    }
+
+    // trsv and trsm do not look for zeros on the diagonal: check it as the generic
+    // solves do (see BOOST_UBLAS_SINGULAR_CHECK) before handing them a non unit system
+    template<class C, class T, class L1, class A1>
+    BOOST_UBLAS_INLINE
+    void cblas_check_singular (const matrix<T, L1, A1> &e1) {
+        if (cblas_triangular<C>::unit)
+            return;
+        typedef typename matrix<T, L1, A1>::size_type size_type;
+        size_type size (e1.size1 ());
+        for (size_type n = 0; n < size; ++ n) {
+#ifndef BOOST_UBLAS_SINGULAR_CHECK
+            BOOST_UBLAS_CHECK (e1 (n, n) != T/*zero*/(), singular ());
+#else
+            if (e1 (n, n) == T/*zero*/())
+                singular ().raise ();
+#endif
+        }
+    }
+
+    // e2 = e1^-1 * e2 with trsv (trsm) if e1 is a triangular matrix and e2 a vector
+    // (matrix) with contiguous storage of a supported value type; false otherwise
+    template<class C, class T, class L1, class A1, class E2>
+    BOOST_UBLAS_INLINE
+    bool cblas_inplace_solve (const matrix<T, L1, A1> &, E2 &, boost::mpl::false_) {
+        return false;
+    }
+    template<class C, class T, class L1, class A1, class A2>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    bool cblas_inplace_solve (const matrix<T, L1, A1> &e1, vector<T, A2> &e2, boost::mpl::true_) {
+        cblas_matrix<const T> a;
+        cblas_vector<T> x;
+        if (! cblas_data (e1, a) || ! cblas_data (e2, x))
+            return false;
+        BOOST_UBLAS_CHECK (a.size1 == a.size2 && a.size1 == x.size, bad_size ());
+        if (std::size_t (a.size1) * std::size_t (a.size1) < BOOST_UBLAS_CBLAS_THRESHOLD)
+            return false;
+        cblas_check_singular<C> (e1);
+        cblas_trsv (cblas_order (a.row_major), cblas_triangular<C>::lower ? CblasLower : CblasUpper, CblasNoTrans,
+                    cblas_triangular<C>::unit ? CblasUnit : CblasNonUnit, a.size1, a.data, a.ld, x.data);
+        return true;
+    }
+    template<class C, class T, class L1, class A1, class L2, class A2>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    bool cblas_inplace_solve (const matrix<T, L1, A1> &e1, matrix<T, L2, A2> &e2, boost::mpl::true_) {
+        cblas_matrix<const T> a;
+        cblas_matrix<T> b;
+        if (! cblas_data (e1, a) || ! cblas_data (e2, b))
+            return false;
+        BOOST_UBLAS_CHECK (a.size1 == a.size2 && a.size1 == b.size1, bad_size ());
+        if (std::size_t (a.size1) * std::size_t (a.size1) * std::size_t (b.size2) < BOOST_UBLAS_CBLAS_THRESHOLD)
+            return false;
+        if (cblas_overlap (b, a))
+            return false;
+        cblas_check_singular<C> (e1);
+        cblas_trsm (cblas_order (b.row_major), cblas_uplo (a, b.row_major, cblas_triangular<C>::lower),
+                    a.row_major == b.row_major ? CblasNoTrans : CblasTrans,
+                    cblas_triangular<C>::unit ? CblasUnit : CblasNonUnit, b.size1, b.size2, a.data, a.ld, b.data, b.ld);
+        return true;
+    }
+    template<class C, class T, class L1, class A1, class E2>
+    BOOST_UBLAS_INLINE
+    bool cblas_inplace_solve (const matrix<T, L1, A1> &e1, E2 &e2) {
+        return cblas_inplace_solve<C> (e1, e2, boost::mpl::bool_<cblas_value<T>::value> ());
+    }
+
+}//namespace detail
+
+    // axpy_prod () of a dense matrix and a dense vector with gemv when it applies (see
+    // detail::cblas_vector_assign ()), with the generic loops of operation.hpp otherwise
+    template<class T, class L1, class A1, class A2, class A3>
+    BOOST_UBLAS_INLINE
+    vector<T, A3> &
+    axpy_prod (const matrix<T, L1, A1> &e1, const vector<T, A2> &e2,
+               vector<T, A3> &v, bool init = true) {
+        typedef matrix<T, L1, A1> expression1_type;
+        typedef vector<T, A2> expression2_type;
+        typedef matrix_vector_binary1<expression1_type, expression2_type,
+                                      matrix_vector_prod1<expression1_type, expression2_type, T> > expression_type;
+        bool done (init ? detail::cblas_vector_assign<scalar_assign> (v, expression_type (e1, e2)) :
+                          detail::cblas_vector_assign<scalar_plus_assign> (v, expression_type (e1, e2)));
+        if (done)
+            return v;
+        const matrix_expression<expression1_type> &ee1 (e1);
+        const vector_expression<expression2_type> &ee2 (e2);
+        return axpy_prod (ee1, ee2, v, init);
+    }
+    template<class T, class A1, class L2, class A2, class A3>
+    BOOST_UBLAS_INLINE
+    vector<T, A3> &
+    axpy_prod (const vector<T, A1> &e1, const matrix<T, L2, A2> &e2,
+               vector<T, A3> &v, bool init = true) {
+        typedef vector<T, A1> expression1_type;
+        typedef matrix<T, L2, A2> expression2_type;
+        typedef matrix_vector_binary2<expression1_type, expression2_type,
+                                      matrix_vector_prod2<expression1_type, expression2_type, T> > expression_type;
+        bool done (init ? detail::cblas_vector_assign<scalar_assign> (v, expression_type (e1, e2)) :
+                          detail::cblas_vector_assign<scalar_plus_assign> (v, expression_type (e1, e2)));
+        if (done)
+            return v;
+        const vector_expression<expression1_type> &ee1 (e1);
+        const matrix_expression<expression2_type> &ee2 (e2);
+        return axpy_prod (ee1, ee2, v, init);
+    }
+
+    // inner_prod () of dense vectors with dot when it applies (see
+    // detail::cblas_inner_prod ()), with the generic loop otherwise
+    template<class T, class A1, class A2>
+    BOOST_UBLAS_INLINE
+    T inner_prod (const vector<T, A1> &e1, const vector<T, A2> &e2) {
+        T t;
+        if (detail::cblas_inner_prod (e1, e2, t))
+            return t;
+        const vector_expression<vector<T, A1> > &ee1 (e1);
+        const vector_expression<vector<T, A2> > &ee2 (e2);
+        return inner_prod (ee1, ee2);
+    }
+
+    // inplace_solve () and solve () of a dense triangular system with trsv (trsm) when
+    // it applies (see detail::cblas_inplace_solve ()), with the generic loops of
+    // triangular.hpp otherwise; C is one of the four triangular tags
+    template<class T, class L1, class A1, class A2, class C>
+    BOOST_UBLAS_INLINE
+    void inplace_solve (const matrix<T, L1, A1> &e1, vector<T, A2> &e2, C) {
+        if (detail::cblas_inplace_solve<C> (e1, e2))
+            return;
+        const matrix_expression<matrix<T, L1, A1> > &ee1 (e1);
+        vector_expression<vector<T, A2> > &ee2 (e2);
+        inplace_solve (ee1, ee2, C ());
+    }
+    template<class T, class L1, class A1, class L2, class A2, class C>
+    BOOST_UBLAS_INLINE
+    void inplace_solve (const matrix<T, L1, A1> &e1, matrix<T, L2, A2> &e2, C) {
+        if (detail::cblas_inplace_solve<C> (e1, e2))
+            return;
+        const matrix_expression<matrix<T, L1, A1> > &ee1 (e1);
+        matrix_expression<matrix<T, L2, A2> > &ee2 (e2);
+        inplace_solve (ee1, ee2, C ());
+    }
+    template<class T, class L1, class A1, class A2, class C>
+    BOOST_UBLAS_INLINE
+    vector<T, A2> solve (const matrix<T, L1, A1> &e1, const vector<T, A2> &e2, C) {
+        vector<T, A2> r (e2);
+        inplace_solve (e1, r, C ());
+        return r;
+    }
+    template<class T, class L1, class A1, class L2, class A2, class C>
+    BOOST_UBLAS_INLINE
+    matrix<T, L2, A2> solve (const matrix<T, L1, A1> &e1, const matrix<T, L2, A2> &e2, C) {
+        matrix<T, L2, A2> r (e2);
+        inplace_solve (e1, r, C ());
+        return r;
+    }
+
+}}}
+
+#endif
+
+#endif
@@ -232,6 +232,11 @@ struct disable_type_check
 template <class Dummy>
 bool disable_type_check<Dummy>::value = false;
 #endif
+// Number of pseudo randomly chosen elements compared by the type checks instead of
+// a dense copy of the whole result (0 compares all elements)
+#ifndef BOOST_UBLAS_TYPE_CHECK_SAMPLES
+#define BOOST_UBLAS_TYPE_CHECK_SAMPLES 0
+#endif
 #ifndef BOOST_UBLAS_TYPE_CHECK_EPSILON
 #define BOOST_UBLAS_TYPE_CHECK_EPSILON (type_traits<real_type>::type_sqrt (std::numeric_limits<real_type>::epsilon ()))
 #endif
@@ -263,6 +268,120 @@ bool disable_type_check<Dummy>::value = false;
 #endif
 // #define BOOST_UBLAS_ITERATOR_THRESHOLD 0
 
+// Choose between indexing and iterating evaluation of dense matrices at runtime: the
+// first assignments of each class of matrix, expression, functor and orientation are
+// timed with both methods and the faster one is kept (see autotuned_assign_table ());
+// the times are taken with std::clock (), the processor time of the whole process, so
+// other threads running meanwhile skew them
+// #define BOOST_UBLAS_AUTOTUNED_ASSIGN
+#ifndef BOOST_UBLAS_AUTOTUNE_CALLS
+#define BOOST_UBLAS_AUTOTUNE_CALLS 4
+#endif
+#ifndef BOOST_UBLAS_AUTOTUNE_MIN_SIZE
+#define BOOST_UBLAS_AUTOTUNE_MIN_SIZE 4096
+#endif
+
+// Evaluate large dense matrix assignments in parallel, partitioning the major
+// dimension among the threads of the OpenMP runtime (no effect without OpenMP:
+// the assignments are then dispatched as if it were not defined)
+// #define BOOST_UBLAS_PARALLEL_ASSIGN
+#ifndef BOOST_UBLAS_PARALLEL_ASSIGN_THRESHOLD
+#define BOOST_UBLAS_PARALLEL_ASSIGN_THRESHOLD 65536
+#endif
+
+// Evaluate the reproducible reductions of large expressions (see reduction.hpp) in
+// parallel with the OpenMP runtime (no effect without OpenMP); the results are the
+// same whatever the number of threads
+// #define BOOST_UBLAS_PARALLEL_REDUCTION
+#ifndef BOOST_UBLAS_PARALLEL_REDUCTION_THRESHOLD
+#define BOOST_UBLAS_PARALLEL_REDUCTION_THRESHOLD 65536
+#endif
+// Elements per chunk of the reproducible reductions; the results depend on it
+#ifndef BOOST_UBLAS_REDUCTION_CHUNK_SIZE
+#define BOOST_UBLAS_REDUCTION_CHUNK_SIZE 4096
+#endif
+// Sum the chunks of the reproducible reductions in 8 lanes added pairwise, or in 8
+// lanes of compensated sums, instead of in index order; the compensated sums of
+// floating point values keep about twice the precision (not with -ffast-math)
+// #define BOOST_UBLAS_PAIRWISE_REDUCTION
+// #define BOOST_UBLAS_COMPENSATED_REDUCTION
+
+// Consecutive single steps over one sparse operand of an assignment after which
+// the merge jumps to the wanted index by lookup (0 disables the lookups)
+#ifndef BOOST_UBLAS_GALLOP_THRESHOLD
+#define BOOST_UBLAS_GALLOP_THRESHOLD 8
+#endif
+
+// Tile size of dense assignments between matrices of opposite orientation
+// (0 disables the tiling)
+#ifndef BOOST_UBLAS_TRANSPOSE_BLOCK_SIZE
+#define BOOST_UBLAS_TRANSPOSE_BLOCK_SIZE 32
+#endif
+
+// Tile size of the recursive (Z-order) traversal of dense assignments from element
+// wise expressions whose operands have different orientations, like A = B + trans (C)
+// (0 disables it). BOOST_UBLAS_PARALLEL_ASSIGN and BOOST_UBLAS_AUTOTUNED_ASSIGN
+// take precedence over it
+#ifndef BOOST_UBLAS_RECURSIVE_TILE_SIZE
+#define BOOST_UBLAS_RECURSIVE_TILE_SIZE 32
+#endif
+
+// Assign contiguous dense vectors and matrices of float and double, and convert
+// between float, double, int and the complex types in plain assignments, with SIMD
+// kernels selected at run time (GCC on x86 only, no effect elsewhere); swaps of
+// contiguous rows, columns and sub-matrices exchange whole runs of elements
+// #define BOOST_UBLAS_SIMD
+
+// Evaluate the assignments of products of dense matrices of float, double and their
+// complex types with contiguous storage, as m = prod (a, b) or axpy_prod (a, b, m),
+// by a packed, cache blocked kernel (see detail/gemm.hpp), with a SIMD micro kernel
+// with BOOST_UBLAS_SIMD and over the threads of the OpenMP runtime with
+// BOOST_UBLAS_PARALLEL_ASSIGN; the terms are summed in blocks of
+// BOOST_UBLAS_GEMM_KC, so the results may differ in the last bits
+// #define BOOST_UBLAS_GEMM
+// Products of fewer size1 * size2 * size multiplications keep the generic loops
+#ifndef BOOST_UBLAS_GEMM_THRESHOLD
+#define BOOST_UBLAS_GEMM_THRESHOLD 32768
+#endif
+// Blocks of the products: rows of a and of m (L2 cache), terms (L1 cache) and
+// columns of b and of m (L3 cache)
+#ifndef BOOST_UBLAS_GEMM_MC
+#define BOOST_UBLAS_GEMM_MC 96
+#endif
+#ifndef BOOST_UBLAS_GEMM_KC
+#define BOOST_UBLAS_GEMM_KC 256
+#endif
+#ifndef BOOST_UBLAS_GEMM_NC
+#define BOOST_UBLAS_GEMM_NC 2048
+#endif
+
+// Compute the products, inner products and triangular solves of dense vectors and
+// matrices of float, double and their complex types with contiguous storage by the
+// CBLAS linked with the program (see detail/cblas.hpp), before the blocked products
+// of BOOST_UBLAS_GEMM; requires <cblas.h> and a CBLAS library (-lcblas, -lblas or
+// -lopenblas). The diagonal of a non unit triangular system is checked for zeros
+// before trsv and trsm, like in the generic solves (BOOST_UBLAS_SINGULAR_CHECK)
+// #define BOOST_UBLAS_CBLAS
+// Operations of fewer multiplications keep the generic loops
+#ifndef BOOST_UBLAS_CBLAS_THRESHOLD
+#define BOOST_UBLAS_CBLAS_THRESHOLD 4096
+#endif
+
+// Store the results of plain assignments to contiguous dense vectors and matrices of
+// at least BOOST_UBLAS_STREAMING_THRESHOLD bytes with non temporal stores (x86 with
+// SSE2 only); streaming_vector_assign () and streaming_matrix_assign () request them
+// for a single assignment
+// #define BOOST_UBLAS_STREAMING_STORES
+#ifndef BOOST_UBLAS_STREAMING_THRESHOLD
+#define BOOST_UBLAS_STREAMING_THRESHOLD (16 * 1024 * 1024)
+#endif
+
+// Count the calls, elements and time of each vector_assign, matrix_assign and
+// make_conformant path per thread (see dump_assign_statistics ()); the times are the
+// processor time of the thread where clock_gettime () has CLOCK_THREAD_CPUTIME_ID
+// (see detail/assign_statistics.hpp)
+// #define BOOST_UBLAS_ASSIGN_STATISTICS
+
 // Use indexed iterators - unsupported implementation experiment
 // #define BOOST_UBLAS_USE_INDEXED_ITERATOR
 
@@ -0,0 +1,432 @@
+//
+//  Copyright (c) 2000-2010
+//  Joerg Walter, Mathias Koch, Gunter Winkler
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+//  The authors gratefully acknowledge the support of
+//  GeNeSys mbH & Co. KG in producing this work.
+//
+
+#ifndef _BOOST_UBLAS_GEMM_
+#define _BOOST_UBLAS_GEMM_
+
+#include <boost/numeric/ublas/matrix_expression.hpp>
+#include <boost/numeric/ublas/detail/simd_assign.hpp>
+#include <boost/numeric/ublas/detail/cblas.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// Products of dense matrices with contiguous storage, blocked as in Goto's GEMM: a
+// block of BOOST_UBLAS_GEMM_KC rows and BOOST_UBLAS_GEMM_NC columns of b is packed in
+// panels of nr columns, then each block of BOOST_UBLAS_GEMM_MC rows of a is packed in
+// panels of mr rows, and a micro kernel computes each mr x nr tile of the result
+// from a panel of each in registers. The blocks of rows of a are distributed among
+// the threads of the OpenMP runtime with BOOST_UBLAS_PARALLEL_ASSIGN. Each element of
+// the result is the sum of its terms in index order within each block of terms, so the
+// results depend neither on the number of threads nor on the micro kernel: the AVX
+// kernels multiply and add without fused multiply add, like the generic one.
+
+namespace boost { namespace numeric { namespace ublas {
+namespace detail {
+
+    // Value types of the blocked products
+    template<class T>
+    struct gemm_value {
+        static const bool value = false;
+    };
+    template<>
+    struct gemm_value<float> {
+        static const bool value = true;
+    };
+    template<>
+    struct gemm_value<double> {
+        static const bool value = true;
+    };
+    template<>
+    struct gemm_value<std::complex<float> > {
+        static const bool value = true;
+    };
+    template<>
+    struct gemm_value<std::complex<double> > {
+        static const bool value = true;
+    };
+
+    // Size of the tiles computed by the micro kernels: mr rows and nr columns
+    template<class T>
+    struct gemm_tile {
+        static const std::size_t mr = 4;
+        static const std::size_t nr = 4;
+    };
+    template<>
+    struct gemm_tile<float> {
+        static const std::size_t mr = 4;
+        static const std::size_t nr = 16;
+    };
+    template<>
+    struct gemm_tile<double> {
+        static const std::size_t mr = 4;
+        static const std::size_t nr = 8;
+    };
+
+    // Elements of a dense matrix with contiguous storage: element (i, j) at
+    // data [i * stride1 + j * stride2]
+    template<class P>
+    struct gemm_view {
+        P *data;
+        std::size_t size1, size2, stride1, stride2;
+    };
+
+    template<class P, class T, class L, class A>
+    BOOST_UBLAS_INLINE
+    bool gemm_matrix_view (P *data, const matrix<T, L, A> &m,
+                           std::size_t start1, std::size_t start2, std::size_t size1, std::size_t size2,
+                           gemm_view<P> &v) {
+        if (! data)
+            return false;
+        bool row_major (boost::is_same<typename L::orientation_category, row_major_tag>::value);
+        v.stride1 = row_major ? m.size2 () : 1;
+        v.stride2 = row_major ? 1 : m.size1 ();
+        v.data = data + start1 * v.stride1 + start2 * v.stride2;
+        v.size1 = size1;
+        v.size2 = size2;
+        return true;
+    }
+
+    // Other expressions
+    template<class E, class P>
+    BOOST_UBLAS_INLINE
+    bool gemm_data (const E &, gemm_view<P> &) {
+        return false;
+    }
+    // Operands, held by reference in the expressions
+    template<class E, class P>
+    BOOST_UBLAS_INLINE
+    bool gemm_data (const matrix_reference<E> &m, gemm_view<P> &v) {
+        return gemm_data (m.expression (), v);
+    }
+    // Operands
+    template<class T, class L, class A>
+    BOOST_UBLAS_INLINE
+    bool gemm_data (const matrix<T, L, A> &m, gemm_view<const T> &v) {
+        return gemm_matrix_view (simd_data (m.data ()), m, 0, 0, m.size1 (), m.size2 (), v);
+    }
+    template<class T, class L, class A>
+    BOOST_UBLAS_INLINE
+    bool gemm_data (const matrix_range<matrix<T, L, A> > &m, gemm_view<const T> &v) {
+        const matrix<T, L, A> &e = m.data ().expression ();
+        return gemm_matrix_view (simd_data (e.data ()), e, m.start1 (), m.start2 (), m.size1 (), m.size2 (), v);
+    }
+    template<class T, class L, class A>
+    BOOST_UBLAS_INLINE
+    bool gemm_data (const matrix_range<const matrix<T, L, A> > &m, gemm_view<const T> &v) {
+        const matrix<T, L, A> &e = m.data ().expression ();
+        return gemm_matrix_view (simd_data (e.data ()), e, m.start1 (), m.start2 (), m.size1 (), m.size2 (), v);
+    }
+    // Results
+    template<class T, class L, class A>
+    BOOST_UBLAS_INLINE
+    bool gemm_data (matrix<T, L, A> &m, gemm_view<T> &v) {
+        return gemm_matrix_view (simd_data (m.data ()), m, 0, 0, m.size1 (), m.size2 (), v);
+    }
+    template<class T, class L, class A>
+    BOOST_UBLAS_INLINE
+    bool gemm_data (matrix_range<matrix<T, L, A> > &m, gemm_view<T> &v) {
+        matrix<T, L, A> &e = m.data ().expression ();
+        return gemm_matrix_view (simd_data (e.data ()), e, m.start1 (), m.start2 (), m.size1 (), m.size2 (), v);
+    }
+
+    // True if the elements of the result may share storage with those of an operand
+    template<class T>
+    BOOST_UBLAS_INLINE
+    bool gemm_overlap (const gemm_view<T> &c, const gemm_view<const T> &a) {
+        if (c.size1 == 0 || c.size2 == 0 || a.size1 == 0 || a.size2 == 0)
+            return false;
+        const T *c_begin = c.data, *c_end = c.data + (c.size1 - 1) * c.stride1 + (c.size2 - 1) * c.stride2 + 1;
+        const T *a_begin = a.data, *a_end = a.data + (a.size1 - 1) * a.stride1 + (a.size2 - 1) * a.stride2 + 1;
+        std::less<const T *> less;
+        return less (c_begin, a_end) && less (a_begin, c_end);
+    }
+
+    // t += a * b, with the complex products computed without the checks for infinite
+    // and NaN parts, as by the generic loops for finite values
+    template<class T>
+    BOOST_UBLAS_INLINE
+    void gemm_multiply_add (T &t, const T &a, const T &b) {
+        t += a * b;
+    }
+    template<class T>
+    BOOST_UBLAS_INLINE
+    void gemm_multiply_add (std::complex<T> &t, const std::complex<T> &a, const std::complex<T> &b) {
+        t = std::complex<T> (t.real () + (a.real () * b.real () - a.imag () * b.imag ()),
+                             t.imag () + (a.real () * b.imag () + a.imag () * b.real ()));
+    }
+
+    // Generic micro kernel: ab = the product of a panel of mr rows by kc terms of a
+    // and of a panel of kc terms by nr columns of b, row after row
+    template<class T>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void gemm_generic_kernel (std::size_t kc, const T *a, const T *b, T *ab) {
+        const std::size_t mr = gemm_tile<T>::mr;
+        const std::size_t nr = gemm_tile<T>::nr;
+        T t [gemm_tile<T>::mr * gemm_tile<T>::nr];
+        std::fill (t, t + mr * nr, T ());
+        for (std::size_t k = 0; k < kc; ++ k, a += mr, b += nr)
+            for (std::size_t i = 0; i < mr; ++ i)
+                for (std::size_t j = 0; j < nr; ++ j)
+                    gemm_multiply_add (t [i * nr + j], a [i], b [j]);
+        std::copy (t, t + mr * nr, ab);
+    }
+
+    template<class T>
+    BOOST_UBLAS_INLINE
+    void gemm_kernel (std::size_t kc, const T *a, const T *b, T *ab) {
+        gemm_generic_kernel (kc, a, b, ab);
+    }
+
+#ifdef BOOST_UBLAS_SIMD_X86
+    // AVX micro kernels, compiled for AVX whatever the target of the translation unit
+#pragma GCC push_options
+#pragma GCC target ("avx")
+    inline void gemm_avx_kernel (std::size_t kc, const double *a, const double *b, double *ab) {
+        __m256d c00 = _mm256_setzero_pd (), c01 = _mm256_setzero_pd ();
+        __m256d c10 = _mm256_setzero_pd (), c11 = _mm256_setzero_pd ();
+        __m256d c20 = _mm256_setzero_pd (), c21 = _mm256_setzero_pd ();
+        __m256d c30 = _mm256_setzero_pd (), c31 = _mm256_setzero_pd ();
+        for (std::size_t k = 0; k < kc; ++ k, a += 4, b += 8) {
+            const __m256d b0 = _mm256_loadu_pd (b), b1 = _mm256_loadu_pd (b + 4);
+            __m256d ai = _mm256_broadcast_sd (a);
+            c00 = _mm256_add_pd (c00, _mm256_mul_pd (ai, b0));
+            c01 = _mm256_add_pd (c01, _mm256_mul_pd (ai, b1));
+            ai = _mm256_broadcast_sd (a + 1);
+            c10 = _mm256_add_pd (c10, _mm256_mul_pd (ai, b0));
+            c11 = _mm256_add_pd (c11, _mm256_mul_pd (ai, b1));
+            ai = _mm256_broadcast_sd (a + 2);
+            c20 = _mm256_add_pd (c20, _mm256_mul_pd (ai, b0));
+            c21 = _mm256_add_pd (c21, _mm256_mul_pd (ai, b1));
+            ai = _mm256_broadcast_sd (a + 3);
+            c30 = _mm256_add_pd (c30, _mm256_mul_pd (ai, b0));
+            c31 = _mm256_add_pd (c31, _mm256_mul_pd (ai, b1));
+        }
+        _mm256_storeu_pd (ab, c00); _mm256_storeu_pd (ab + 4, c01);
+        _mm256_storeu_pd (ab + 8, c10); _mm256_storeu_pd (ab + 12, c11);
+        _mm256_storeu_pd (ab + 16, c20); _mm256_storeu_pd (ab + 20, c21);
+        _mm256_storeu_pd (ab + 24, c30); _mm256_storeu_pd (ab + 28, c31);
+    }
+    inline void gemm_avx_kernel (std::size_t kc, const float *a, const float *b, float *ab) {
+        __m256 c00 = _mm256_setzero_ps (), c01 = _mm256_setzero_ps ();
+        __m256 c10 = _mm256_setzero_ps (), c11 = _mm256_setzero_ps ();
+        __m256 c20 = _mm256_setzero_ps (), c21 = _mm256_setzero_ps ();
+        __m256 c30 = _mm256_setzero_ps (), c31 = _mm256_setzero_ps ();
+        for (std::size_t k = 0; k < kc; ++ k, a += 4, b += 16) {
+            const __m256 b0 = _mm256_loadu_ps (b), b1 = _mm256_loadu_ps (b + 8);
+            __m256 ai = _mm256_broadcast_ss (a);
+            c00 = _mm256_add_ps (c00, _mm256_mul_ps (ai, b0));
+            c01 = _mm256_add_ps (c01, _mm256_mul_ps (ai, b1));
+            ai = _mm256_broadcast_ss (a + 1);
+            c10 = _mm256_add_ps (c10, _mm256_mul_ps (ai, b0));
+            c11 = _mm256_add_ps (c11, _mm256_mul_ps (ai, b1));
+            ai = _mm256_broadcast_ss (a + 2);
+            c20 = _mm256_add_ps (c20, _mm256_mul_ps (ai, b0));
+            c21 = _mm256_add_ps (c21, _mm256_mul_ps (ai, b1));
+            ai = _mm256_broadcast_ss (a + 3);
+            c30 = _mm256_add_ps (c30, _mm256_mul_ps (ai, b0));
+            c31 = _mm256_add_ps (c31, _mm256_mul_ps (ai, b1));
+        }
+        _mm256_storeu_ps (ab, c00); _mm256_storeu_ps (ab + 8, c01);
+        _mm256_storeu_ps (ab + 16, c10); _mm256_storeu_ps (ab + 24, c11);
+        _mm256_storeu_ps (ab + 32, c20); _mm256_storeu_ps (ab + 40, c21);
+        _mm256_storeu_ps (ab + 48, c30); _mm256_storeu_ps (ab + 56, c31);
+    }
+#pragma GCC pop_options
+
+    // Kernel dispatch: float and double have an AVX kernel
+#define BOOST_UBLAS_GEMM_KERNEL(T) \
+    inline void gemm_kernel (std::size_t kc, const T *a, const T *b, T *ab) { \
+        if (simd_has_avx ()) \
+            gemm_avx_kernel (kc, a, b, ab); \
+        else \
+            gemm_generic_kernel (kc, a, b, ab); \
+    }
+    BOOST_UBLAS_GEMM_KERNEL(float)
+    BOOST_UBLAS_GEMM_KERNEL(double)
+#undef BOOST_UBLAS_GEMM_KERNEL
+#endif
+
+    // Block of size1 rows and size2 columns of a from (i, k) in panels of mr rows,
+    // each stored term after term and completed with zeros
+    template<class T>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void gemm_pack_a (const gemm_view<const T> &a, std::size_t i, std::size_t k,
+                      std::size_t size1, std::size_t size2, T *p) {
+        const std::size_t mr = gemm_tile<T>::mr;
+        for (std::size_t ir = 0; ir < size1; ir += mr) {
+            std::size_t m ((std::min) (mr, size1 - ir));
+            const T *panel = a.data + (i + ir) * a.stride1 + k * a.stride2;
+            for (std::size_t kk = 0; kk < size2; ++ kk, p += mr) {
+                for (std::size_t r = 0; r < m; ++ r)
+                    p [r] = panel [r * a.stride1 + kk * a.stride2];
+                std::fill (p + m, p + mr, T ());
+            }
+        }
+    }
+    // Block of size1 rows and size2 columns of b from (k, j) in panels of nr columns,
+    // each stored term after term and completed with zeros
+    template<class T>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void gemm_pack_b (const gemm_view<const T> &b, std::size_t k, std::size_t j,
+                      std::size_t size1, std::size_t size2, T *p) {
+        const std::size_t nr = gemm_tile<T>::nr;
+        for (std::size_t jr = 0; jr < size2; jr += nr) {
+            std::size_t n ((std::min) (nr, size2 - jr));
+            const T *panel = b.data + k * b.stride1 + (j + jr) * b.stride2;
+            for (std::size_t kk = 0; kk < size1; ++ kk, p += nr) {
+                for (std::size_t c = 0; c < n; ++ c)
+                    p [c] = panel [kk * b.stride1 + c * b.stride2];
+                std::fill (p + n, p + nr, T ());
+            }
+        }
+    }
+
+    // c OP= t for the first block of terms, c += t (c -= t) for the next ones
+    template<int OP, class T>
+    BOOST_UBLAS_INLINE
+    void gemm_update (T &c, const T &t, bool first) {
+        if (OP == simd_op_assign && first)
+            c = t;
+        else if (OP == simd_op_minus)
+            c -= t;
+        else
+            c += t;
+    }
+
+    // Block of size1 rows and size2 columns of c from (i, j) updated with the product
+    // of packed blocks of a and b of kc terms
+    template<int OP, class T>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void gemm_macro_kernel (const gemm_view<T> &c, std::size_t i, std::size_t j,
+                            std::size_t size1, std::size_t size2, std::size_t kc,
+                            const T *pa, const T *pb, bool first) {
+        const std::size_t mr = gemm_tile<T>::mr;
+        const std::size_t nr = gemm_tile<T>::nr;
+        T ab [gemm_tile<T>::mr * gemm_tile<T>::nr];
+        for (std::size_t jr = 0; jr < size2; jr += nr) {
+            std::size_t n ((std::min) (nr, size2 - jr));
+            for (std::size_t ir = 0; ir < size1; ir += mr) {
+                std::size_t m ((std::min) (mr, size1 - ir));
+                gemm_kernel (kc, pa + ir * kc, pb + jr * kc, ab);
+                T *tile = c.data + (i + ir) * c.stride1 + (j + jr) * c.stride2;
+                for (std::size_t r = 0; r < m; ++ r)
+                    for (std::size_t s = 0; s < n; ++ s)
+                        gemm_update<OP> (tile [r * c.stride1 + s * c.stride2], ab [r * nr + s], first);
+            }
+        }
+    }
+
+    // c OP= a * b with OP one of assign, plus and minus
+    template<int OP, class T>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void gemm (const gemm_view<T> &c, const gemm_view<const T> &a, const gemm_view<const T> &b) {
+        typedef std::ptrdiff_t difference_type;
+        const std::size_t mr = gemm_tile<T>::mr;
+        const std::size_t nr = gemm_tile<T>::nr;
+        const std::size_t mc = BOOST_UBLAS_GEMM_MC, kc = BOOST_UBLAS_GEMM_KC, nc = BOOST_UBLAS_GEMM_NC;
+        std::size_t size1 (c.size1), size2 (c.size2), size (a.size2);
+        if (size == 0) {
+            if (OP == simd_op_assign)
+                for (std::size_t i = 0; i < size1; ++ i)
+                    for (std::size_t j = 0; j < size2; ++ j)
+                        c.data [i * c.stride1 + j * c.stride2] = T ();
+            return;
+        }
+        std::vector<T> pb (kc * ((nc + nr - 1) / nr) * nr);
+        for (std::size_t jc = 0; jc < size2; jc += nc) {
+            std::size_t n ((std::min) (nc, size2 - jc));
+            for (std::size_t pc = 0; pc < size; pc += kc) {
+                std::size_t k ((std::min) (kc, size - pc));
+                gemm_pack_b (b, pc, jc, k, n, &pb [0]);
+                difference_type blocks ((size1 + mc - 1) / mc);
+#if defined (BOOST_UBLAS_PARALLEL_ASSIGN) && defined (_OPENMP)
+#pragma omp parallel for schedule(static) if (size1 * size2 >= BOOST_UBLAS_PARALLEL_ASSIGN_THRESHOLD)
+#endif
+                for (difference_type ib = 0; ib < blocks; ++ ib) {
+                    std::size_t ic (std::size_t (ib) * mc);
+                    std::size_t m ((std::min) (mc, size1 - ic));
+                    std::vector<T> pa (k * ((m + mr - 1) / mr) * mr);
+                    gemm_pack_a (a, ic, pc, m, k, &pa [0]);
+                    gemm_macro_kernel<OP> (c, ic, jc, m, n, k, &pa [0], &pb [0], pc == 0);
+                }
+            }
+        }
+    }
+
+    // m F= e with the blocked product if e is the product of dense matrices with
+    // contiguous storage of a supported value type, m is one too and shares no
+    // storage with them; false otherwise
+    template<template <class T1, class T2> class F, class M, class E>
+    BOOST_UBLAS_INLINE
+    bool gemm_matrix_assign (M &, const E &) {
+        return false;
+    }
+    template<template <class T1, class T2> class F, class M, class E1, class E2, class T>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    bool gemm_matrix_assign (M &m, const matrix_matrix_binary<E1, E2, matrix_matrix_prod<E1, E2, T> > &e) {
+        typedef typename M::value_type value_type;
+        const int op = simd_op<F>::value;
+        if (op != simd_op_assign && op != simd_op_plus && op != simd_op_minus)
+            return false;
+        if (! gemm_value<value_type>::value || ! boost::is_same<value_type, T>::value)
+            return false;
+        gemm_view<value_type> c;
+        gemm_view<const value_type> a, b;
+        if (! gemm_data (m, c) || ! gemm_data (e.expression1 (), a) || ! gemm_data (e.expression2 (), b))
+            return false;
+        BOOST_UBLAS_CHECK (c.size1 == a.size1 && c.size2 == b.size2 && a.size2 == b.size1, bad_size ());
+        if (c.size1 * c.size2 * a.size2 < BOOST_UBLAS_GEMM_THRESHOLD)
+            return false;
+        if (gemm_overlap (c, a) || gemm_overlap (c, b))
+            return false;
+        gemm<simd_op<F>::value> (c, a, b);
+        return true;
+    }
+
+}//namespace detail
+
+#if defined (BOOST_UBLAS_GEMM) || defined (BOOST_UBLAS_CBLAS)
+    // axpy_prod () of dense matrices with gemm or the blocked product when they apply
+    // (see detail::cblas_matrix_assign () and detail::gemm_matrix_assign ()), with the
+    // generic loops of operation.hpp otherwise
+    template<class T, class L1, class A1, class L2, class A2, class L3, class A3>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    matrix<T, L3, A3> &
+    axpy_prod (const matrix<T, L1, A1> &e1, const matrix<T, L2, A2> &e2,
+               matrix<T, L3, A3> &m, bool init = true) {
+        typedef matrix<T, L1, A1> expression1_type;
+        typedef matrix<T, L2, A2> expression2_type;
+        typedef matrix_matrix_binary<expression1_type, expression2_type,
+                                     matrix_matrix_prod<expression1_type, expression2_type, T> > expression_type;
+#ifdef BOOST_UBLAS_CBLAS
+        if (init ? detail::cblas_matrix_assign<scalar_assign> (m, expression_type (e1, e2)) :
+                   detail::cblas_matrix_assign<scalar_plus_assign> (m, expression_type (e1, e2)))
+            return m;
+#endif
+#ifdef BOOST_UBLAS_GEMM
+        if (init ? detail::gemm_matrix_assign<scalar_assign> (m, expression_type (e1, e2)) :
+                   detail::gemm_matrix_assign<scalar_plus_assign> (m, expression_type (e1, e2)))
+            return m;
+#endif
+        if (init)
+            m.assign (zero_matrix<T> (e1.size1 (), e2.size2 ()));
+        return axpy_prod (e1, e2, m, full (), typename matrix<T, L3, A3>::storage_category (), typename L3::orientation_category ());
+    }
+#endif
+
+}}}
+
+#endif
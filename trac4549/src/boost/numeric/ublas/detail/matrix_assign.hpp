@@ -14,12 +14,42 @@
 #define _BOOST_UBLAS_MATRIX_ASSIGN_
 
 #include <boost/numeric/ublas/traits.hpp>
+#include <boost/numeric/ublas/fwd.hpp>
+#include <boost/numeric/ublas/detail/simd_assign.hpp>
+#include <boost/numeric/ublas/detail/stream_assign.hpp>
+#include <boost/numeric/ublas/detail/gemm.hpp>
+#include <boost/numeric/ublas/detail/assign_statistics.hpp>
 // Required for make_conformant storage
 #include <vector>
+// Required for the in place merge of compressed_matrix fill-in
+#include <algorithm>
+// Required for the bulk copies of packed storage
+#include <cstring>
+#include <boost/mpl/bool.hpp>
+// Required for the autotuned dispatch
+#include <ctime>
+#include <typeinfo>
 
 // Iterators based on ideas of Jeremy Siek
 
 namespace boost { namespace numeric { namespace ublas {
+
+    // Decision of the runtime calibrated dispatch for one class of dense assignments
+    // (see BOOST_UBLAS_AUTOTUNED_ASSIGN); index 0 refers to indexing, 1 to iterating
+    struct autotuned_assign_entry {
+        const char *signature;
+        std::size_t elements [2];
+        double seconds [2];
+        bool iterating;
+    };
+
+    // Decisions taken so far, in the order in which they were taken
+    inline
+    std::vector<autotuned_assign_entry> &autotuned_assign_table () {
+        static std::vector<autotuned_assign_entry> table;
+        return table;
+    }
+
 namespace detail {
     
     // Weak equality check - useful to compare equality two arbitary matrix expression results.
@@ -34,18 +64,132 @@ namespace detail {
                std::max<S> (std::max<S> (norm_inf (e1), norm_inf (e2)), min_norm);
     }
 
+    // Exact equality check for integral types, where no rounding can occur
+    template<class E1, class E2>
+    BOOST_UBLAS_INLINE
+    bool equals (const matrix_expression<E1> &e1, const matrix_expression<E2> &e2) {
+        typedef typename E1::size_type size_type;
+        if (e1 ().size1 () != e2 ().size1 () || e1 ().size2 () != e2 ().size2 ())
+            return false;
+        for (size_type i = 0; i < e1 ().size1 (); ++ i)
+            for (size_type j = 0; j < e1 ().size2 (); ++ j)
+                if (e1 () (i, j) != e2 () (i, j))
+                    return false;
+        return true;
+    }
+
+    template<class E1, class E2, class S>
+    BOOST_UBLAS_INLINE
+    bool expression_type_check (const matrix_expression<E1> &e1, const matrix_expression<E2> &e2, S, boost::mpl::true_) {
+        return equals (e1, e2);
+    }
+    template<class E1, class E2, class real_type>
+    BOOST_UBLAS_INLINE
+    bool expression_type_check (const matrix_expression<E1> &e1, const matrix_expression<E2> &e2, real_type, boost::mpl::false_) {
+        return equals (e1, e2, BOOST_UBLAS_TYPE_CHECK_EPSILON, BOOST_UBLAS_TYPE_CHECK_MIN);
+    }
     template<class E1, class E2>
     BOOST_UBLAS_INLINE
     bool expression_type_check (const matrix_expression<E1> &e1, const matrix_expression<E2> &e2) {
         typedef typename type_traits<typename promote_traits<typename E1::value_type,
                                      typename E2::value_type>::promote_type>::real_type real_type;
-        return equals (e1, e2, BOOST_UBLAS_TYPE_CHECK_EPSILON, BOOST_UBLAS_TYPE_CHECK_MIN);
+        return expression_type_check (e1, e2, real_type (), boost::mpl::bool_<boost::is_integral<real_type>::value> ());
+    }
+
+    // Sampled type check.
+    // Keeps the expected results of BOOST_UBLAS_TYPE_CHECK_SAMPLES pseudo randomly chosen
+    // elements, computed before the assignment, instead of a dense copy of the whole result.
+    template<class T>
+    class matrix_type_check_sample {
+    public:
+        typedef std::size_t size_type;
+        typedef T value_type;
+
+        template<template <class T1, class T2> class F, class M, class E>
+        void assign (const M &m, const matrix_expression<E> &e) {
+            typedef F<value_type &, typename E::value_type> functor_type;
+            size_type size1 (m.size1 ()), size2 (m.size2 ());
+            if (size1 == 0 || size2 == 0)
+                return;
+            size_type samples (BOOST_UBLAS_TYPE_CHECK_SAMPLES);
+            bool all (size1 <= samples / size2);
+            if (all)
+                samples = size1 * size2;
+            index1_.reserve (samples);
+            index2_.reserve (samples);
+            values_.reserve (samples);
+            // Linear congruential generator, reproducible for a given shape
+            unsigned long seed (static_cast<unsigned long> (size1 * 31 + size2));
+            for (size_type k = 0; k < samples; ++ k) {
+                size_type i, j;
+                if (all) {
+                    i = k / size2;
+                    j = k % size2;
+                } else {
+                    seed = seed * 1103515245UL + 12345UL;
+                    i = static_cast<size_type> ((seed >> 16) % size1);
+                    seed = seed * 1103515245UL + 12345UL;
+                    j = static_cast<size_type> ((seed >> 16) % size2);
+                }
+                value_type t (m (i, j));
+                functor_type::apply (t, e () (i, j));
+                index1_.push_back (i);
+                index2_.push_back (j);
+                values_.push_back (t);
+            }
+        }
+
+        // Exact comparison of the samples for integral types
+        template<class E>
+        bool equals (const matrix_expression<E> &e) const {
+            for (size_type k = 0; k < values_.size (); ++ k)
+                if (value_type (e () (index1_ [k], index2_ [k])) != values_ [k])
+                    return false;
+            return true;
+        }
+
+        // Same bound as equals () restricted to the samples
+        template<class E, class S>
+        bool equals (const matrix_expression<E> &e, S epsilon, S min_norm) const {
+            S norm_diff (0), norm_e (0), norm_s (0);
+            for (size_type k = 0; k < values_.size (); ++ k) {
+                value_type t (e () (index1_ [k], index2_ [k]));
+                norm_diff = (std::max) (norm_diff, S (type_traits<value_type>::norm_inf (t - values_ [k])));
+                norm_e = (std::max) (norm_e, S (type_traits<value_type>::norm_inf (t)));
+                norm_s = (std::max) (norm_s, S (type_traits<value_type>::norm_inf (values_ [k])));
+            }
+            return norm_diff <= epsilon * std::max<S> (std::max<S> (norm_e, norm_s), min_norm);
+        }
+
+    private:
+        std::vector<size_type> index1_;
+        std::vector<size_type> index2_;
+        std::vector<value_type> values_;
+    };
+
+    template<class E, class T, class S>
+    BOOST_UBLAS_INLINE
+    bool expression_type_check (const matrix_expression<E> &e, const matrix_type_check_sample<T> &s, S, boost::mpl::true_) {
+        return s.equals (e);
+    }
+    template<class E, class T, class real_type>
+    BOOST_UBLAS_INLINE
+    bool expression_type_check (const matrix_expression<E> &e, const matrix_type_check_sample<T> &s, real_type, boost::mpl::false_) {
+        return s.equals (e, BOOST_UBLAS_TYPE_CHECK_EPSILON, BOOST_UBLAS_TYPE_CHECK_MIN);
+    }
+    template<class E, class T>
+    BOOST_UBLAS_INLINE
+    bool expression_type_check (const matrix_expression<E> &e, const matrix_type_check_sample<T> &s) {
+        typedef typename type_traits<typename promote_traits<typename E::value_type,
+                                     T>::promote_type>::real_type real_type;
+        return expression_type_check (e, s, real_type (), boost::mpl::bool_<boost::is_integral<real_type>::value> ());
     }
 
 
     template<class M, class E, class R>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void make_conformant (M &m, const matrix_expression<E> &e, row_major_tag, R) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_matrix_make_conformant_row_major, false, m.size1 () * m.size2 ());
         BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
         BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
         typedef R conformant_restrict_type;
@@ -150,6 +294,7 @@ namespace detail {
     template<class M, class E, class R>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void make_conformant (M &m, const matrix_expression<E> &e, column_major_tag, R) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_matrix_make_conformant_column_major, false, m.size1 () * m.size2 ());
         BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
         BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
         typedef R conformant_restrict_type;
@@ -251,6 +396,415 @@ namespace detail {
             m (index [k].first, index [k].second) = value_type/*zero*/();
     }
 
+    // Access to the major slices of an expression, used when the target storage
+    // can be walked directly major index by major index.
+    template<class E, class O>
+    struct conformant_slice {};
+
+    template<class E>
+    struct conformant_slice<E, row_major_tag> {
+        typedef typename E::size_type size_type;
+        typedef typename E::const_iterator2 const_iterator;
+
+        BOOST_UBLAS_INLINE
+        static const_iterator begin (const E &e, size_type i) {
+            return e.find2 (1, i, 0);
+        }
+        BOOST_UBLAS_INLINE
+        static const_iterator end (const E &e, size_type i) {
+            return e.find2 (1, i, e.size2 ());
+        }
+        BOOST_UBLAS_INLINE
+        static size_type index (const const_iterator &it) {
+            return it.index2 ();
+        }
+    };
+
+    template<class E>
+    struct conformant_slice<E, column_major_tag> {
+        typedef typename E::size_type size_type;
+        typedef typename E::const_iterator1 const_iterator;
+
+        BOOST_UBLAS_INLINE
+        static const_iterator begin (const E &e, size_type j) {
+            return e.find1 (1, 0, j);
+        }
+        BOOST_UBLAS_INLINE
+        static const_iterator end (const E &e, size_type j) {
+            return e.find1 (1, e.size1 (), j);
+        }
+        BOOST_UBLAS_INLINE
+        static size_type index (const const_iterator &it) {
+            return it.index1 ();
+        }
+    };
+
+    // Number of non zero elements of the major slice i of e which satisfy R
+    // and are missing in the sorted (k based) minor indices [it, it_end).
+    template<class R, class S, class I, class E>
+    BOOST_UBLAS_INLINE
+    typename E::size_type conformant_fill_count (I it, I it_end, typename E::size_type k, const E &e, typename E::size_type i) {
+        typedef typename E::size_type size_type;
+        typedef typename S::const_iterator slice_iterator;
+        typedef typename E::value_type value_type;
+        size_type count = 0;
+        slice_iterator ite (S::begin (e, i));
+        slice_iterator ite_end (S::end (e, i));
+        for (; ite != ite_end; ++ ite) {
+            size_type index = S::index (ite) + k;
+            while (it != it_end && size_type (*it) < index)
+                ++ it;
+            if (it != it_end && size_type (*it) == index)
+                continue;
+            if (R::other (ite.index1 (), ite.index2 ()))
+                if (static_cast<value_type>(*ite) != value_type/*zero*/())
+                    ++ count;
+        }
+        return count;
+    }
+
+    // Compressed target: the fill-in is counted first, the storage is reserved
+    // once and the major slices are then merged in place from the last one to the
+    // first one, so that no element is moved twice and nothing is allocated.
+    template<class T, class L, std::size_t IB, class IA, class TA, class E, class R>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void make_compressed_conformant (compressed_matrix<T, L, IB, IA, TA> &m, const E &e, R) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_matrix_make_conformant_compressed, false, m.size1 () * m.size2 ());
+        BOOST_UBLAS_CHECK (m.size1 () == e.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e.size2 (), bad_size ());
+        typedef R conformant_restrict_type;
+        typedef conformant_slice<E, typename L::orientation_category> slice_type;
+        typedef typename slice_type::const_iterator slice_iterator;
+        typedef typename compressed_matrix<T, L, IB, IA, TA>::size_type size_type;
+        typedef typename IA::iterator index_iterator;
+        typedef typename TA::iterator value_iterator;
+        typedef typename E::value_type expr_value_type;
+
+        m.complete_index1_data ();
+        const size_type size_M = L::size_M (m.size1 (), m.size2 ());
+
+        // Pass 1: count the fill-in
+        size_type fill = 0;
+        for (size_type i = 0; i < size_M; ++ i) {
+            index_iterator it (m.index2_data ().begin () + (m.index1_data () [i] - IB));
+            index_iterator it_end (m.index2_data ().begin () + (m.index1_data () [i + 1] - IB));
+            fill += conformant_fill_count<conformant_restrict_type, slice_type> (it, it_end, IB, e, i);
+        }
+        if (fill == 0)
+            return;
+
+        const size_type total = fill;
+        const size_type filled = m.filled2 ();
+        if (m.nnz_capacity () < filled + fill)
+            m.reserve (filled + fill, true);
+
+        // Pass 2: merge the major slices in place, last to first
+        index_iterator index2 (m.index2_data ().begin ());
+        value_iterator value (m.value_data ().begin ());
+        size_type old_end = filled;
+        for (size_type i = size_M; i -- > 0; ) {
+            const size_type old_begin = m.index1_data () [i] - IB;
+            const size_type count = conformant_fill_count<conformant_restrict_type, slice_type> (index2 + old_begin, index2 + old_end, IB, e, i);
+            const size_type new_end = old_end + fill;
+            fill -= count;
+            const size_type new_begin = old_begin + fill;
+            if (count == 0) {
+                std::copy_backward (index2 + old_begin, index2 + old_end, index2 + new_end);
+                std::copy_backward (value + old_begin, value + old_end, value + new_end);
+            } else {
+                // Move the old elements to the tail of their new range, then merge forward
+                size_type r = new_end - (old_end - old_begin);
+                std::copy_backward (index2 + old_begin, index2 + old_end, index2 + new_end);
+                std::copy_backward (value + old_begin, value + old_end, value + new_end);
+                size_type w = new_begin;
+                slice_iterator ite (slice_type::begin (e, i));
+                slice_iterator ite_end (slice_type::end (e, i));
+                for (; ite != ite_end; ++ ite) {
+                    size_type index = slice_type::index (ite) + IB;
+                    while (r != new_end && size_type (index2 [r]) < index) {
+                        index2 [w] = index2 [r];
+                        value [w] = value [r];
+                        ++ r, ++ w;
+                    }
+                    if (r != new_end && size_type (index2 [r]) == index)
+                        continue;
+                    if (conformant_restrict_type::other (ite.index1 (), ite.index2 ()))
+                        if (static_cast<expr_value_type>(*ite) != expr_value_type/*zero*/()) {
+                            index2 [w] = index;
+                            value [w] = T/*zero*/();
+                            ++ w;
+                        }
+                }
+                BOOST_UBLAS_CHECK (w == r, internal_logic ());
+            }
+            m.index1_data () [i + 1] = new_end + IB;
+            old_end = old_begin;
+        }
+        m.set_filled (m.filled1 (), filled + total);
+    }
+
+    template<class T, class L, std::size_t IB, class IA, class TA, class E, class R>
+    BOOST_UBLAS_INLINE
+    void make_conformant (compressed_matrix<T, L, IB, IA, TA> &m, const matrix_expression<E> &e, row_major_tag, R) {
+        make_compressed_conformant (m, e (), R ());
+    }
+    template<class T, class L, std::size_t IB, class IA, class TA, class E, class R>
+    BOOST_UBLAS_INLINE
+    void make_conformant (compressed_matrix<T, L, IB, IA, TA> &m, const matrix_expression<E> &e, column_major_tag, R) {
+        make_compressed_conformant (m, e (), R ());
+    }
+
+    // Mapped target: the fill-in is counted first and reserved once, then inserted
+    // in a single ordered walk of the map, hinting each insertion.
+    template<class T, class L, class A, class E, class R>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void make_mapped_conformant (mapped_matrix<T, L, A> &m, const E &e, R) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_matrix_make_conformant_mapped, false, m.size1 () * m.size2 ());
+        BOOST_UBLAS_CHECK (m.size1 () == e.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e.size2 (), bad_size ());
+        typedef R conformant_restrict_type;
+        typedef conformant_slice<E, typename L::orientation_category> slice_type;
+        typedef typename slice_type::const_iterator slice_iterator;
+        typedef typename mapped_matrix<T, L, A>::size_type size_type;
+        typedef typename A::iterator subiterator_type;
+        typedef typename A::value_type pair_type;
+        typedef typename E::value_type expr_value_type;
+
+        const size_type size_M = L::size_M (m.size1 (), m.size2 ());
+        const size_type size_m = L::size_m (m.size1 (), m.size2 ());
+
+        // Two passes over the ordered keys of both sides: the first one counts the
+        // fill-in, the second one inserts it
+        for (int pass = 0; pass < 2; ++ pass) {
+            size_type fill = 0;
+            subiterator_type it (m.data ().begin ());
+            for (size_type i = 0; i < size_M; ++ i) {
+                slice_iterator ite (slice_type::begin (e, i));
+                slice_iterator ite_end (slice_type::end (e, i));
+                for (; ite != ite_end; ++ ite) {
+                    size_type element = i * size_m + slice_type::index (ite);
+                    while (it != m.data ().end () && size_type ((*it).first) < element)
+                        ++ it;
+                    if (it != m.data ().end () && size_type ((*it).first) == element)
+                        continue;
+                    if (conformant_restrict_type::other (ite.index1 (), ite.index2 ()))
+                        if (static_cast<expr_value_type>(*ite) != expr_value_type/*zero*/()) {
+                            if (pass == 1)
+                                it = m.data ().insert (it, pair_type (element, T/*zero*/()));
+                            ++ fill;
+                        }
+                }
+            }
+            if (fill == 0)
+                return;
+            if (pass == 0)
+                m.reserve (m.nnz () + fill, true);
+        }
+    }
+
+    template<class T, class L, class A, class E, class R>
+    BOOST_UBLAS_INLINE
+    void make_conformant (mapped_matrix<T, L, A> &m, const matrix_expression<E> &e, row_major_tag, R) {
+        make_mapped_conformant (m, e (), R ());
+    }
+    template<class T, class L, class A, class E, class R>
+    BOOST_UBLAS_INLINE
+    void make_conformant (mapped_matrix<T, L, A> &m, const matrix_expression<E> &e, column_major_tag, R) {
+        make_mapped_conformant (m, e (), R ());
+    }
+
+    // Lookups of the galloping merge (see vector_assign.hpp) in a row or a column
+    template<class M>
+    struct gallop_row_lookup {
+        typedef typename M::size_type size_type;
+
+        BOOST_UBLAS_INLINE
+        gallop_row_lookup (M &m, size_type i):
+            m_ (m), i_ (i) {}
+        template<class I>
+        BOOST_UBLAS_INLINE
+        void operator () (I &it, size_type j) const {
+            it = m_.find2 (1, i_, j);
+        }
+    private:
+        M &m_;
+        size_type i_;
+    };
+    template<class M>
+    struct gallop_column_lookup {
+        typedef typename M::size_type size_type;
+
+        BOOST_UBLAS_INLINE
+        gallop_column_lookup (M &m, size_type j):
+            m_ (m), j_ (j) {}
+        template<class I>
+        BOOST_UBLAS_INLINE
+        void operator () (I &it, size_type i) const {
+            it = m_.find1 (1, i, j_);
+        }
+    private:
+        M &m_;
+        size_type j_;
+    };
+
+    // Packed storage whose mutable elements, walked along the orientation O, lie at
+    // strictly increasing addresses. A run of n such elements whose ends are n - 1
+    // positions apart is then contiguous.
+    template<class M, class O>
+    struct packed_increasing_storage {
+        static const bool value = false;
+    };
+    template<class T, class TRI, class L, class A, class O>
+    struct packed_increasing_storage<triangular_matrix<T, TRI, L, A>, O> {
+        static const bool value = boost::is_same<typename L::orientation_category, O>::value;
+    };
+    template<class T, class TRI, class L, class A, class O>
+    struct packed_increasing_storage<symmetric_matrix<T, TRI, L, A>, O> {
+        static const bool value = boost::is_same<typename L::orientation_category, O>::value;
+    };
+    template<class T, class L, class A, class O>
+    struct packed_increasing_storage<banded_matrix<T, L, A>, O> {
+        static const bool value = boost::is_same<typename L::orientation_category, O>::value;
+    };
+
+    // Same for the constant elements; unit triangular and symmetric matrices return
+    // elements which are not stored, so they do not qualify.
+    template<class E, class O>
+    struct packed_increasing_const_storage {
+        static const bool value = false;
+    };
+    template<class T, class Z, class L, class A, class O>
+    struct packed_increasing_const_storage<triangular_matrix<T, basic_lower<Z>, L, A>, O> {
+        static const bool value = boost::is_same<typename L::orientation_category, O>::value;
+    };
+    template<class T, class Z, class L, class A, class O>
+    struct packed_increasing_const_storage<triangular_matrix<T, basic_upper<Z>, L, A>, O> {
+        static const bool value = boost::is_same<typename L::orientation_category, O>::value;
+    };
+    template<class T, class L, class A, class O>
+    struct packed_increasing_const_storage<banded_matrix<T, L, A>, O> {
+        static const bool value = boost::is_same<typename L::orientation_category, O>::value;
+    };
+    template<class T, class L, class A, class O>
+    struct packed_increasing_const_storage<matrix<T, L, A>, O> {
+        static const bool value = boost::is_same<typename L::orientation_category, O>::value;
+    };
+
+    // Apply the functor with a zero right hand side to size elements from it
+    template<class FT, class T, class I, class D>
+    BOOST_UBLAS_INLINE
+    void packed_assign_zero (I &it, D size, boost::mpl::false_) {
+        while (-- size >= 0)
+            FT::apply (*it, T/*zero*/()), ++ it;
+    }
+    template<class FT, class T, class I, class D>
+    BOOST_UBLAS_INLINE
+    void packed_assign_zero (I &it, D size, boost::mpl::true_) {
+        if (size > 0) {
+            I last (it);
+            last += size - 1;
+            if (&*last - &*it == size - 1) {
+                std::memset (&*it, 0, size * sizeof (*it));
+                it += size;
+                return;
+            }
+        }
+        packed_assign_zero<FT, T> (it, size, boost::mpl::false_ ());
+    }
+
+    // Apply the functor to size elements from it and ite
+    template<class FT, class I, class IE, class D>
+    BOOST_UBLAS_INLINE
+    void packed_assign (I &it, IE &ite, D size, boost::mpl::false_) {
+        while (-- size >= 0)
+            FT::apply (*it, *ite), ++ it, ++ ite;
+    }
+    template<class FT, class I, class IE, class D>
+    BOOST_UBLAS_INLINE
+    void packed_assign (I &it, IE &ite, D size, boost::mpl::true_) {
+        if (size > 0) {
+            I last (it);
+            IE laste (ite);
+            last += size - 1;
+            laste += size - 1;
+            if (&*last - &*it == size - 1 && &*laste - &*ite == size - 1) {
+                std::memmove (&*it, &*ite, size * sizeof (*it));
+                it += size;
+                ite += size;
+                return;
+            }
+        }
+        packed_assign<FT> (it, ite, size, boost::mpl::false_ ());
+    }
+
+    // Runtime calibrated choice between indexing and iterating evaluation.
+    // Assignments of the class S with at least BOOST_UBLAS_AUTOTUNE_MIN_SIZE elements
+    // alternate between both methods until each one was timed BOOST_UBLAS_AUTOTUNE_CALLS
+    // times; the method with the smaller time per element is then used for all of them.
+    // Smaller assignments are indexed until then. With OpenMP the state is read and
+    // updated in one critical section, so assignments may run in several threads.
+    template<class S>
+    struct autotuned_dispatch {
+        // The method of the next assignment of size elements, and whether to time it
+        static bool iterating (std::size_t size, bool &timed) {
+            bool iterating;
+#ifdef _OPENMP
+#pragma omp critical (ublas_autotuned_dispatch)
+#endif
+            {
+                timed = ! decided_ && size >= BOOST_UBLAS_AUTOTUNE_MIN_SIZE;
+                iterating = timed ? calls_ % 2 == 1 : iterating_;
+            }
+            return iterating;
+        }
+        static void record (bool iterating, std::size_t size, std::clock_t ticks) {
+#ifdef _OPENMP
+#pragma omp critical (ublas_autotuned_dispatch)
+#endif
+            {
+                if (! decided_) {
+                    elements_ [iterating] += size;
+                    seconds_ [iterating] += double (ticks) / CLOCKS_PER_SEC;
+                    if (++ calls_ >= 2 * BOOST_UBLAS_AUTOTUNE_CALLS) {
+                        iterating_ = seconds_ [1] * elements_ [0] < seconds_ [0] * elements_ [1];
+                        decided_ = true;
+                        autotuned_assign_entry entry;
+                        entry.signature = typeid (S).name ();
+                        entry.elements [0] = elements_ [0];
+                        entry.elements [1] = elements_ [1];
+                        entry.seconds [0] = seconds_ [0];
+                        entry.seconds [1] = seconds_ [1];
+                        entry.iterating = iterating_;
+                        autotuned_assign_table ().push_back (entry);
+                    }
+                }
+            }
+        }
+
+    private:
+        static std::size_t calls_;
+        static std::size_t elements_ [2];
+        static double seconds_ [2];
+        static bool decided_;
+        static bool iterating_;
+    };
+    template<class S>
+    std::size_t autotuned_dispatch<S>::calls_ = 0;
+    template<class S>
+    std::size_t autotuned_dispatch<S>::elements_ [2] = {0, 0};
+    template<class S>
+    double autotuned_dispatch<S>::seconds_ [2] = {0., 0.};
+    template<class S>
+    bool autotuned_dispatch<S>::decided_ = false;
+    template<class S>
+    bool autotuned_dispatch<S>::iterating_ = false;
+
+    // Classes of dense assignments calibrated separately
+    template<class M, class T, class F, class C>
+    struct matrix_assign_scalar_signature {};
+    template<class M, class E, class F, class C>
+    struct matrix_assign_signature {};
+
 }//namespace detail
 
 
@@ -344,13 +898,81 @@ namespace detail {
 #endif
         }
     }
+#if defined (BOOST_UBLAS_PARALLEL_ASSIGN) && defined (_OPENMP)
+    // Parallel indexing row major
+    // Rows are statically partitioned among the threads; each element is computed as in
+    // the sequential case.
+    template<template <class T1, class T2> class F, class M, class T>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void parallel_indexing_matrix_assign_scalar (M &m, const T &t, row_major_tag) {
+        typedef F<typename M::reference, T> functor_type;
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        difference_type size1 (m.size1 ());
+        size_type size2 (m.size2 ());
+#pragma omp parallel for schedule(static)
+        for (difference_type i = 0; i < size1; ++ i) {
+            for (size_type j = 0; j < size2; ++ j)
+                functor_type::apply (m (i, j), t);
+        }
+    }
+    // Parallel indexing column major
+    template<template <class T1, class T2> class F, class M, class T>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void parallel_indexing_matrix_assign_scalar (M &m, const T &t, column_major_tag) {
+        typedef F<typename M::reference, T> functor_type;
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        difference_type size2 (m.size2 ());
+        size_type size1 (m.size1 ());
+#pragma omp parallel for schedule(static)
+        for (difference_type j = 0; j < size2; ++ j) {
+            for (size_type i = 0; i < size1; ++ i)
+                functor_type::apply (m (i, j), t);
+        }
+    }
+#endif
+
+    // Autotuned
+    template<template <class T1, class T2> class F, class M, class T, class C>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void autotuned_matrix_assign_scalar (M &m, const T &t, C) {
+        typedef detail::autotuned_dispatch<detail::matrix_assign_scalar_signature<M, T, F<typename M::reference, T>, C> > dispatch_type;
+        std::size_t size (m.size1 () * m.size2 ());
+        bool timed;
+        bool iterating (dispatch_type::iterating (size, timed));
+        std::clock_t start (timed ? std::clock () : 0);
+        if (iterating)
+            iterating_matrix_assign_scalar<F> (m, t, C ());
+        else
+            indexing_matrix_assign_scalar<F> (m, t, C ());
+        if (timed)
+            dispatch_type::record (iterating, size, std::clock () - start);
+    }
 
     // Dense (proxy) case
     template<template <class T1, class T2> class F, class M, class T, class C>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void matrix_assign_scalar (M &m, const T &t, dense_proxy_tag, C) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_matrix_assign_scalar_dense_proxy, (F<typename M::reference, T>::computed), m.size1 () * m.size2 ());
         typedef C orientation_category;
-#ifdef BOOST_UBLAS_USE_INDEXING
+#ifdef BOOST_UBLAS_STREAMING_STORES
+        if (detail::stream_matrix_assign_scalar<F> (m, t, BOOST_UBLAS_STREAMING_THRESHOLD))
+            return;
+#endif
+#ifdef BOOST_UBLAS_SIMD
+        if (detail::simd_matrix_assign_scalar<F> (m, t))
+            return;
+#endif
+#if defined (BOOST_UBLAS_PARALLEL_ASSIGN) && defined (_OPENMP)
+        if (m.size1 () * m.size2 () >= BOOST_UBLAS_PARALLEL_ASSIGN_THRESHOLD) {
+            parallel_indexing_matrix_assign_scalar<F> (m, t, orientation_category ());
+            return;
+        }
+#endif
+#ifdef BOOST_UBLAS_AUTOTUNED_ASSIGN
+        autotuned_matrix_assign_scalar<F> (m, t, orientation_category ());
+#elif defined (BOOST_UBLAS_USE_INDEXING)
         indexing_matrix_assign_scalar<F> (m, t, orientation_category ());
 #elif BOOST_UBLAS_USE_ITERATING
         iterating_matrix_assign_scalar<F> (m, t, orientation_category ());
@@ -369,6 +991,7 @@ namespace detail {
     template<template <class T1, class T2> class F, class M, class T>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void matrix_assign_scalar (M &m, const T &t, packed_proxy_tag, row_major_tag) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_matrix_assign_scalar_packed_proxy_row_major, (F<typename M::reference, T>::computed), m.size1 () * m.size2 ());
         typedef F<typename M::iterator2::reference, T> functor_type;
         typedef typename M::difference_type difference_type;
         typename M::iterator1 it1 (m.begin1 ());
@@ -390,6 +1013,7 @@ namespace detail {
     template<template <class T1, class T2> class F, class M, class T>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void matrix_assign_scalar (M &m, const T &t, packed_proxy_tag, column_major_tag) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_matrix_assign_scalar_packed_proxy_column_major, (F<typename M::reference, T>::computed), m.size1 () * m.size2 ());
         typedef F<typename M::iterator1::reference, T> functor_type;
         typedef typename M::difference_type difference_type;
         typename M::iterator2 it2 (m.begin2 ());
@@ -411,6 +1035,7 @@ namespace detail {
     template<template <class T1, class T2> class F, class M, class T>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void matrix_assign_scalar (M &m, const T &t, sparse_proxy_tag, row_major_tag) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_matrix_assign_scalar_sparse_proxy_row_major, (F<typename M::reference, T>::computed), m.size1 () * m.size2 ());
         typedef F<typename M::iterator2::reference, T> functor_type;
         typename M::iterator1 it1 (m.begin1 ());
         typename M::iterator1 it1_end (m.end1 ());
@@ -431,6 +1056,7 @@ namespace detail {
     template<template <class T1, class T2> class F, class M, class T>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void matrix_assign_scalar (M &m, const T &t, sparse_proxy_tag, column_major_tag) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_matrix_assign_scalar_sparse_proxy_column_major, (F<typename M::reference, T>::computed), m.size1 () * m.size2 ());
         typedef F<typename M::iterator1::reference, T> functor_type;
         typename M::iterator2 it2 (m.begin2 ());
         typename M::iterator2 it2_end (m.end2 ());
@@ -611,14 +1237,335 @@ namespace detail {
 #endif
         }
     }
+#if defined (BOOST_UBLAS_PARALLEL_ASSIGN) && defined (_OPENMP)
+    // Parallel indexing row major
+    // Rows are statically partitioned among the threads; each element is computed as in
+    // the sequential case, so the result does not depend on the number of threads.
+    template<template <class T1, class T2> class F, class M, class E>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void parallel_indexing_matrix_assign (M &m, const matrix_expression<E> &e, row_major_tag) {
+        typedef F<typename M::reference, typename E::value_type> functor_type;
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        difference_type size1 (BOOST_UBLAS_SAME (m.size1 (), e ().size1 ()));
+        size_type size2 (BOOST_UBLAS_SAME (m.size2 (), e ().size2 ()));
+#pragma omp parallel for schedule(static)
+        for (difference_type i = 0; i < size1; ++ i) {
+            for (size_type j = 0; j < size2; ++ j)
+                functor_type::apply (m (i, j), e () (i, j));
+        }
+    }
+    // Parallel indexing column major
+    template<template <class T1, class T2> class F, class M, class E>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void parallel_indexing_matrix_assign (M &m, const matrix_expression<E> &e, column_major_tag) {
+        typedef F<typename M::reference, typename E::value_type> functor_type;
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        difference_type size2 (BOOST_UBLAS_SAME (m.size2 (), e ().size2 ()));
+        size_type size1 (BOOST_UBLAS_SAME (m.size1 (), e ().size1 ()));
+#pragma omp parallel for schedule(static)
+        for (difference_type j = 0; j < size2; ++ j) {
+            for (size_type i = 0; i < size1; ++ i)
+                functor_type::apply (m (i, j), e () (i, j));
+        }
+    }
+#endif
+
+    // Blocked row major from column major
+    // Square tiles are assigned one after the other, so that the strided side is walked
+    // over a few cache lines only. Inside a tile 4x4 sub-blocks are read in the order of
+    // e and written in the order of m through a local buffer.
+    template<template <class T1, class T2> class F, class M, class E>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void blocked_matrix_assign (M &m, const matrix_expression<E> &e, row_major_tag) {
+        typedef F<typename M::reference, typename E::value_type> functor_type;
+        typedef typename E::value_type expr_value_type;
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        const size_type block = BOOST_UBLAS_TRANSPOSE_BLOCK_SIZE;
+        size_type size1 (BOOST_UBLAS_SAME (m.size1 (), e ().size1 ()));
+        size_type size2 (BOOST_UBLAS_SAME (m.size2 (), e ().size2 ()));
+        difference_type blocks1 ((size1 + block - 1) / block);
+#if defined (BOOST_UBLAS_PARALLEL_ASSIGN) && defined (_OPENMP)
+#pragma omp parallel for schedule(static) if (size1 * size2 >= BOOST_UBLAS_PARALLEL_ASSIGN_THRESHOLD)
+#endif
+        for (difference_type ib = 0; ib < blocks1; ++ ib) {
+            size_type i_begin (ib * block);
+            size_type i_end ((std::min) (i_begin + block, size1));
+            for (size_type j_begin = 0; j_begin < size2; j_begin += block) {
+                size_type j_end ((std::min) (j_begin + block, size2));
+                size_type i (i_begin);
+                for (; i + 4 <= i_end; i += 4) {
+                    size_type j (j_begin);
+                    for (; j + 4 <= j_end; j += 4) {
+                        expr_value_type t [4] [4];
+                        for (size_type jj = 0; jj < 4; ++ jj)
+                            for (size_type ii = 0; ii < 4; ++ ii)
+                                t [ii] [jj] = e () (i + ii, j + jj);
+                        for (size_type ii = 0; ii < 4; ++ ii)
+                            for (size_type jj = 0; jj < 4; ++ jj)
+                                functor_type::apply (m (i + ii, j + jj), t [ii] [jj]);
+                    }
+                    for (; j < j_end; ++ j)
+                        for (size_type ii = 0; ii < 4; ++ ii)
+                            functor_type::apply (m (i + ii, j), e () (i + ii, j));
+                }
+                for (; i < i_end; ++ i)
+                    for (size_type j = j_begin; j < j_end; ++ j)
+                        functor_type::apply (m (i, j), e () (i, j));
+            }
+        }
+    }
+    // Blocked column major from row major
+    template<template <class T1, class T2> class F, class M, class E>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void blocked_matrix_assign (M &m, const matrix_expression<E> &e, column_major_tag) {
+        typedef F<typename M::reference, typename E::value_type> functor_type;
+        typedef typename E::value_type expr_value_type;
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        const size_type block = BOOST_UBLAS_TRANSPOSE_BLOCK_SIZE;
+        size_type size2 (BOOST_UBLAS_SAME (m.size2 (), e ().size2 ()));
+        size_type size1 (BOOST_UBLAS_SAME (m.size1 (), e ().size1 ()));
+        difference_type blocks2 ((size2 + block - 1) / block);
+#if defined (BOOST_UBLAS_PARALLEL_ASSIGN) && defined (_OPENMP)
+#pragma omp parallel for schedule(static) if (size1 * size2 >= BOOST_UBLAS_PARALLEL_ASSIGN_THRESHOLD)
+#endif
+        for (difference_type jb = 0; jb < blocks2; ++ jb) {
+            size_type j_begin (jb * block);
+            size_type j_end ((std::min) (j_begin + block, size2));
+            for (size_type i_begin = 0; i_begin < size1; i_begin += block) {
+                size_type i_end ((std::min) (i_begin + block, size1));
+                size_type j (j_begin);
+                for (; j + 4 <= j_end; j += 4) {
+                    size_type i (i_begin);
+                    for (; i + 4 <= i_end; i += 4) {
+                        expr_value_type t [4] [4];
+                        for (size_type ii = 0; ii < 4; ++ ii)
+                            for (size_type jj = 0; jj < 4; ++ jj)
+                                t [jj] [ii] = e () (i + ii, j + jj);
+                        for (size_type jj = 0; jj < 4; ++ jj)
+                            for (size_type ii = 0; ii < 4; ++ ii)
+                                functor_type::apply (m (i + ii, j + jj), t [jj] [ii]);
+                    }
+                    for (; i < i_end; ++ i)
+                        for (size_type jj = 0; jj < 4; ++ jj)
+                            functor_type::apply (m (i, j + jj), e () (i, j + jj));
+                }
+                for (; j < j_end; ++ j)
+                    for (size_type i = i_begin; i < i_end; ++ i)
+                        functor_type::apply (m (i, j), e () (i, j));
+            }
+        }
+    }
+
+    // Select the blocked assignment when m and e have opposite orientations
+    template<template <class T1, class T2> class F, class M, class E, class C, class EC>
+    BOOST_UBLAS_INLINE
+    bool transposing_matrix_assign (M &, const matrix_expression<E> &, C, EC) {
+        return false;
+    }
+    template<template <class T1, class T2> class F, class M, class E>
+    BOOST_UBLAS_INLINE
+    bool transposing_matrix_assign (M &m, const matrix_expression<E> &e, row_major_tag, column_major_tag) {
+        if (BOOST_UBLAS_TRANSPOSE_BLOCK_SIZE == 0 ||
+            m.size1 () < BOOST_UBLAS_TRANSPOSE_BLOCK_SIZE || m.size2 () < BOOST_UBLAS_TRANSPOSE_BLOCK_SIZE)
+            return false;
+        blocked_matrix_assign<F> (m, e, row_major_tag ());
+        return true;
+    }
+    template<template <class T1, class T2> class F, class M, class E>
+    BOOST_UBLAS_INLINE
+    bool transposing_matrix_assign (M &m, const matrix_expression<E> &e, column_major_tag, row_major_tag) {
+        if (BOOST_UBLAS_TRANSPOSE_BLOCK_SIZE == 0 ||
+            m.size1 () < BOOST_UBLAS_TRANSPOSE_BLOCK_SIZE || m.size2 () < BOOST_UBLAS_TRANSPOSE_BLOCK_SIZE)
+            return false;
+        blocked_matrix_assign<F> (m, e, column_major_tag ());
+        return true;
+    }
+
+    // Recursive (cache oblivious): the index space is halved along its longer side down
+    // to tiles of at most BOOST_UBLAS_RECURSIVE_TILE_SIZE squared elements, which are
+    // traversed in the orientation of m. The tiles are visited in Z-order, so that at
+    // every scale the operands are read in blocks which fit the caches whatever their
+    // orientations.
+    template<template <class T1, class T2> class F, class M, class E, class C>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void recursive_matrix_assign (M &m, const matrix_expression<E> &e,
+                                  typename M::size_type i_begin, typename M::size_type i_end,
+                                  typename M::size_type j_begin, typename M::size_type j_end, C) {
+        typedef F<typename M::reference, typename E::value_type> functor_type;
+        typedef typename M::size_type size_type;
+        const size_type tile = BOOST_UBLAS_RECURSIVE_TILE_SIZE;
+        size_type size1 (i_end - i_begin), size2 (j_end - j_begin);
+        if (size1 > tile || size2 > tile) {
+            if (size1 >= size2) {
+                size_type i_middle (i_begin + size1 / 2);
+                recursive_matrix_assign<F> (m, e, i_begin, i_middle, j_begin, j_end, C ());
+                recursive_matrix_assign<F> (m, e, i_middle, i_end, j_begin, j_end, C ());
+            } else {
+                size_type j_middle (j_begin + size2 / 2);
+                recursive_matrix_assign<F> (m, e, i_begin, i_end, j_begin, j_middle, C ());
+                recursive_matrix_assign<F> (m, e, i_begin, i_end, j_middle, j_end, C ());
+            }
+            return;
+        }
+        if (boost::is_same<C, column_major_tag>::value) {
+            for (size_type j = j_begin; j < j_end; ++ j)
+                for (size_type i = i_begin; i < i_end; ++ i)
+                    functor_type::apply (m (i, j), e () (i, j));
+        } else {
+            for (size_type i = i_begin; i < i_end; ++ i)
+                for (size_type j = j_begin; j < j_end; ++ j)
+                    functor_type::apply (m (i, j), e () (i, j));
+        }
+    }
+
+namespace detail {
+
+    // Orientation of the operands of an element wise matrix expression. matrix_binary
+    // reports unknown_orientation_tag whatever its operands are, so the orientations
+    // are collected from the operands: mixed_orientation_tag if they differ.
+    // Any other expression (products in particular) keeps its own orientation_category.
+    struct mixed_orientation_tag {};
+
+    template<class O1, class O2>
+    struct operand_orientation_join {
+        typedef mixed_orientation_tag type;
+    };
+    template<class O>
+    struct operand_orientation_join<O, O> {
+        typedef O type;
+    };
+    template<class O>
+    struct operand_orientation_join<unknown_orientation_tag, O> {
+        typedef unknown_orientation_tag type;
+    };
+    template<class O>
+    struct operand_orientation_join<O, unknown_orientation_tag> {
+        typedef unknown_orientation_tag type;
+    };
+    template<>
+    struct operand_orientation_join<unknown_orientation_tag, unknown_orientation_tag> {
+        typedef unknown_orientation_tag type;
+    };
+
+    template<class O>
+    struct operand_orientation_transposed {
+        typedef O type;
+    };
+    template<>
+    struct operand_orientation_transposed<row_major_tag> {
+        typedef column_major_tag type;
+    };
+    template<>
+    struct operand_orientation_transposed<column_major_tag> {
+        typedef row_major_tag type;
+    };
+
+    template<class E>
+    struct operand_orientation {
+        typedef typename E::orientation_category type;
+    };
+    template<class E>
+    struct operand_orientation<const E>:
+        operand_orientation<E> {};
+    template<class E>
+    struct operand_orientation<matrix_reference<E> >:
+        operand_orientation<E> {};
+    template<class E, class F>
+    struct operand_orientation<matrix_unary1<E, F> >:
+        operand_orientation<E> {};
+    template<class E, class F>
+    struct operand_orientation<matrix_unary2<E, F> >:
+        operand_orientation_transposed<typename operand_orientation<E>::type> {};
+    template<class E1, class E2, class F>
+    struct operand_orientation<matrix_binary<E1, E2, F> >:
+        operand_orientation_join<typename operand_orientation<E1>::type,
+                                 typename operand_orientation<E2>::type> {};
+    template<class E1, class E2, class F>
+    struct operand_orientation<matrix_binary_scalar1<E1, E2, F> >:
+        operand_orientation<E2> {};
+    template<class E1, class E2, class F>
+    struct operand_orientation<matrix_binary_scalar2<E1, E2, F> >:
+        operand_orientation<E1> {};
+
+}
+
+    // Select the recursive assignment when the operands of e have different orientations
+    template<template <class T1, class T2> class F, class M, class E, class C, class EC>
+    BOOST_UBLAS_INLINE
+    bool recursive_matrix_assign (M &, const matrix_expression<E> &, C, EC) {
+        return false;
+    }
+    template<template <class T1, class T2> class F, class M, class E, class C>
+    BOOST_UBLAS_INLINE
+    bool recursive_matrix_assign (M &m, const matrix_expression<E> &e, C, detail::mixed_orientation_tag) {
+        typedef typename M::size_type size_type;
+        if (BOOST_UBLAS_RECURSIVE_TILE_SIZE == 0 ||
+            m.size1 () < BOOST_UBLAS_RECURSIVE_TILE_SIZE || m.size2 () < BOOST_UBLAS_RECURSIVE_TILE_SIZE)
+            return false;
+        size_type size1 (BOOST_UBLAS_SAME (m.size1 (), e ().size1 ()));
+        size_type size2 (BOOST_UBLAS_SAME (m.size2 (), e ().size2 ()));
+        recursive_matrix_assign<F> (m, e, size_type (0), size1, size_type (0), size2, C ());
+        return true;
+    }
+
+    // Autotuned
+    template<template <class T1, class T2> class F, class M, class E, class C>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void autotuned_matrix_assign (M &m, const matrix_expression<E> &e, C) {
+        typedef detail::autotuned_dispatch<detail::matrix_assign_signature<M, E, F<typename M::reference, typename E::value_type>, C> > dispatch_type;
+        std::size_t size (m.size1 () * m.size2 ());
+        bool timed;
+        bool iterating (dispatch_type::iterating (size, timed));
+        std::clock_t start (timed ? std::clock () : 0);
+        if (iterating)
+            iterating_matrix_assign<F> (m, e, C ());
+        else
+            indexing_matrix_assign<F> (m, e, C ());
+        if (timed)
+            dispatch_type::record (iterating, size, std::clock () - start);
+    }
 
     // Dense (proxy) case
     template<template <class T1, class T2> class F, class R, class M, class E, class C>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void matrix_assign (M &m, const matrix_expression<E> &e, dense_proxy_tag, C) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_matrix_assign_dense_proxy, (F<typename M::reference, typename E::value_type>::computed), m.size1 () * m.size2 ());
         // R unnecessary, make_conformant not required
         typedef C orientation_category;
-#ifdef BOOST_UBLAS_USE_INDEXING
+#ifdef BOOST_UBLAS_CBLAS
+        if (detail::cblas_matrix_assign<F> (m, e ()))
+            return;
+#endif
+#ifdef BOOST_UBLAS_GEMM
+        if (detail::gemm_matrix_assign<F> (m, e ()))
+            return;
+#endif
+#ifdef BOOST_UBLAS_STREAMING_STORES
+        if (detail::stream_matrix_assign<F> (m, e, BOOST_UBLAS_STREAMING_THRESHOLD))
+            return;
+#endif
+#ifdef BOOST_UBLAS_SIMD
+        if (detail::simd_matrix_assign<F> (m, e ()))
+            return;
+#endif
+        if (transposing_matrix_assign<F> (m, e, orientation_category (), typename E::orientation_category ()))
+            return;
+#if defined (BOOST_UBLAS_PARALLEL_ASSIGN) && defined (_OPENMP)
+        if (m.size1 () * m.size2 () >= BOOST_UBLAS_PARALLEL_ASSIGN_THRESHOLD) {
+            parallel_indexing_matrix_assign<F> (m, e, orientation_category ());
+            return;
+        }
+#endif
+#ifdef BOOST_UBLAS_AUTOTUNED_ASSIGN
+        autotuned_matrix_assign<F> (m, e, orientation_category ());
+#else
+        if (recursive_matrix_assign<F> (m, e, orientation_category (), typename detail::operand_orientation<E>::type ()))
+            return;
+#if defined (BOOST_UBLAS_USE_INDEXING)
         indexing_matrix_assign<F> (m, e, orientation_category ());
 #elif BOOST_UBLAS_USE_ITERATING
         iterating_matrix_assign<F> (m, e, orientation_category ());
@@ -631,23 +1578,39 @@ namespace detail {
             iterating_matrix_assign<F> (m, e, orientation_category ());
         else
             indexing_matrix_assign<F> (m, e, orientation_category ());
+#endif
 #endif
     }
     // Packed (proxy) row major case
     template<template <class T1, class T2> class F, class R, class M, class E>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void matrix_assign (M &m, const matrix_expression<E> &e, packed_proxy_tag, row_major_tag) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_matrix_assign_packed_proxy_row_major, (F<typename M::reference, typename E::value_type>::computed), m.size1 () * m.size2 ());
         typedef typename matrix_traits<E>::value_type expr_value_type;
         typedef F<typename M::iterator2::reference, expr_value_type> functor_type;
         // R unnecessary, make_conformant not required
         typedef typename M::difference_type difference_type;
         typedef typename M::value_type value_type;
+        // Bulk zeroing and copying of contiguous runs for plain assignment
+        typedef boost::mpl::bool_<detail::simd_op<F>::value == detail::simd_op_assign &&
+                                  detail::packed_increasing_storage<M, row_major_tag>::value &&
+                                  boost::is_arithmetic<value_type>::value> bulk_zero_type;
+        typedef boost::mpl::bool_<detail::simd_op<F>::value == detail::simd_op_assign &&
+                                  detail::packed_increasing_storage<M, row_major_tag>::value &&
+                                  detail::packed_increasing_const_storage<E, row_major_tag>::value &&
+                                  boost::is_same<value_type, expr_value_type>::value &&
+                                  boost::has_trivial_assign<value_type>::value> bulk_copy_type;
         BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
         BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
 #if BOOST_UBLAS_TYPE_CHECK
+#if BOOST_UBLAS_TYPE_CHECK_SAMPLES
+        detail::matrix_type_check_sample<value_type> cm;
+        cm.template assign<F> (m, e);
+#else
         matrix<value_type, row_major> cm (m.size1 (), m.size2 ());
         indexing_matrix_assign<scalar_assign> (cm, m, row_major_tag ());
         indexing_matrix_assign<F> (cm, e, row_major_tag ());
+#endif
 #endif
         typename M::iterator1 it1 (m.begin1 ());
         typename M::iterator1 it1_end (m.end1 ());
@@ -678,8 +1641,7 @@ namespace detail {
                         typename M::iterator2 it2_end (end (it1, iterator1_tag ()));
 #endif
                         difference_type size2 (it2_end - it2);
-                        while (-- size2 >= 0)
-                            functor_type::apply (*it2, expr_value_type/*zero*/()), ++ it2;
+                        detail::packed_assign_zero<functor_type, expr_value_type> (it2, size2, bulk_zero_type ());
                         ++ it1;
                     }
                 } else {
@@ -718,8 +1680,8 @@ namespace detail {
                 if (size2 > 0) {
                     it2_size -= size2;
                     if (!functor_type::computed) {
-                        while (-- size2 >= 0)   // zeroing
-                            functor_type::apply (*it2, expr_value_type/*zero*/()), ++ it2;
+                        // zeroing
+                        detail::packed_assign_zero<functor_type, expr_value_type> (it2, size2, bulk_zero_type ());
                     } else {
                         it2 += size2;
                     }
@@ -729,12 +1691,11 @@ namespace detail {
             difference_type size2 ((std::min) (it2_size, it2e_size));
             it2_size -= size2;
             it2e_size -= size2;
-            while (-- size2 >= 0)
-                functor_type::apply (*it2, *it2e), ++ it2, ++ it2e;
+            detail::packed_assign<functor_type> (it2, it2e, size2, bulk_copy_type ());
             size2 = it2_size;
             if (!functor_type::computed) {
-                while (-- size2 >= 0)   // zeroing
-                    functor_type::apply (*it2, expr_value_type/*zero*/()), ++ it2;
+                // zeroing
+                detail::packed_assign_zero<functor_type, expr_value_type> (it2, size2, bulk_zero_type ());
             } else {
                 it2 += size2;
             }
@@ -751,8 +1712,7 @@ namespace detail {
                 typename M::iterator2 it2_end (end (it1, iterator1_tag ()));
 #endif
                 difference_type size2 (it2_end - it2);
-                while (-- size2 >= 0)
-                    functor_type::apply (*it2, expr_value_type/*zero*/()), ++ it2;
+                detail::packed_assign_zero<functor_type, expr_value_type> (it2, size2, bulk_zero_type ());
                 ++ it1;
             }
         } else {
@@ -767,17 +1727,32 @@ namespace detail {
     template<template <class T1, class T2> class F, class R, class M, class E>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void matrix_assign (M &m, const matrix_expression<E> &e, packed_proxy_tag, column_major_tag) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_matrix_assign_packed_proxy_column_major, (F<typename M::reference, typename E::value_type>::computed), m.size1 () * m.size2 ());
         typedef typename matrix_traits<E>::value_type expr_value_type;
         typedef F<typename M::iterator1::reference, expr_value_type> functor_type;
         // R unnecessary, make_conformant not required
         typedef typename M::difference_type difference_type;
         typedef typename M::value_type value_type;
+        // Bulk zeroing and copying of contiguous runs for plain assignment
+        typedef boost::mpl::bool_<detail::simd_op<F>::value == detail::simd_op_assign &&
+                                  detail::packed_increasing_storage<M, column_major_tag>::value &&
+                                  boost::is_arithmetic<value_type>::value> bulk_zero_type;
+        typedef boost::mpl::bool_<detail::simd_op<F>::value == detail::simd_op_assign &&
+                                  detail::packed_increasing_storage<M, column_major_tag>::value &&
+                                  detail::packed_increasing_const_storage<E, column_major_tag>::value &&
+                                  boost::is_same<value_type, expr_value_type>::value &&
+                                  boost::has_trivial_assign<value_type>::value> bulk_copy_type;
         BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
         BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
 #if BOOST_UBLAS_TYPE_CHECK
+#if BOOST_UBLAS_TYPE_CHECK_SAMPLES
+        detail::matrix_type_check_sample<value_type> cm;
+        cm.template assign<F> (m, e);
+#else
         matrix<value_type, column_major> cm (m.size1 (), m.size2 ());
         indexing_matrix_assign<scalar_assign> (cm, m, column_major_tag ());
         indexing_matrix_assign<F> (cm, e, column_major_tag ());
+#endif
 #endif
         typename M::iterator2 it2 (m.begin2 ());
         typename M::iterator2 it2_end (m.end2 ());
@@ -808,8 +1783,7 @@ namespace detail {
                         typename M::iterator1 it1_end (end (it2, iterator2_tag ()));
 #endif
                         difference_type size1 (it1_end - it1);
-                        while (-- size1 >= 0)
-                            functor_type::apply (*it1, expr_value_type/*zero*/()), ++ it1;
+                        detail::packed_assign_zero<functor_type, expr_value_type> (it1, size1, bulk_zero_type ());
                         ++ it2;
                     }
                 } else {
@@ -848,8 +1822,8 @@ namespace detail {
                 if (size1 > 0) {
                     it1_size -= size1;
                     if (!functor_type::computed) {
-                        while (-- size1 >= 0)   // zeroing
-                            functor_type::apply (*it1, expr_value_type/*zero*/()), ++ it1;
+                        // zeroing
+                        detail::packed_assign_zero<functor_type, expr_value_type> (it1, size1, bulk_zero_type ());
                     } else {
                         it1 += size1;
                     }
@@ -859,12 +1833,11 @@ namespace detail {
             difference_type size1 ((std::min) (it1_size, it1e_size));
             it1_size -= size1;
             it1e_size -= size1;
-            while (-- size1 >= 0)
-                functor_type::apply (*it1, *it1e), ++ it1, ++ it1e;
+            detail::packed_assign<functor_type> (it1, it1e, size1, bulk_copy_type ());
             size1 = it1_size;
             if (!functor_type::computed) {
-                while (-- size1 >= 0)   // zeroing
-                    functor_type::apply (*it1, expr_value_type/*zero*/()), ++ it1;
+                // zeroing
+                detail::packed_assign_zero<functor_type, expr_value_type> (it1, size1, bulk_zero_type ());
             } else {
                 it1 += size1;
             }
@@ -881,8 +1854,7 @@ namespace detail {
                 typename M::iterator1 it1_end (end (it2, iterator2_tag ()));
 #endif
                 difference_type size1 (it1_end - it1);
-                while (-- size1 >= 0)
-                    functor_type::apply (*it1, expr_value_type/*zero*/()), ++ it1;
+                detail::packed_assign_zero<functor_type, expr_value_type> (it1, size1, bulk_zero_type ());
                 ++ it2;
             }
         } else {
@@ -897,6 +1869,7 @@ namespace detail {
     template<template <class T1, class T2> class F, class R, class M, class E>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void matrix_assign (M &m, const matrix_expression<E> &e, sparse_tag, row_major_tag) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_matrix_assign_sparse_row_major, (F<typename M::reference, typename E::value_type>::computed), m.size1 () * m.size2 ());
         typedef F<typename M::iterator2::reference, typename E::value_type> functor_type;
         // R unnecessary, make_conformant not required
         BOOST_STATIC_ASSERT ((!functor_type::computed));
@@ -929,6 +1902,7 @@ namespace detail {
     template<template <class T1, class T2> class F, class R, class M, class E>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void matrix_assign (M &m, const matrix_expression<E> &e, sparse_tag, column_major_tag) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_matrix_assign_sparse_column_major, (F<typename M::reference, typename E::value_type>::computed), m.size1 () * m.size2 ());
         typedef F<typename M::iterator1::reference, typename E::value_type> functor_type;
         // R unnecessary, make_conformant not required
         BOOST_STATIC_ASSERT ((!functor_type::computed));
@@ -961,6 +1935,7 @@ namespace detail {
     template<template <class T1, class T2> class F, class R, class M, class E>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void matrix_assign (M &m, const matrix_expression<E> &e, sparse_proxy_tag, row_major_tag) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_matrix_assign_sparse_proxy_row_major, (F<typename M::reference, typename E::value_type>::computed), m.size1 () * m.size2 ());
         typedef typename matrix_traits<E>::value_type expr_value_type;
         typedef F<typename M::iterator2::reference, expr_value_type> functor_type;
         typedef R conformant_restrict_type;
@@ -970,9 +1945,14 @@ namespace detail {
         BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
         BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
 #if BOOST_UBLAS_TYPE_CHECK
+#if BOOST_UBLAS_TYPE_CHECK_SAMPLES
+        detail::matrix_type_check_sample<value_type> cm;
+        cm.template assign<F> (m, e);
+#else
         matrix<value_type, row_major> cm (m.size1 (), m.size2 ());
         indexing_matrix_assign<scalar_assign> (cm, m, row_major_tag ());
         indexing_matrix_assign<F> (cm, e, row_major_tag ());
+#endif
 #endif
         detail::make_conformant (m, e, row_major_tag (), conformant_restrict_type ());
 
@@ -994,6 +1974,9 @@ namespace detail {
                 typename E::const_iterator2 it2e (begin (it1e, iterator1_tag ()));
                 typename E::const_iterator2 it2e_end (end (it1e, iterator1_tag ()));
 #endif
+                detail::gallop_row_lookup<M> lookup (m, it1.index1 ());
+                detail::gallop_row_lookup<const E> lookupe (e (), it1e.index1 ());
+                std::size_t steps = 0, stepse = 0;
                 if (it2 != it2_end && it2e != it2e_end) {
                     size_type it2_index = it2.index2 (), it2e_index = it2e.index2 ();
                     while (true) {
@@ -1001,6 +1984,7 @@ namespace detail {
                         if (compare == 0) {
                             functor_type::apply (*it2, *it2e);
                             ++ it2, ++ it2e;
+                            steps = stepse = 0;
                             if (it2 != it2_end && it2e != it2e_end) {
                                 it2_index = it2.index2 ();
                                 it2e_index = it2e.index2 ();
@@ -1011,13 +1995,15 @@ namespace detail {
                                 functor_type::apply (*it2, expr_value_type/*zero*/());
                                 ++ it2;
                             } else
-                                increment (it2, it2_end, - compare);
+                                detail::gallop_increment (it2, it2_end, - compare, it2e_index, steps, lookup);
+                            stepse = 0;
                             if (it2 != it2_end)
                                 it2_index = it2.index2 ();
                             else
                                 break;
                         } else if (compare > 0) {
-                            increment (it2e, it2e_end, compare);
+                            detail::gallop_increment (it2e, it2e_end, compare, it2_index, stepse, lookupe);
+                            steps = 0;
                             if (it2e != it2e_end)
                                 it2e_index = it2e.index2 ();
                             else
@@ -1082,6 +2068,7 @@ namespace detail {
     template<template <class T1, class T2> class F, class R, class M, class E>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void matrix_assign (M &m, const matrix_expression<E> &e, sparse_proxy_tag, column_major_tag) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_matrix_assign_sparse_proxy_column_major, (F<typename M::reference, typename E::value_type>::computed), m.size1 () * m.size2 ());
         typedef typename matrix_traits<E>::value_type expr_value_type;
         typedef F<typename M::iterator1::reference, expr_value_type> functor_type;
         typedef R conformant_restrict_type;
@@ -1091,9 +2078,14 @@ namespace detail {
         BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
         BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
 #if BOOST_UBLAS_TYPE_CHECK
+#if BOOST_UBLAS_TYPE_CHECK_SAMPLES
+        detail::matrix_type_check_sample<value_type> cm;
+        cm.template assign<F> (m, e);
+#else
         matrix<value_type, column_major> cm (m.size1 (), m.size2 ());
         indexing_matrix_assign<scalar_assign> (cm, m, column_major_tag ());
         indexing_matrix_assign<F> (cm, e, column_major_tag ());
+#endif
 #endif
         detail::make_conformant (m, e, column_major_tag (), conformant_restrict_type ());
 
@@ -1115,6 +2107,9 @@ namespace detail {
                 typename E::const_iterator1 it1e (begin (it2e, iterator2_tag ()));
                 typename E::const_iterator1 it1e_end (end (it2e, iterator2_tag ()));
 #endif
+                detail::gallop_column_lookup<M> lookup (m, it2.index2 ());
+                detail::gallop_column_lookup<const E> lookupe (e (), it2e.index2 ());
+                std::size_t steps = 0, stepse = 0;
                 if (it1 != it1_end && it1e != it1e_end) {
                     size_type it1_index = it1.index1 (), it1e_index = it1e.index1 ();
                     while (true) {
@@ -1122,6 +2117,7 @@ namespace detail {
                         if (compare == 0) {
                             functor_type::apply (*it1, *it1e);
                             ++ it1, ++ it1e;
+                            steps = stepse = 0;
                             if (it1 != it1_end && it1e != it1e_end) {
                                 it1_index = it1.index1 ();
                                 it1e_index = it1e.index1 ();
@@ -1132,13 +2128,15 @@ namespace detail {
                                 functor_type::apply (*it1, expr_value_type/*zero*/()); // zeroing
                                 ++ it1;
                             } else
-                                increment (it1, it1_end, - compare);
+                                detail::gallop_increment (it1, it1_end, - compare, it1e_index, steps, lookup);
+                            stepse = 0;
                             if (it1 != it1_end)
                                 it1_index = it1.index1 ();
                             else
                                 break;
                         } else if (compare > 0) {
-                            increment (it1e, it1e_end, compare);
+                            detail::gallop_increment (it1e, it1e_end, compare, it1_index, stepse, lookupe);
+                            steps = 0;
                             if (it1e != it1e_end)
                                 it1e_index = it1e.index1 ();
                             else
@@ -1230,6 +2228,20 @@ namespace detail {
         matrix_assign<F, conformant_restrict_type> (m, e, storage_category (), orientation_category ());
     }
 
+    // Plain assignment with non temporal stores whatever the size, as noalias (m) = e
+    template<class M, class E>
+    BOOST_UBLAS_INLINE
+    void streaming_matrix_assign (M &m, const matrix_expression<E> &e) {
+        if (! detail::stream_matrix_assign<scalar_assign> (m, e, 0))
+            matrix_assign<scalar_assign> (m, e);
+    }
+    template<class M, class T>
+    BOOST_UBLAS_INLINE
+    void streaming_matrix_assign_scalar (M &m, const T &t) {
+        if (! detail::stream_matrix_assign_scalar<scalar_assign> (m, t, 0))
+            matrix_assign_scalar<scalar_assign> (m, t);
+    }
+
     template<class SC, class RI1, class RI2>
     struct matrix_swap_traits {
         typedef SC storage_category;
@@ -1253,6 +2265,10 @@ namespace detail {
         // R unnecessary, make_conformant not required
         typedef typename M::size_type size_type;
         typedef typename M::difference_type difference_type;
+#ifdef BOOST_UBLAS_SIMD
+        if (detail::simd_matrix_swap<F> (m, e ()))
+            return;
+#endif
         typename M::iterator1 it1 (m.begin1 ());
         typename E::iterator1 it1e (e ().begin1 ());
         difference_type size1 (BOOST_UBLAS_SAME (m.size1 (), size_type (e ().end1 () - it1e)));
@@ -1279,6 +2295,10 @@ namespace detail {
         // R unnecessary, make_conformant not required
         typedef typename M::size_type size_type;
         typedef typename M::difference_type difference_type;
+#ifdef BOOST_UBLAS_SIMD
+        if (detail::simd_matrix_swap<F> (m, e ()))
+            return;
+#endif
         typename M::iterator2 it2 (m.begin2 ());
         typename E::iterator2 it2e (e ().begin2 ());
         difference_type size2 (BOOST_UBLAS_SAME (m.size2 (), size_type (e ().end2 () - it2e)));
@@ -1628,6 +2648,57 @@ namespace detail {
         matrix_swap<F, conformant_restrict_type> (m, e, storage_category (), orientation_category ());
     }
 
+    // Interchanges of rows: row i with row pm (i) for i = 0, ..., pm.size () - 1 in
+    // this order, like swap_rows () of lu.hpp with the pivots of lu_factorize (), in a
+    // single pass over the matrix. Over contiguous storage the rows of row major
+    // matrices are swapped as whole runs, and all the interchanges are applied to one
+    // column of column major matrices before the next one; other matrices are
+    // traversed in blocks of columns.
+    template<class PM, class M>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void matrix_swap_rows (const PM &pm, M &m) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+        size_type size (pm.size ());
+        BOOST_UBLAS_CHECK (size <= m.size1 (), bad_size ());
+        detail::simd_matrix_runs<value_type> r;
+        if (detail::simd_matrix_data (m, r)) {
+            if (boost::is_same<typename M::orientation_category, row_major_tag>::value) {
+                for (size_type i = 0; i < size; ++ i) {
+                    BOOST_UBLAS_CHECK (size_type (pm (i)) < m.size1 (), bad_index ());
+                    if (size_type (pm (i)) != i)
+                        detail::simd_array_swap (r.data + i * r.stride, r.data + pm (i) * r.stride, r.inner);
+                }
+            } else {
+                for (size_type j = 0; j < r.outer; ++ j) {
+                    value_type *column = r.data + j * r.stride;
+                    for (size_type i = 0; i < size; ++ i) {
+                        BOOST_UBLAS_CHECK (size_type (pm (i)) < m.size1 (), bad_index ());
+                        std::swap (column [i], column [pm (i)]);
+                    }
+                }
+            }
+            return;
+        }
+        // Blocks of columns small enough to remain in cache during the interchanges
+        const size_type block = 32;
+        size_type size2 (m.size2 ());
+        for (size_type jj = 0; jj < size2; jj += block) {
+            size_type j_end ((std::min) (size2, jj + block));
+            for (size_type i = 0; i < size; ++ i) {
+                size_type p (pm (i));
+                BOOST_UBLAS_CHECK (p < m.size1 (), bad_index ());
+                if (p == i)
+                    continue;
+                for (size_type j = jj; j < j_end; ++ j) {
+                    value_type t (m (i, j));
+                    m (i, j) = m (p, j);
+                    m (p, j) = t;
+                }
+            }
+        }
+    }
+
 }}}
 
 #endif
@@ -0,0 +1,664 @@
+//
+//  Copyright (c) 2000-2010
+//  Joerg Walter, Mathias Koch, Gunter Winkler
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+//  The authors gratefully acknowledge the support of
+//  GeNeSys mbH & Co. KG in producing this work.
+//
+
+#ifndef _BOOST_UBLAS_SIMD_ASSIGN_
+#define _BOOST_UBLAS_SIMD_ASSIGN_
+
+#include <boost/numeric/ublas/fwd.hpp>
+#include <boost/numeric/ublas/functional.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+// Hand written kernels for the assignment of contiguous dense arrays of float and
+// double. The instruction set is selected at run time: AVX when the processor
+// supports it, SSE2 otherwise. Each element is computed by the same IEEE operation
+// as the generic loop, so the results do not change. Plain assignments between
+// float, double, int and the complex types convert with the conversion instructions,
+// which round like the scalar conversions. Swaps of contiguous rows, columns and
+// sub-matrices exchange whole registers.
+#if defined (BOOST_UBLAS_SIMD) && defined (__GNUC__) && ! defined (__clang__) && \
+    ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)) && \
+    (defined (__x86_64__) || defined (__i386__)) && defined (__SSE2__)
+#define BOOST_UBLAS_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace boost { namespace numeric { namespace ublas {
+namespace detail {
+
+    // Operations with a SIMD kernel
+    enum simd_op_type {
+        simd_op_none,
+        simd_op_assign,
+        simd_op_plus,
+        simd_op_minus,
+        simd_op_multiplies,
+        simd_op_divides
+    };
+
+    template<template <class T1, class T2> class F>
+    struct simd_op {
+        static const int value = simd_op_none;
+    };
+    template<>
+    struct simd_op<scalar_assign> {
+        static const int value = simd_op_assign;
+    };
+    template<>
+    struct simd_op<scalar_plus_assign> {
+        static const int value = simd_op_plus;
+    };
+    template<>
+    struct simd_op<scalar_minus_assign> {
+        static const int value = simd_op_minus;
+    };
+    template<>
+    struct simd_op<scalar_multiplies_assign> {
+        static const int value = simd_op_multiplies;
+    };
+    template<>
+    struct simd_op<scalar_divides_assign> {
+        static const int value = simd_op_divides;
+    };
+
+    // Swaps with a SIMD kernel
+    template<template <class T1, class T2> class F>
+    struct simd_swap_op {
+        static const bool value = false;
+    };
+    template<>
+    struct simd_swap_op<scalar_swap> {
+        static const bool value = true;
+    };
+
+    // First element of a storage array known to be contiguous, 0 otherwise
+    template<class A>
+    BOOST_UBLAS_INLINE
+    typename A::value_type *simd_data (A &) {
+        return 0;
+    }
+    template<class T, class ALLOC>
+    BOOST_UBLAS_INLINE
+    T *simd_data (unbounded_array<T, ALLOC> &a) {
+        return a.size () ? &a [0] : 0;
+    }
+    template<class T, std::size_t N, class ALLOC>
+    BOOST_UBLAS_INLINE
+    T *simd_data (bounded_array<T, N, ALLOC> &a) {
+        return a.size () ? &a [0] : 0;
+    }
+    template<class T, class ALLOC>
+    BOOST_UBLAS_INLINE
+    T *simd_data (std::vector<T, ALLOC> &a) {
+        return a.size () ? &a [0] : 0;
+    }
+    template<class A>
+    BOOST_UBLAS_INLINE
+    const typename A::value_type *simd_data (const A &a) {
+        return simd_data (const_cast<A &> (a));
+    }
+
+    template<int OP, class T>
+    BOOST_UBLAS_INLINE
+    void simd_apply (T &x, const T &y) {
+        switch (OP) {
+        case simd_op_assign: x = y; break;
+        case simd_op_plus: x += y; break;
+        case simd_op_minus: x -= y; break;
+        case simd_op_multiplies: x *= y; break;
+        case simd_op_divides: x /= y; break;
+        }
+    }
+
+    // Remainder of the kernels
+    template<int OP, class T>
+    BOOST_UBLAS_INLINE
+    void simd_tail (T *x, const T *y, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++ i)
+            simd_apply<OP> (x [i], y [i]);
+    }
+    template<int OP, class T>
+    BOOST_UBLAS_INLINE
+    void simd_tail_scalar (T *x, const T &t, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++ i)
+            simd_apply<OP> (x [i], t);
+    }
+
+#ifdef BOOST_UBLAS_SIMD_X86
+
+#define BOOST_UBLAS_SIMD_OP(OP, PREFIX, SUFFIX, A, B) \
+    ((OP) == simd_op_plus ? PREFIX##_add_##SUFFIX (A, B) : \
+     (OP) == simd_op_minus ? PREFIX##_sub_##SUFFIX (A, B) : \
+     (OP) == simd_op_multiplies ? PREFIX##_mul_##SUFFIX (A, B) : \
+     (OP) == simd_op_divides ? PREFIX##_div_##SUFFIX (A, B) : (B))
+
+    // SSE2 kernels
+    template<int OP>
+    inline void simd_sse2_kernel (double *x, const double *y, std::size_t size) {
+        std::size_t i = 0;
+        for (; i + 2 <= size; i += 2)
+            _mm_storeu_pd (x + i, BOOST_UBLAS_SIMD_OP (OP, _mm, pd, _mm_loadu_pd (x + i), _mm_loadu_pd (y + i)));
+        simd_tail<OP> (x + i, y + i, size - i);
+    }
+    template<int OP>
+    inline void simd_sse2_kernel (float *x, const float *y, std::size_t size) {
+        std::size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+            _mm_storeu_ps (x + i, BOOST_UBLAS_SIMD_OP (OP, _mm, ps, _mm_loadu_ps (x + i), _mm_loadu_ps (y + i)));
+        simd_tail<OP> (x + i, y + i, size - i);
+    }
+    template<int OP>
+    inline void simd_sse2_kernel_scalar (double *x, const double &t, std::size_t size) {
+        const __m128d b = _mm_set1_pd (t);
+        std::size_t i = 0;
+        for (; i + 2 <= size; i += 2)
+            _mm_storeu_pd (x + i, BOOST_UBLAS_SIMD_OP (OP, _mm, pd, _mm_loadu_pd (x + i), b));
+        simd_tail_scalar<OP> (x + i, t, size - i);
+    }
+    template<int OP>
+    inline void simd_sse2_kernel_scalar (float *x, const float &t, std::size_t size) {
+        const __m128 b = _mm_set1_ps (t);
+        std::size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+            _mm_storeu_ps (x + i, BOOST_UBLAS_SIMD_OP (OP, _mm, ps, _mm_loadu_ps (x + i), b));
+        simd_tail_scalar<OP> (x + i, t, size - i);
+    }
+
+    // SSE2 conversion kernels
+    inline void simd_sse2_convert (float *x, const double *y, std::size_t size) {
+        std::size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+            _mm_storeu_ps (x + i, _mm_movelh_ps (_mm_cvtpd_ps (_mm_loadu_pd (y + i)), _mm_cvtpd_ps (_mm_loadu_pd (y + i + 2))));
+        for (; i < size; ++ i)
+            x [i] = y [i];
+    }
+    inline void simd_sse2_convert (double *x, const float *y, std::size_t size) {
+        std::size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            const __m128 a = _mm_loadu_ps (y + i);
+            _mm_storeu_pd (x + i, _mm_cvtps_pd (a));
+            _mm_storeu_pd (x + i + 2, _mm_cvtps_pd (_mm_movehl_ps (a, a)));
+        }
+        for (; i < size; ++ i)
+            x [i] = y [i];
+    }
+    inline void simd_sse2_convert (double *x, const int *y, std::size_t size) {
+        std::size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            const __m128i a = _mm_loadu_si128 (reinterpret_cast<const __m128i *> (y + i));
+            _mm_storeu_pd (x + i, _mm_cvtepi32_pd (a));
+            _mm_storeu_pd (x + i + 2, _mm_cvtepi32_pd (_mm_srli_si128 (a, 8)));
+        }
+        for (; i < size; ++ i)
+            x [i] = y [i];
+    }
+    inline void simd_sse2_convert (float *x, const int *y, std::size_t size) {
+        std::size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+            _mm_storeu_ps (x + i, _mm_cvtepi32_ps (_mm_loadu_si128 (reinterpret_cast<const __m128i *> (y + i))));
+        for (; i < size; ++ i)
+            x [i] = float (y [i]);
+    }
+
+    // SSE2 swap kernels
+    inline void simd_sse2_swap (double *x, double *y, std::size_t size) {
+        std::size_t i = 0;
+        for (; i + 2 <= size; i += 2) {
+            const __m128d a = _mm_loadu_pd (x + i);
+            _mm_storeu_pd (x + i, _mm_loadu_pd (y + i));
+            _mm_storeu_pd (y + i, a);
+        }
+        std::swap_ranges (x + i, x + size, y + i);
+    }
+    inline void simd_sse2_swap (float *x, float *y, std::size_t size) {
+        std::size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            const __m128 a = _mm_loadu_ps (x + i);
+            _mm_storeu_ps (x + i, _mm_loadu_ps (y + i));
+            _mm_storeu_ps (y + i, a);
+        }
+        std::swap_ranges (x + i, x + size, y + i);
+    }
+
+    // AVX kernels, compiled for AVX whatever the target of the translation unit
+#pragma GCC push_options
+#pragma GCC target ("avx")
+    template<int OP>
+    inline void simd_avx_kernel (double *x, const double *y, std::size_t size) {
+        std::size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+            _mm256_storeu_pd (x + i, BOOST_UBLAS_SIMD_OP (OP, _mm256, pd, _mm256_loadu_pd (x + i), _mm256_loadu_pd (y + i)));
+        for (; i < size; ++ i)
+            simd_apply<OP> (x [i], y [i]);
+    }
+    template<int OP>
+    inline void simd_avx_kernel (float *x, const float *y, std::size_t size) {
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+            _mm256_storeu_ps (x + i, BOOST_UBLAS_SIMD_OP (OP, _mm256, ps, _mm256_loadu_ps (x + i), _mm256_loadu_ps (y + i)));
+        for (; i < size; ++ i)
+            simd_apply<OP> (x [i], y [i]);
+    }
+    template<int OP>
+    inline void simd_avx_kernel_scalar (double *x, const double &t, std::size_t size) {
+        const __m256d b = _mm256_set1_pd (t);
+        std::size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+            _mm256_storeu_pd (x + i, BOOST_UBLAS_SIMD_OP (OP, _mm256, pd, _mm256_loadu_pd (x + i), b));
+        for (; i < size; ++ i)
+            simd_apply<OP> (x [i], t);
+    }
+    template<int OP>
+    inline void simd_avx_kernel_scalar (float *x, const float &t, std::size_t size) {
+        const __m256 b = _mm256_set1_ps (t);
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+            _mm256_storeu_ps (x + i, BOOST_UBLAS_SIMD_OP (OP, _mm256, ps, _mm256_loadu_ps (x + i), b));
+        for (; i < size; ++ i)
+            simd_apply<OP> (x [i], t);
+    }
+
+    // AVX conversion kernels
+    inline void simd_avx_convert (float *x, const double *y, std::size_t size) {
+        std::size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+            _mm_storeu_ps (x + i, _mm256_cvtpd_ps (_mm256_loadu_pd (y + i)));
+        for (; i < size; ++ i)
+            x [i] = y [i];
+    }
+    inline void simd_avx_convert (double *x, const float *y, std::size_t size) {
+        std::size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+            _mm256_storeu_pd (x + i, _mm256_cvtps_pd (_mm_loadu_ps (y + i)));
+        for (; i < size; ++ i)
+            x [i] = y [i];
+    }
+    inline void simd_avx_convert (double *x, const int *y, std::size_t size) {
+        std::size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+            _mm256_storeu_pd (x + i, _mm256_cvtepi32_pd (_mm_loadu_si128 (reinterpret_cast<const __m128i *> (y + i))));
+        for (; i < size; ++ i)
+            x [i] = y [i];
+    }
+    inline void simd_avx_convert (float *x, const int *y, std::size_t size) {
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+            _mm256_storeu_ps (x + i, _mm256_cvtepi32_ps (_mm256_loadu_si256 (reinterpret_cast<const __m256i *> (y + i))));
+        for (; i < size; ++ i)
+            x [i] = float (y [i]);
+    }
+
+    // AVX swap kernels
+    inline void simd_avx_swap (double *x, double *y, std::size_t size) {
+        std::size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            const __m256d a = _mm256_loadu_pd (x + i);
+            _mm256_storeu_pd (x + i, _mm256_loadu_pd (y + i));
+            _mm256_storeu_pd (y + i, a);
+        }
+        std::swap_ranges (x + i, x + size, y + i);
+    }
+    inline void simd_avx_swap (float *x, float *y, std::size_t size) {
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            const __m256 a = _mm256_loadu_ps (x + i);
+            _mm256_storeu_ps (x + i, _mm256_loadu_ps (y + i));
+            _mm256_storeu_ps (y + i, a);
+        }
+        std::swap_ranges (x + i, x + size, y + i);
+    }
+#pragma GCC pop_options
+
+#undef BOOST_UBLAS_SIMD_OP
+
+    inline bool simd_has_avx () {
+        return __builtin_cpu_supports ("avx");
+    }
+
+    // Kernel dispatch: only float and double have a kernel
+    template<int OP, class T>
+    BOOST_UBLAS_INLINE
+    bool simd_kernel (T *, const T *, std::size_t) {
+        return false;
+    }
+    template<int OP, class T>
+    BOOST_UBLAS_INLINE
+    bool simd_kernel_scalar (T *, const T &, std::size_t) {
+        return false;
+    }
+#define BOOST_UBLAS_SIMD_KERNEL(T) \
+    template<int OP> \
+    BOOST_UBLAS_INLINE \
+    bool simd_kernel (T *x, const T *y, std::size_t size) { \
+        if (simd_has_avx ()) \
+            simd_avx_kernel<OP> (x, y, size); \
+        else \
+            simd_sse2_kernel<OP> (x, y, size); \
+        return true; \
+    } \
+    template<int OP> \
+    BOOST_UBLAS_INLINE \
+    bool simd_kernel_scalar (T *x, const T &t, std::size_t size) { \
+        if (simd_has_avx ()) \
+            simd_avx_kernel_scalar<OP> (x, t, size); \
+        else \
+            simd_sse2_kernel_scalar<OP> (x, t, size); \
+        return true; \
+    }
+    BOOST_UBLAS_SIMD_KERNEL(float)
+    BOOST_UBLAS_SIMD_KERNEL(double)
+#undef BOOST_UBLAS_SIMD_KERNEL
+
+    // Conversion kernel dispatch: only the pairs below have a kernel
+    template<class T, class U>
+    BOOST_UBLAS_INLINE
+    bool simd_convert_kernel (T *, const U *, std::size_t) {
+        return false;
+    }
+#define BOOST_UBLAS_SIMD_CONVERT_KERNEL(T, U) \
+    inline bool simd_convert_kernel (T *x, const U *y, std::size_t size) { \
+        if (simd_has_avx ()) \
+            simd_avx_convert (x, y, size); \
+        else \
+            simd_sse2_convert (x, y, size); \
+        return true; \
+    }
+    BOOST_UBLAS_SIMD_CONVERT_KERNEL(float, double)
+    BOOST_UBLAS_SIMD_CONVERT_KERNEL(double, float)
+    BOOST_UBLAS_SIMD_CONVERT_KERNEL(double, int)
+    BOOST_UBLAS_SIMD_CONVERT_KERNEL(float, int)
+#undef BOOST_UBLAS_SIMD_CONVERT_KERNEL
+    // Complex numbers are stored as pairs of their real and imaginary parts
+    template<class T, class U>
+    BOOST_UBLAS_INLINE
+    bool simd_convert_kernel (std::complex<T> *x, const std::complex<U> *y, std::size_t size) {
+        return simd_convert_kernel (reinterpret_cast<T *> (x), reinterpret_cast<const U *> (y), 2 * size);
+    }
+
+    // Swap kernel dispatch: only float, double and the complex types have a kernel
+    template<class T>
+    BOOST_UBLAS_INLINE
+    bool simd_swap_kernel (T *, T *, std::size_t) {
+        return false;
+    }
+#define BOOST_UBLAS_SIMD_SWAP_KERNEL(T) \
+    inline bool simd_swap_kernel (T *x, T *y, std::size_t size) { \
+        if (simd_has_avx ()) \
+            simd_avx_swap (x, y, size); \
+        else \
+            simd_sse2_swap (x, y, size); \
+        return true; \
+    }
+    BOOST_UBLAS_SIMD_SWAP_KERNEL(float)
+    BOOST_UBLAS_SIMD_SWAP_KERNEL(double)
+#undef BOOST_UBLAS_SIMD_SWAP_KERNEL
+    template<class T>
+    BOOST_UBLAS_INLINE
+    bool simd_swap_kernel (std::complex<T> *x, std::complex<T> *y, std::size_t size) {
+        return simd_swap_kernel (reinterpret_cast<T *> (x), reinterpret_cast<T *> (y), 2 * size);
+    }
+
+#else
+
+    template<int OP, class T>
+    BOOST_UBLAS_INLINE
+    bool simd_kernel (T *, const T *, std::size_t) {
+        return false;
+    }
+    template<int OP, class T>
+    BOOST_UBLAS_INLINE
+    bool simd_kernel_scalar (T *, const T &, std::size_t) {
+        return false;
+    }
+    template<class T, class U>
+    BOOST_UBLAS_INLINE
+    bool simd_convert_kernel (T *, const U *, std::size_t) {
+        return false;
+    }
+    template<class T>
+    BOOST_UBLAS_INLINE
+    bool simd_swap_kernel (T *, T *, std::size_t) {
+        return false;
+    }
+
+#endif
+
+    template<int OP, class T>
+    BOOST_UBLAS_INLINE
+    bool simd_array_assign (T *x, const T *y, std::size_t size) {
+        if (OP == simd_op_none || OP == simd_op_multiplies || OP == simd_op_divides)
+            return false;
+        if (size == 0)
+            return true;
+        if (! x || ! y)
+            return false;
+        return simd_kernel<OP> (x, y, size);
+    }
+    template<int OP, class T>
+    BOOST_UBLAS_INLINE
+    bool simd_array_assign_scalar (T *x, const T &t, std::size_t size) {
+        if (OP == simd_op_none)
+            return false;
+        if (size == 0)
+            return true;
+        if (! x)
+            return false;
+        return simd_kernel_scalar<OP> (x, t, size);
+    }
+
+    template<int OP, class T, class U>
+    BOOST_UBLAS_INLINE
+    bool simd_array_convert (T *x, const U *y, std::size_t size) {
+        if (OP != simd_op_assign)
+            return false;
+        if (size == 0)
+            return true;
+        if (! x || ! y)
+            return false;
+        return simd_convert_kernel (x, y, size);
+    }
+
+    // Swap of two contiguous arrays, element by element for the types without a kernel
+    template<class T>
+    BOOST_UBLAS_INLINE
+    bool simd_array_swap (T *x, T *y, std::size_t size) {
+        if (! x || ! y)
+            return false;
+        if (! simd_swap_kernel (x, y, size))
+            std::swap_ranges (x, x + size, y);
+        return true;
+    }
+    template<class T, class U>
+    BOOST_UBLAS_INLINE
+    bool simd_array_swap (T *, U *, std::size_t) {
+        return false;
+    }
+
+    // First element of a dense vector whose elements are known to be contiguous, 0 otherwise
+    template<class V>
+    BOOST_UBLAS_INLINE
+    typename V::value_type *simd_vector_data (V &) {
+        return 0;
+    }
+    template<class T, class A>
+    BOOST_UBLAS_INLINE
+    T *simd_vector_data (vector<T, A> &v) {
+        return simd_data (v.data ());
+    }
+    template<class T, class A>
+    BOOST_UBLAS_INLINE
+    T *simd_vector_data (vector_range<vector<T, A> > &v) {
+        T *data = simd_data (v.data ().expression ().data ());
+        return data && v.size () ? data + v.start () : 0;
+    }
+    template<class T, class Z, class D, class A>
+    BOOST_UBLAS_INLINE
+    T *simd_vector_data (matrix_row<matrix<T, basic_row_major<Z, D>, A> > &v) {
+        T *data = simd_data (v.data ().expression ().data ());
+        return data && v.size () ? data + v.index () * v.size () : 0;
+    }
+    template<class T, class Z, class D, class A>
+    BOOST_UBLAS_INLINE
+    T *simd_vector_data (matrix_column<matrix<T, basic_column_major<Z, D>, A> > &v) {
+        T *data = simd_data (v.data ().expression ().data ());
+        return data && v.size () ? data + v.index () * v.size () : 0;
+    }
+
+    // Elements of a dense matrix along its storage orientation: outer runs of inner
+    // contiguous elements, the first one at data and each one stride elements after
+    // the previous one
+    template<class T>
+    struct simd_matrix_runs {
+        T *data;
+        std::size_t outer, inner, stride;
+    };
+    template<class M>
+    BOOST_UBLAS_INLINE
+    bool simd_matrix_data (M &, simd_matrix_runs<typename M::value_type> &) {
+        return false;
+    }
+    template<class T, class L, class A>
+    BOOST_UBLAS_INLINE
+    bool simd_matrix_data (matrix<T, L, A> &m, simd_matrix_runs<T> &r) {
+        r.data = simd_data (m.data ());
+        r.outer = L::size_M (m.size1 (), m.size2 ());
+        r.inner = L::size_m (m.size1 (), m.size2 ());
+        r.stride = r.inner;
+        return r.data != 0;
+    }
+    template<class T, class L, class A>
+    BOOST_UBLAS_INLINE
+    bool simd_matrix_data (matrix_range<matrix<T, L, A> > &m, simd_matrix_runs<T> &r) {
+        matrix<T, L, A> &e = m.data ().expression ();
+        T *data = simd_data (e.data ());
+        if (! data || m.size1 () == 0 || m.size2 () == 0)
+            return false;
+        r.data = data + L::element (m.start1 (), e.size1 (), m.start2 (), e.size2 ());
+        r.outer = L::size_M (m.size1 (), m.size2 ());
+        r.inner = L::size_m (m.size1 (), m.size2 ());
+        r.stride = L::size_m (e.size1 (), e.size2 ());
+        return true;
+    }
+
+    template<class T>
+    BOOST_UBLAS_INLINE
+    bool simd_runs_swap (const simd_matrix_runs<T> &x, const simd_matrix_runs<T> &y) {
+        BOOST_UBLAS_CHECK (x.outer == y.outer && x.inner == y.inner, bad_size ());
+        if (x.inner == x.stride && y.inner == y.stride)
+            return simd_array_swap (x.data, y.data, x.outer * x.inner);
+        for (std::size_t k = 0; k < x.outer; ++ k)
+            simd_array_swap (x.data + k * x.stride, y.data + k * y.stride, x.inner);
+        return true;
+    }
+    template<class T, class U>
+    BOOST_UBLAS_INLINE
+    bool simd_runs_swap (const simd_matrix_runs<T> &, const simd_matrix_runs<U> &) {
+        return false;
+    }
+
+    // Dispatch from the assignment functions: true if the assignment has been done.
+    // Only vectors and matrices over contiguous storage (and for matrices of the same
+    // layout) qualify, of the same value type or, for plain assignments, of a pair of
+    // value types with a conversion kernel; for the scalar versions the scalar must be
+    // of the value type, so that no conversion changes the results.
+    template<template <class T1, class T2> class F, class V, class E>
+    BOOST_UBLAS_INLINE
+    bool simd_vector_assign (V &, const E &) {
+        return false;
+    }
+    template<template <class T1, class T2> class F, class T, class A1, class A2>
+    BOOST_UBLAS_INLINE
+    bool simd_vector_assign (vector<T, A1> &v, const vector<T, A2> &e) {
+        BOOST_UBLAS_CHECK (v.size () == e.size (), bad_size ());
+        return simd_array_assign<simd_op<F>::value> (simd_data (v.data ()), simd_data (e.data ()), v.size ());
+    }
+    template<template <class T1, class T2> class F, class T, class A1, class U, class A2>
+    BOOST_UBLAS_INLINE
+    bool simd_vector_assign (vector<T, A1> &v, const vector<U, A2> &e) {
+        BOOST_UBLAS_CHECK (v.size () == e.size (), bad_size ());
+        return simd_array_convert<simd_op<F>::value> (simd_data (v.data ()), simd_data (e.data ()), v.size ());
+    }
+    template<template <class T1, class T2> class F, class V, class T>
+    BOOST_UBLAS_INLINE
+    bool simd_vector_assign_scalar (V &, const T &) {
+        return false;
+    }
+    template<template <class T1, class T2> class F, class T, class A>
+    BOOST_UBLAS_INLINE
+    bool simd_vector_assign_scalar (vector<T, A> &v, const T &t) {
+        return simd_array_assign_scalar<simd_op<F>::value> (simd_data (v.data ()), t, v.size ());
+    }
+
+    template<template <class T1, class T2> class F, class M, class E>
+    BOOST_UBLAS_INLINE
+    bool simd_matrix_assign (M &, const E &) {
+        return false;
+    }
+    template<template <class T1, class T2> class F, class T, class L, class A1, class A2>
+    BOOST_UBLAS_INLINE
+    bool simd_matrix_assign (matrix<T, L, A1> &m, const matrix<T, L, A2> &e) {
+        BOOST_UBLAS_CHECK (m.size1 () == e.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e.size2 (), bad_size ());
+        return simd_array_assign<simd_op<F>::value> (simd_data (m.data ()), simd_data (e.data ()), m.size1 () * m.size2 ());
+    }
+    template<template <class T1, class T2> class F, class T, class L, class A1, class U, class A2>
+    BOOST_UBLAS_INLINE
+    bool simd_matrix_assign (matrix<T, L, A1> &m, const matrix<U, L, A2> &e) {
+        BOOST_UBLAS_CHECK (m.size1 () == e.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e.size2 (), bad_size ());
+        return simd_array_convert<simd_op<F>::value> (simd_data (m.data ()), simd_data (e.data ()), m.size1 () * m.size2 ());
+    }
+    template<template <class T1, class T2> class F, class M, class T>
+    BOOST_UBLAS_INLINE
+    bool simd_matrix_assign_scalar (M &, const T &) {
+        return false;
+    }
+    template<template <class T1, class T2> class F, class T, class L, class A>
+    BOOST_UBLAS_INLINE
+    bool simd_matrix_assign_scalar (matrix<T, L, A> &m, const T &t) {
+        return simd_array_assign_scalar<simd_op<F>::value> (simd_data (m.data ()), t, m.size1 () * m.size2 ());
+    }
+
+    // Dispatch from the swap functions: true if the swap has been done. Vectors,
+    // ranges of vectors and rows (columns) of row (column) major matrices over
+    // contiguous storage qualify, and matrices and ranges of matrices of the same
+    // orientation, of the same value type.
+    template<template <class T1, class T2> class F, class V, class E>
+    BOOST_UBLAS_INLINE
+    bool simd_vector_swap (V &v, E &e) {
+        BOOST_UBLAS_CHECK (v.size () == e.size (), bad_size ());
+        if (! simd_swap_op<F>::value)
+            return false;
+        return simd_array_swap (simd_vector_data (v), simd_vector_data (e), v.size ());
+    }
+    template<template <class T1, class T2> class F, class M, class E>
+    BOOST_UBLAS_INLINE
+    bool simd_matrix_swap (M &m, E &e) {
+        BOOST_UBLAS_CHECK (m.size1 () == e.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e.size2 (), bad_size ());
+        if (! simd_swap_op<F>::value ||
+            ! boost::is_same<typename M::orientation_category, typename E::orientation_category>::value)
+            return false;
+        simd_matrix_runs<typename M::value_type> rm;
+        simd_matrix_runs<typename E::value_type> re;
+        if (! simd_matrix_data (m, rm) || ! simd_matrix_data (e, re))
+            return false;
+        return simd_runs_swap (rm, re);
+    }
+
+}//namespace detail
+}}}
+
+#endif
@@ -0,0 +1,208 @@
+//
+//  Copyright (c) 2000-2010
+//  Joerg Walter, Mathias Koch, Gunter Winkler
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+//  The authors gratefully acknowledge the support of
+//  GeNeSys mbH & Co. KG in producing this work.
+//
+
+#ifndef _BOOST_UBLAS_STREAM_ASSIGN_
+#define _BOOST_UBLAS_STREAM_ASSIGN_
+
+#include <boost/numeric/ublas/detail/simd_assign.hpp>
+#include <cstddef>
+
+// Plain assignment of contiguous dense float and double vectors and matrices with
+// non temporal (streaming) stores: the destination is written around the caches and
+// is not read for ownership first, and the caches are kept for the operands. Whether
+// this is faster depends on the machine; measure it. Only for x86 targets with SSE2.
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__)) && defined (__SSE2__)
+#define BOOST_UBLAS_STREAM_X86
+#include <emmintrin.h>
+#endif
+
+namespace boost { namespace numeric { namespace ublas {
+namespace detail {
+
+    // Sources of the elements to be stored: g (k) is the k-th element
+    template<class T>
+    struct stream_scalar_source {
+        BOOST_UBLAS_INLINE
+        stream_scalar_source (const T &t):
+            t_ (t) {}
+        BOOST_UBLAS_INLINE
+        T operator () (std::size_t) const {
+            return t_;
+        }
+    private:
+        T t_;
+    };
+    template<class T, class E>
+    struct stream_vector_source {
+        BOOST_UBLAS_INLINE
+        stream_vector_source (const E &e):
+            e_ (e) {}
+        BOOST_UBLAS_INLINE
+        T operator () (std::size_t k) const {
+            return e_ (k);
+        }
+    private:
+        const E &e_;
+    };
+    // Major slice i of a matrix expression
+    template<class T, class E, class O>
+    struct stream_matrix_source {};
+    template<class T, class E>
+    struct stream_matrix_source<T, E, row_major_tag> {
+        BOOST_UBLAS_INLINE
+        stream_matrix_source (const E &e, std::size_t i):
+            e_ (e), i_ (i) {}
+        BOOST_UBLAS_INLINE
+        T operator () (std::size_t k) const {
+            return e_ (i_, k);
+        }
+    private:
+        const E &e_;
+        std::size_t i_;
+    };
+    template<class T, class E>
+    struct stream_matrix_source<T, E, column_major_tag> {
+        BOOST_UBLAS_INLINE
+        stream_matrix_source (const E &e, std::size_t j):
+            e_ (e), j_ (j) {}
+        BOOST_UBLAS_INLINE
+        T operator () (std::size_t k) const {
+            return e_ (k, j_);
+        }
+    private:
+        const E &e_;
+        std::size_t j_;
+    };
+
+    // Store size elements of g to x; false if there is no kernel for T
+    template<class T, class G>
+    BOOST_UBLAS_INLINE
+    bool stream_kernel (T *, const G &, std::size_t) {
+        return false;
+    }
+
+#ifdef BOOST_UBLAS_STREAM_X86
+    // The unaligned head and the tail are stored as usual
+    template<class G>
+    inline bool stream_kernel (double *x, const G &g, std::size_t size) {
+        std::size_t k = 0;
+        for (; k < size && (reinterpret_cast<std::size_t> (x + k) & 15) != 0; ++ k)
+            x [k] = g (k);
+        for (; k + 2 <= size; k += 2)
+            _mm_stream_pd (x + k, _mm_set_pd (g (k + 1), g (k)));
+        for (; k < size; ++ k)
+            x [k] = g (k);
+        return true;
+    }
+    template<class G>
+    inline bool stream_kernel (float *x, const G &g, std::size_t size) {
+        std::size_t k = 0;
+        for (; k < size && (reinterpret_cast<std::size_t> (x + k) & 15) != 0; ++ k)
+            x [k] = g (k);
+        for (; k + 4 <= size; k += 4)
+            _mm_stream_ps (x + k, _mm_set_ps (g (k + 3), g (k + 2), g (k + 1), g (k)));
+        for (; k < size; ++ k)
+            x [k] = g (k);
+        return true;
+    }
+
+    // Order the streaming stores before any later store
+    inline void stream_fence () {
+        _mm_sfence ();
+    }
+#else
+    inline void stream_fence () {}
+#endif
+
+    // Dispatch from the assignment functions: true if the assignment has been done.
+    // Only plain assignments to vectors and matrices over contiguous storage of at
+    // least threshold bytes qualify; each element of e is evaluated once.
+    template<template <class T1, class T2> class F, class V, class E>
+    BOOST_UBLAS_INLINE
+    bool stream_vector_assign (V &, const vector_expression<E> &, std::size_t) {
+        return false;
+    }
+    template<template <class T1, class T2> class F, class T, class A, class E>
+    BOOST_UBLAS_INLINE
+    bool stream_vector_assign (vector<T, A> &v, const vector_expression<E> &e, std::size_t threshold) {
+        BOOST_UBLAS_CHECK (v.size () == e ().size (), bad_size ());
+        if (simd_op<F>::value != simd_op_assign || v.size () * sizeof (T) < threshold)
+            return false;
+        T *x = simd_data (v.data ());
+        if (! x || ! stream_kernel (x, stream_vector_source<T, E> (e ()), v.size ()))
+            return false;
+        stream_fence ();
+        return true;
+    }
+    template<template <class T1, class T2> class F, class V, class S>
+    BOOST_UBLAS_INLINE
+    bool stream_vector_assign_scalar (V &, const S &, std::size_t) {
+        return false;
+    }
+    template<template <class T1, class T2> class F, class T, class A, class S>
+    BOOST_UBLAS_INLINE
+    bool stream_vector_assign_scalar (vector<T, A> &v, const S &t, std::size_t threshold) {
+        if (simd_op<F>::value != simd_op_assign || v.size () * sizeof (T) < threshold)
+            return false;
+        T *x = simd_data (v.data ());
+        if (! x || ! stream_kernel (x, stream_scalar_source<T> (t), v.size ()))
+            return false;
+        stream_fence ();
+        return true;
+    }
+
+    template<template <class T1, class T2> class F, class M, class E>
+    BOOST_UBLAS_INLINE
+    bool stream_matrix_assign (M &, const matrix_expression<E> &, std::size_t) {
+        return false;
+    }
+    template<template <class T1, class T2> class F, class T, class L, class A, class E>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    bool stream_matrix_assign (matrix<T, L, A> &m, const matrix_expression<E> &e, std::size_t threshold) {
+        typedef typename L::orientation_category orientation_category;
+        typedef typename matrix<T, L, A>::size_type size_type;
+        BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
+        size_type size_M (L::size_M (m.size1 (), m.size2 ()));
+        size_type size_m (L::size_m (m.size1 (), m.size2 ()));
+        if (simd_op<F>::value != simd_op_assign || size_M * size_m * sizeof (T) < threshold)
+            return false;
+        T *x = simd_data (m.data ());
+        if (! x)
+            return false;
+        for (size_type i = 0; i < size_M; ++ i)
+            if (! stream_kernel (x + i * size_m, stream_matrix_source<T, E, orientation_category> (e (), i), size_m))
+                return false;
+        stream_fence ();
+        return true;
+    }
+    template<template <class T1, class T2> class F, class M, class S>
+    BOOST_UBLAS_INLINE
+    bool stream_matrix_assign_scalar (M &, const S &, std::size_t) {
+        return false;
+    }
+    template<template <class T1, class T2> class F, class T, class L, class A, class S>
+    BOOST_UBLAS_INLINE
+    bool stream_matrix_assign_scalar (matrix<T, L, A> &m, const S &t, std::size_t threshold) {
+        if (simd_op<F>::value != simd_op_assign || m.size1 () * m.size2 () * sizeof (T) < threshold)
+            return false;
+        T *x = simd_data (m.data ());
+        if (! x || ! stream_kernel (x, stream_scalar_source<T> (t), m.size1 () * m.size2 ()))
+            return false;
+        stream_fence ();
+        return true;
+    }
+
+}//namespace detail
+}}}
+
+#endif
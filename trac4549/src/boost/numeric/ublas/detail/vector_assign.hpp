@@ -14,6 +14,11 @@
 #define _BOOST_UBLAS_VECTOR_ASSIGN_
 
 #include <boost/numeric/ublas/functional.hpp> // scalar_assign
+#include <boost/mpl/bool.hpp>
+#include <boost/numeric/ublas/detail/simd_assign.hpp>
+#include <boost/numeric/ublas/detail/stream_assign.hpp>
+#include <boost/numeric/ublas/detail/cblas.hpp>
+#include <boost/numeric/ublas/detail/assign_statistics.hpp>
 // Required for make_conformant storage
 #include <vector>
 
@@ -34,12 +39,118 @@ namespace detail {
                std::max<S> (std::max<S> (norm_inf (e1), norm_inf (e2)), min_norm);
     }
 
+    // Exact equality check for integral types, where no rounding can occur
+    template<class E1, class E2>
+    BOOST_UBLAS_INLINE
+    bool equals (const vector_expression<E1> &e1, const vector_expression<E2> &e2) {
+        typedef typename E1::size_type size_type;
+        if (e1 ().size () != e2 ().size ())
+            return false;
+        for (size_type i = 0; i < e1 ().size (); ++ i)
+            if (e1 () (i) != e2 () (i))
+                return false;
+        return true;
+    }
+
+    template<class E1, class E2, class S>
+    BOOST_UBLAS_INLINE
+    bool expression_type_check (const vector_expression<E1> &e1, const vector_expression<E2> &e2, S, boost::mpl::true_) {
+        return equals (e1, e2);
+    }
+    template<class E1, class E2, class real_type>
+    BOOST_UBLAS_INLINE
+    bool expression_type_check (const vector_expression<E1> &e1, const vector_expression<E2> &e2, real_type, boost::mpl::false_) {
+        return equals (e1, e2, BOOST_UBLAS_TYPE_CHECK_EPSILON, BOOST_UBLAS_TYPE_CHECK_MIN);
+    }
     template<class E1, class E2>
     BOOST_UBLAS_INLINE
     bool expression_type_check (const vector_expression<E1> &e1, const vector_expression<E2> &e2) {
         typedef typename type_traits<typename promote_traits<typename E1::value_type,
                                      typename E2::value_type>::promote_type>::real_type real_type;
-        return equals (e1, e2, BOOST_UBLAS_TYPE_CHECK_EPSILON, BOOST_UBLAS_TYPE_CHECK_MIN);
+        return expression_type_check (e1, e2, real_type (), boost::mpl::bool_<boost::is_integral<real_type>::value> ());
+    }
+
+    // Sampled type check.
+    // Keeps the expected results of BOOST_UBLAS_TYPE_CHECK_SAMPLES pseudo randomly chosen
+    // elements, computed before the assignment, instead of a dense copy of the whole result.
+    template<class T>
+    class vector_type_check_sample {
+    public:
+        typedef std::size_t size_type;
+        typedef T value_type;
+
+        template<template <class T1, class T2> class F, class V, class E>
+        void assign (const V &v, const vector_expression<E> &e) {
+            typedef F<value_type &, typename E::value_type> functor_type;
+            size_type size (v.size ());
+            if (size == 0)
+                return;
+            size_type samples (BOOST_UBLAS_TYPE_CHECK_SAMPLES);
+            bool all (size <= samples);
+            if (all)
+                samples = size;
+            index_.reserve (samples);
+            values_.reserve (samples);
+            // Linear congruential generator, reproducible for a given size
+            unsigned long seed (static_cast<unsigned long> (size));
+            for (size_type k = 0; k < samples; ++ k) {
+                size_type i;
+                if (all) {
+                    i = k;
+                } else {
+                    seed = seed * 1103515245UL + 12345UL;
+                    i = static_cast<size_type> ((seed >> 16) % size);
+                }
+                value_type t (v (i));
+                functor_type::apply (t, e () (i));
+                index_.push_back (i);
+                values_.push_back (t);
+            }
+        }
+
+        // Exact comparison of the samples for integral types
+        template<class E>
+        bool equals (const vector_expression<E> &e) const {
+            for (size_type k = 0; k < values_.size (); ++ k)
+                if (value_type (e () (index_ [k])) != values_ [k])
+                    return false;
+            return true;
+        }
+
+        // Same bound as equals () restricted to the samples
+        template<class E, class S>
+        bool equals (const vector_expression<E> &e, S epsilon, S min_norm) const {
+            S norm_diff (0), norm_e (0), norm_s (0);
+            for (size_type k = 0; k < values_.size (); ++ k) {
+                value_type t (e () (index_ [k]));
+                norm_diff = (std::max) (norm_diff, S (type_traits<value_type>::norm_inf (t - values_ [k])));
+                norm_e = (std::max) (norm_e, S (type_traits<value_type>::norm_inf (t)));
+                norm_s = (std::max) (norm_s, S (type_traits<value_type>::norm_inf (values_ [k])));
+            }
+            return norm_diff <= epsilon * std::max<S> (std::max<S> (norm_e, norm_s), min_norm);
+        }
+
+    private:
+        std::vector<size_type> index_;
+        std::vector<value_type> values_;
+    };
+
+    template<class E, class T, class S>
+    BOOST_UBLAS_INLINE
+    bool expression_type_check (const vector_expression<E> &e, const vector_type_check_sample<T> &s, S, boost::mpl::true_) {
+        return s.equals (e);
+    }
+    template<class E, class T, class real_type>
+    BOOST_UBLAS_INLINE
+    bool expression_type_check (const vector_expression<E> &e, const vector_type_check_sample<T> &s, real_type, boost::mpl::false_) {
+        return s.equals (e, BOOST_UBLAS_TYPE_CHECK_EPSILON, BOOST_UBLAS_TYPE_CHECK_MIN);
+    }
+    template<class E, class T>
+    BOOST_UBLAS_INLINE
+    bool expression_type_check (const vector_expression<E> &e, const vector_type_check_sample<T> &s) {
+        typedef typename type_traits<typename promote_traits<typename E::value_type,
+                                     T>::promote_type>::real_type real_type;
+        return expression_type_check (e, s, real_type (), boost::mpl::bool_<boost::is_integral<real_type>::value> ());
     }
 
 
@@ -47,6 +158,7 @@ namespace detail {
     template<class V, class E>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void make_conformant (V &v, const vector_expression<E> &e) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_vector_make_conformant, false, v.size ());
         BOOST_UBLAS_CHECK (v.size () == e ().size (), bad_size ());
         typedef typename V::size_type size_type;
         typedef typename V::difference_type difference_type;
@@ -95,6 +207,52 @@ namespace detail {
             v (index [k]) = value_type/*zero*/();
     }
 
+    // Galloping merge of sparse operands.
+    // The sparse iterators only step by one; when a run of BOOST_UBLAS_GALLOP_THRESHOLD
+    // steps on one operand did not reach the index of the other one, the operand is
+    // moved by lookup instead, i.e. by a binary search in the sparse containers. Short
+    // gaps keep the linear merge, long gaps (one operand much sparser than the other)
+    // cost a logarithmic lookup.
+    template<class V>
+    struct gallop_vector_lookup {
+        typedef typename V::size_type size_type;
+
+        BOOST_UBLAS_INLINE
+        gallop_vector_lookup (V &v):
+            v_ (v) {}
+        template<class I>
+        BOOST_UBLAS_INLINE
+        void operator () (I &it, size_type index) const {
+            it = v_.find (index);
+        }
+    private:
+        V &v_;
+    };
+
+    template<class I, class L, class C>
+    BOOST_UBLAS_INLINE
+    void gallop_increment (I &it, const I &it_end, typename I::difference_type compare, typename L::size_type /* index */, std::size_t &/* steps */, const L &/* lookup */, C) {
+        increment (it, it_end, compare);
+    }
+    template<class I, class L>
+    BOOST_UBLAS_INLINE
+    void gallop_increment (I &it, const I &/* it_end */, typename I::difference_type /* compare */, typename L::size_type index, std::size_t &steps, const L &lookup, sparse_bidirectional_iterator_tag) {
+        if (BOOST_UBLAS_GALLOP_THRESHOLD != 0 && steps >= BOOST_UBLAS_GALLOP_THRESHOLD) {
+            lookup (it, index);
+            steps = 0;
+        } else {
+            ++ it;
+            ++ steps;
+        }
+    }
+    // Move it towards index (compare positions ahead), steps counting the single steps
+    // done in the current gap
+    template<class I, class L>
+    BOOST_UBLAS_INLINE
+    void gallop_increment (I &it, const I &it_end, typename I::difference_type compare, typename L::size_type index, std::size_t &steps, const L &lookup) {
+        gallop_increment (it, it_end, compare, index, steps, lookup, typename I::iterator_category ());
+    }
+
 }//namespace detail
 
 
@@ -134,6 +292,15 @@ namespace detail {
     template<template <class T1, class T2> class F, class V, class T>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void vector_assign_scalar (V &v, const T &t, dense_proxy_tag) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_vector_assign_scalar_dense_proxy, (F<typename V::reference, T>::computed), v.size ());
+#ifdef BOOST_UBLAS_STREAMING_STORES
+        if (detail::stream_vector_assign_scalar<F> (v, t, BOOST_UBLAS_STREAMING_THRESHOLD))
+            return;
+#endif
+#ifdef BOOST_UBLAS_SIMD
+        if (detail::simd_vector_assign_scalar<F> (v, t))
+            return;
+#endif
 #ifdef BOOST_UBLAS_USE_INDEXING
         indexing_vector_assign_scalar<F> (v, t);
 #elif BOOST_UBLAS_USE_ITERATING
@@ -151,6 +318,7 @@ namespace detail {
     template<template <class T1, class T2> class F, class V, class T>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void vector_assign_scalar (V &v, const T &t, packed_proxy_tag) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_vector_assign_scalar_packed_proxy, (F<typename V::reference, T>::computed), v.size ());
         typedef F<typename V::iterator::reference, T> functor_type;
         typedef typename V::difference_type difference_type;
         typename V::iterator it (v.begin ());
@@ -162,6 +330,7 @@ namespace detail {
     template<template <class T1, class T2> class F, class V, class T>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void vector_assign_scalar (V &v, const T &t, sparse_proxy_tag) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_vector_assign_scalar_sparse_proxy, (F<typename V::reference, T>::computed), v.size ());
         typedef F<typename V::iterator::reference, T> functor_type;
         typename V::iterator it (v.begin ());
         typename V::iterator it_end (v.end ());
@@ -273,6 +442,19 @@ namespace detail {
     template<template <class T1, class T2> class F, class V, class E>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void vector_assign (V &v, const vector_expression<E> &e, dense_proxy_tag) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_vector_assign_dense_proxy, (F<typename V::reference, typename E::value_type>::computed), v.size ());
+#ifdef BOOST_UBLAS_CBLAS
+        if (detail::cblas_vector_assign<F> (v, e ()))
+            return;
+#endif
+#ifdef BOOST_UBLAS_STREAMING_STORES
+        if (detail::stream_vector_assign<F> (v, e, BOOST_UBLAS_STREAMING_THRESHOLD))
+            return;
+#endif
+#ifdef BOOST_UBLAS_SIMD
+        if (detail::simd_vector_assign<F> (v, e ()))
+            return;
+#endif
 #ifdef BOOST_UBLAS_USE_INDEXING
         indexing_vector_assign<F> (v, e);
 #elif BOOST_UBLAS_USE_ITERATING
@@ -290,14 +472,20 @@ namespace detail {
     template<template <class T1, class T2> class F, class V, class E>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void vector_assign (V &v, const vector_expression<E> &e, packed_proxy_tag) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_vector_assign_packed_proxy, (F<typename V::reference, typename E::value_type>::computed), v.size ());
         BOOST_UBLAS_CHECK (v.size () == e ().size (), bad_size ());
         typedef F<typename V::iterator::reference, typename E::value_type> functor_type;
         typedef typename V::difference_type difference_type;
         typedef typename V::value_type value_type;
 #if BOOST_UBLAS_TYPE_CHECK
+#if BOOST_UBLAS_TYPE_CHECK_SAMPLES
+        detail::vector_type_check_sample<value_type> cv;
+        cv.template assign<F> (v, e);
+#else
         vector<value_type> cv (v.size ());
         indexing_vector_assign<scalar_assign> (cv, v);
         indexing_vector_assign<F> (cv, e);
+#endif
 #endif
         typename V::iterator it (v.begin ());
         typename V::iterator it_end (v.end ());
@@ -346,14 +534,20 @@ namespace detail {
     template<template <class T1, class T2> class F, class V, class E>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void vector_assign (V &v, const vector_expression<E> &e, sparse_tag) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_vector_assign_sparse, (F<typename V::reference, typename E::value_type>::computed), v.size ());
         BOOST_UBLAS_CHECK (v.size () == e ().size (), bad_size ());
         typedef F<typename V::iterator::reference, typename E::value_type> functor_type;
         BOOST_STATIC_ASSERT ((!functor_type::computed));
         typedef typename V::value_type value_type;
 #if BOOST_UBLAS_TYPE_CHECK
+#if BOOST_UBLAS_TYPE_CHECK_SAMPLES
+        detail::vector_type_check_sample<value_type> cv;
+        cv.template assign<F> (v, e);
+#else
         vector<value_type> cv (v.size ());
         indexing_vector_assign<scalar_assign> (cv, v);
         indexing_vector_assign<F> (cv, e);
+#endif
 #endif
         v.clear ();
         typename E::const_iterator ite (e ().begin ());
@@ -374,6 +568,7 @@ namespace detail {
     template<template <class T1, class T2> class F, class V, class E>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void vector_assign (V &v, const vector_expression<E> &e, sparse_proxy_tag) {
+        BOOST_UBLAS_ASSIGN_PATH (assign_path_vector_assign_sparse_proxy, (F<typename V::reference, typename E::value_type>::computed), v.size ());
         BOOST_UBLAS_CHECK (v.size () == e ().size (), bad_size ());
         typedef F<typename V::iterator::reference, typename E::value_type> functor_type;
         typedef typename V::size_type size_type;
@@ -381,9 +576,14 @@ namespace detail {
         typedef typename V::value_type value_type;
         typedef typename V::reference reference;
 #if BOOST_UBLAS_TYPE_CHECK
+#if BOOST_UBLAS_TYPE_CHECK_SAMPLES
+        detail::vector_type_check_sample<value_type> cv;
+        cv.template assign<F> (v, e);
+#else
         vector<value_type> cv (v.size ());
         indexing_vector_assign<scalar_assign> (cv, v);
         indexing_vector_assign<F> (cv, e);
+#endif
 #endif
         detail::make_conformant (v, e);
 
@@ -391,6 +591,9 @@ namespace detail {
         typename V::iterator it_end (v.end ());
         typename E::const_iterator ite (e ().begin ());
         typename E::const_iterator ite_end (e ().end ());
+        detail::gallop_vector_lookup<V> lookup (v);
+        detail::gallop_vector_lookup<const E> lookupe (e ());
+        std::size_t steps = 0, stepse = 0;
         if (it != it_end && ite != ite_end) {
             size_type it_index = it.index (), ite_index = ite.index ();
             while (true) {
@@ -398,6 +601,7 @@ namespace detail {
                 if (compare == 0) {
                     functor_type::apply (*it, *ite);
                     ++ it, ++ ite;
+                    steps = stepse = 0;
                     if (it != it_end && ite != ite_end) {
                         it_index = it.index ();
                         ite_index = ite.index ();
@@ -408,13 +612,15 @@ namespace detail {
                         functor_type::apply (*it, value_type/*zero*/());
                         ++ it;
                     } else
-                        increment (it, it_end, - compare);
+                        detail::gallop_increment (it, it_end, - compare, ite_index, steps, lookup);
+                    stepse = 0;
                     if (it != it_end)
                         it_index = it.index ();
                     else
                         break;
                 } else if (compare > 0) {
-                    increment (ite, ite_end, compare);
+                    detail::gallop_increment (ite, ite_end, compare, it_index, stepse, lookupe);
+                    steps = 0;
                     if (ite != ite_end)
                         ite_index = ite.index ();
                     else
@@ -448,6 +654,20 @@ namespace detail {
         vector_assign<F> (v, e, storage_category ());
     }
 
+    // Plain assignment with non temporal stores whatever the size, as noalias (v) = e
+    template<class V, class E>
+    BOOST_UBLAS_INLINE
+    void streaming_vector_assign (V &v, const vector_expression<E> &e) {
+        if (! detail::stream_vector_assign<scalar_assign> (v, e, 0))
+            vector_assign<scalar_assign> (v, e);
+    }
+    template<class V, class T>
+    BOOST_UBLAS_INLINE
+    void streaming_vector_assign_scalar (V &v, const T &t) {
+        if (! detail::stream_vector_assign_scalar<scalar_assign> (v, t, 0))
+            vector_assign_scalar<scalar_assign> (v, t);
+    }
+
     template<class SC, class RI>
     struct vector_swap_traits {
         typedef SC storage_category;
@@ -469,6 +689,10 @@ namespace detail {
     void vector_swap (V &v, vector_expression<E> &e, dense_proxy_tag) {
         typedef F<typename V::iterator::reference, typename E::iterator::reference> functor_type;
         typedef typename V::difference_type difference_type;
+#ifdef BOOST_UBLAS_SIMD
+        if (detail::simd_vector_swap<F> (v, e ()))
+            return;
+#endif
         difference_type size (BOOST_UBLAS_SAME (v.size (), e ().size ()));
         typename V::iterator it (v.begin ());
         typename E::iterator ite (e ().begin ());
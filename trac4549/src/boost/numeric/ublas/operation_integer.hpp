@@ -0,0 +1,258 @@
+//
+//  Copyright (c) 2000-2010
+//  Joerg Walter, Mathias Koch, Gunter Winkler
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+//  The authors gratefully acknowledge the support of
+//  GeNeSys mbH & Co. KG in producing this work.
+//
+
+#ifndef _BOOST_UBLAS_OPERATION_INTEGER_
+#define _BOOST_UBLAS_OPERATION_INTEGER_
+
+#include <boost/numeric/ublas/matrix_expression.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+// Products of matrices of integral value types. The products are accumulated in the
+// widest integer type of the signedness of the operands, so that the results are
+// exact whenever they are representable in the value type of the result.
+
+namespace boost { namespace numeric { namespace ublas {
+namespace detail {
+
+    template<class T>
+    struct integer_prod_traits {
+        typedef typename boost::mpl::if_c<std::numeric_limits<T>::is_signed,
+                                          boost::intmax_t, boost::uintmax_t>::type accumulator_type;
+
+        // Number of products of two T which can be summed in accumulator_type without
+        // overflow is 2^shift; a single product may overflow if shift is negative
+        static const int shift = std::numeric_limits<accumulator_type>::digits - 2 * std::numeric_limits<T>::digits -
+                                 (std::numeric_limits<T>::is_signed ? 1 : 0);
+
+        static std::size_t block () {
+            if (shift < 0)
+                return 0;
+            if (shift >= std::numeric_limits<std::size_t>::digits)
+                return (std::numeric_limits<std::size_t>::max) ();
+            // The guards above are not constant folded before the shift is diagnosed
+            return std::size_t (1) << (shift < 0 ? 0 : shift);
+        }
+    };
+
+    template<class A>
+    BOOST_UBLAS_INLINE
+    A saturating_add (A a, A b) {
+        if (b > A (0) && a > (std::numeric_limits<A>::max) () - b)
+            return (std::numeric_limits<A>::max) ();
+        if (std::numeric_limits<A>::is_signed && b < A (0) && a < (std::numeric_limits<A>::min) () - b)
+            return (std::numeric_limits<A>::min) ();
+        return a + b;
+    }
+
+    template<class A>
+    BOOST_UBLAS_INLINE
+    A saturating_mul (A a, A b) {
+        const A max = (std::numeric_limits<A>::max) ();
+        const A min = (std::numeric_limits<A>::min) ();
+        if (a == A (0) || b == A (0))
+            return A (0);
+        if (a > A (0)) {
+            if (b > A (0))
+                return a > max / b ? max : a * b;
+            return b < min / a ? min : a * b;
+        }
+        if (b > A (0))
+            return a < min / b ? min : a * b;
+        return b < max / a ? max : a * b;
+    }
+
+    // Nearest value of R
+    template<class R, class A>
+    BOOST_UBLAS_INLINE
+    R saturate_cast (A a) {
+        if (std::numeric_limits<A>::is_signed && a < A (0)) {
+            if (! std::numeric_limits<R>::is_signed)
+                return R (0);
+            return a < A ((std::numeric_limits<R>::min) ()) ? (std::numeric_limits<R>::min) () : R (a);
+        }
+        return boost::uintmax_t (a) > boost::uintmax_t ((std::numeric_limits<R>::max) ()) ?
+               (std::numeric_limits<R>::max) () : R (a);
+    }
+
+    // Modular accumulation: exact modulo 2^N, without undefined signed overflow
+    template<class T>
+    struct integer_prod_wrap {
+        typedef boost::uintmax_t accumulator_type;
+
+        static std::size_t block (std::size_t size) {
+            return size;
+        }
+        static accumulator_type mul (const T &a, const T &b) {
+            return accumulator_type (a) * accumulator_type (b);
+        }
+        static accumulator_type add (accumulator_type a, accumulator_type b) {
+            return a + b;
+        }
+        template<class R>
+        static R narrow (accumulator_type a) {
+            return R (a);
+        }
+    };
+
+    // Saturating accumulation: the sums of blocks of products which cannot overflow
+    // are added with saturation
+    template<class T>
+    struct integer_prod_saturate {
+        typedef typename integer_prod_traits<T>::accumulator_type accumulator_type;
+
+        static std::size_t block (std::size_t size) {
+            std::size_t block = integer_prod_traits<T>::block ();
+            return block == 0 ? 1 : (std::min) (block, size);
+        }
+        static accumulator_type mul (const T &a, const T &b) {
+            if (integer_prod_traits<T>::shift < 0)
+                return saturating_mul (accumulator_type (a), accumulator_type (b));
+            return accumulator_type (a) * accumulator_type (b);
+        }
+        static accumulator_type add (accumulator_type a, accumulator_type b) {
+            return saturating_add (a, b);
+        }
+        template<class R>
+        static R narrow (accumulator_type a) {
+            return saturate_cast<R> (a);
+        }
+    };
+
+    // m = e1 * e2 accumulated with P, one row at a time so that the rows of e2
+    // are traversed in storage order for row major operands
+    template<class P, class M, class E1, class E2>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void integer_prod (M &m, const E1 &e1, const E2 &e2) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+        typedef typename P::accumulator_type accumulator_type;
+        BOOST_STATIC_ASSERT (boost::is_integral<value_type>::value);
+        BOOST_UBLAS_CHECK (e1.size2 () == e2.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size1 () == e1.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e2.size2 (), bad_size ());
+        size_type size1 (e1.size1 ()), size2 (e2.size2 ()), size (e1.size2 ());
+        size_type block (P::block (size));
+        std::vector<accumulator_type> total (size2), partial (size2);
+        for (size_type i = 0; i < size1; ++ i) {
+            std::fill (total.begin (), total.end (), accumulator_type (0));
+            for (size_type kk = 0; kk < size; kk += block) {
+                size_type k_end ((std::min) (size, kk + block));
+                std::fill (partial.begin (), partial.end (), accumulator_type (0));
+                for (size_type k = kk; k < k_end; ++ k) {
+                    typename E1::value_type a (e1 (i, k));
+                    // Sparse rows, as in adjacency matrices, skip most of the work
+                    if (a == 0)
+                        continue;
+                    for (size_type j = 0; j < size2; ++ j)
+                        partial [j] += P::mul (a, e2 (k, j));
+                }
+                for (size_type j = 0; j < size2; ++ j)
+                    total [j] = P::add (total [j], partial [j]);
+            }
+            for (size_type j = 0; j < size2; ++ j)
+                m (i, j) = P::template narrow<value_type> (total [j]);
+        }
+    }
+
+    // Count of boolean_prod () in R: saturated for the integral types, converted for
+    // the others, whose limits cannot be compared with an integer
+    template<class R>
+    BOOST_UBLAS_INLINE
+    R boolean_prod_count (std::size_t count, boost::mpl::true_) {
+        return saturate_cast<R> (count);
+    }
+    template<class R>
+    BOOST_UBLAS_INLINE
+    R boolean_prod_count (std::size_t count, boost::mpl::false_) {
+        return R (count);
+    }
+
+    inline
+    int popcount (boost::uint64_t x) {
+#if defined (__GNUC__)
+        return __builtin_popcountll (x);
+#else
+        x = x - ((x >> 1) & 0x5555555555555555ULL);
+        x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+        x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return int ((x * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+}//namespace detail
+
+    // m = e1 * e2, exact when the results are representable in the value type of m,
+    // wrapped modulo 2^N otherwise. All the value types must be integral.
+    template<class M, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    M &integer_prod (const matrix_expression<E1> &e1, const matrix_expression<E2> &e2, M &m) {
+        typedef typename promote_traits<typename E1::value_type, typename E2::value_type>::promote_type value_type;
+        BOOST_STATIC_ASSERT (boost::is_integral<value_type>::value);
+        detail::integer_prod<detail::integer_prod_wrap<value_type> > (m, e1 (), e2 ());
+        return m;
+    }
+
+    // m = e1 * e2 where the products, the sums and the results saturate at the limits
+    // of the accumulator and of the value type of m instead of wrapping
+    template<class M, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    M &saturating_prod (const matrix_expression<E1> &e1, const matrix_expression<E2> &e2, M &m) {
+        typedef typename promote_traits<typename E1::value_type, typename E2::value_type>::promote_type value_type;
+        BOOST_STATIC_ASSERT (boost::is_integral<value_type>::value);
+        detail::integer_prod<detail::integer_prod_saturate<value_type> > (m, e1 (), e2 ());
+        return m;
+    }
+
+    // m (i, j) = number of k for which e1 (i, k) and e2 (k, j) are both non zero, computed
+    // with population counts of bit packed rows of e1 and columns of e2. For matrix<bool>
+    // this is the boolean matrix product; for adjacency matrices the number of paths of
+    // length 2. The counts saturate at the maximum of an integral value type of m.
+    template<class M, class E1, class E2>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    M &boolean_prod (const matrix_expression<E1> &e1, const matrix_expression<E2> &e2, M &m) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+        BOOST_UBLAS_CHECK (e1 ().size2 () == e2 ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size1 () == e1 ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e2 ().size2 (), bad_size ());
+        size_type size1 (e1 ().size1 ()), size2 (e2 ().size2 ()), size (e1 ().size2 ());
+        size_type words ((size + 63) / 64);
+        std::vector<boost::uint64_t> rows (size1 * words), columns (size2 * words);
+        for (size_type i = 0; i < size1; ++ i)
+            for (size_type k = 0; k < size; ++ k)
+                if (e1 () (i, k) != typename E1::value_type (0))
+                    rows [i * words + k / 64] |= boost::uint64_t (1) << (k % 64);
+        for (size_type k = 0; k < size; ++ k)
+            for (size_type j = 0; j < size2; ++ j)
+                if (e2 () (k, j) != typename E2::value_type (0))
+                    columns [j * words + k / 64] |= boost::uint64_t (1) << (k % 64);
+        for (size_type i = 0; i < size1; ++ i)
+            for (size_type j = 0; j < size2; ++ j) {
+                std::size_t count = 0;
+                for (size_type w = 0; w < words; ++ w)
+                    count += detail::popcount (rows [i * words + w] & columns [j * words + w]);
+                m (i, j) = detail::boolean_prod_count<value_type> (count, boost::mpl::bool_<boost::is_integral<value_type>::value> ());
+            }
+        return m;
+    }
+
+}}}
+
+#endif
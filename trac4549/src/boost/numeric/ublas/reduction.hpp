@@ -0,0 +1,631 @@
+//
+//  Copyright (c) 2000-2010
+//  Joerg Walter, Mathias Koch, Gunter Winkler
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+//  The authors gratefully acknowledge the support of
+//  GeNeSys mbH & Co. KG in producing this work.
+//
+
+#ifndef _BOOST_UBLAS_REDUCTION_
+#define _BOOST_UBLAS_REDUCTION_
+
+#include <boost/numeric/ublas/vector_expression.hpp>
+#include <boost/numeric/ublas/matrix_expression.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+// Reproducible reductions. The index range is cut into chunks of
+// BOOST_UBLAS_REDUCTION_CHUNK_SIZE elements, each chunk is reduced on its own and
+// the results of the chunks are combined by a balanced tree whose shape depends only
+// on the number of chunks. The chunks are reduced in parallel with
+// BOOST_UBLAS_PARALLEL_REDUCTION, and the results are the same, bit for bit, whatever
+// the number of threads, and for dense and sparse storage of the same values (up to
+// the sign of zero results and, for inner products, the zeros of sparse operands times
+// infinities). They may differ in the last bits from sum (), norm_1 (), norm_2 () and
+// inner_prod (), which sum in index order.
+//
+// The terms of a chunk, and of the lines of the matrix norms, are summed in index
+// order by default. With BOOST_UBLAS_PAIRWISE_REDUCTION they are summed in 8 lanes
+// (the term of index i in lane i % 8) which are then added pairwise; with
+// BOOST_UBLAS_COMPENSATED_REDUCTION the lanes are compensated sums of the floating
+// point terms, as Neumaier's. The lanes are independent, so that the compiler can
+// keep them in SIMD registers, and their number does not depend on the instruction
+// set, so neither do the results. The compensated sum of each chunk is rounded once
+// before the results of the chunks are combined.
+
+namespace boost { namespace numeric { namespace ublas {
+namespace detail {
+
+    // Sum of the terms in index order
+    template<class T>
+    class naive_accumulator {
+    public:
+        static const int lanes = 1;
+
+        BOOST_UBLAS_INLINE
+        naive_accumulator ():
+            s_ () {}
+
+        template<class S>
+        BOOST_UBLAS_INLINE
+        void add (S, const T &x) {
+            s_ += x;
+        }
+        BOOST_UBLAS_INLINE
+        void add_lanes (const T *x) {
+            s_ += x [0];
+        }
+        BOOST_UBLAS_INLINE
+        T result () const {
+            return s_;
+        }
+
+    private:
+        T s_;
+    };
+
+    // Sums of 8 lanes added pairwise
+    template<class T>
+    class pairwise_accumulator {
+    public:
+        static const int lanes = 8;
+
+        BOOST_UBLAS_INLINE
+        pairwise_accumulator () {
+            for (int l = 0; l < lanes; ++ l)
+                s_ [l] = T ();
+        }
+
+        template<class S>
+        BOOST_UBLAS_INLINE
+        void add (S i, const T &x) {
+            s_ [i % lanes] += x;
+        }
+        // Terms of indices i, ..., i + 7 where i is a multiple of 8
+        BOOST_UBLAS_INLINE
+        void add_lanes (const T *x) {
+            for (int l = 0; l < lanes; ++ l)
+                s_ [l] += x [l];
+        }
+        BOOST_UBLAS_INLINE
+        T result () const {
+            return ((s_ [0] + s_ [1]) + (s_ [2] + s_ [3])) + ((s_ [4] + s_ [5]) + (s_ [6] + s_ [7]));
+        }
+
+    private:
+        T s_ [lanes];
+    };
+
+    // Compensated sums of 8 lanes, as Neumaier's: the rounding error of each addition
+    // is accumulated apart and added at the end
+    template<class T>
+    class compensated_accumulator {
+    public:
+        static const int lanes = 8;
+
+        BOOST_UBLAS_INLINE
+        compensated_accumulator () {
+            for (int l = 0; l < lanes; ++ l)
+                s_ [l] = c_ [l] = T ();
+        }
+
+        template<class S>
+        BOOST_UBLAS_INLINE
+        void add (S i, const T &x) {
+            add (s_ [i % lanes], c_ [i % lanes], x);
+        }
+        // Terms of indices i, ..., i + 7 where i is a multiple of 8
+        BOOST_UBLAS_INLINE
+        void add_lanes (const T *x) {
+            for (int l = 0; l < lanes; ++ l)
+                add (s_ [l], c_ [l], x [l]);
+        }
+        BOOST_UBLAS_INLINE
+        T result () const {
+            T s (s_ [0]), c (c_ [0]);
+            for (int l = 1; l < lanes; ++ l) {
+                add (s, c, s_ [l]);
+                c += c_ [l];
+            }
+            return s + c;
+        }
+
+    private:
+        static BOOST_UBLAS_INLINE
+        void add (T &s, T &c, const T &x) {
+            // Knuth's two sum: the rounding error whatever the magnitudes of s and x,
+            // without branch, so that the lanes can be vectorized
+            T t (s + x);
+            T z (t - s);
+            c += (s - (t - z)) + (x - z);
+            s = t;
+        }
+
+        T s_ [lanes];
+        T c_ [lanes];
+    };
+    // Real and imaginary parts apart
+    template<class T>
+    class compensated_accumulator<std::complex<T> > {
+    public:
+        static const int lanes = compensated_accumulator<T>::lanes;
+
+        template<class S>
+        BOOST_UBLAS_INLINE
+        void add (S i, const std::complex<T> &x) {
+            real_.add (i, x.real ());
+            imag_.add (i, x.imag ());
+        }
+        BOOST_UBLAS_INLINE
+        void add_lanes (const std::complex<T> *x) {
+            T r [lanes], m [lanes];
+            for (int l = 0; l < lanes; ++ l) {
+                r [l] = x [l].real ();
+                m [l] = x [l].imag ();
+            }
+            real_.add_lanes (r);
+            imag_.add_lanes (m);
+        }
+        BOOST_UBLAS_INLINE
+        std::complex<T> result () const {
+            return std::complex<T> (real_.result (), imag_.result ());
+        }
+
+    private:
+        compensated_accumulator<T> real_;
+        compensated_accumulator<T> imag_;
+    };
+
+    // Accumulation of the sums selected by the configuration; integral sums are exact
+    template<class T>
+    struct sum_accumulator {
+#if defined (BOOST_UBLAS_COMPENSATED_REDUCTION)
+        typedef typename boost::mpl::if_<boost::is_integral<T>,
+                                         naive_accumulator<T>,
+                                         compensated_accumulator<T> >::type type;
+#elif defined (BOOST_UBLAS_PAIRWISE_REDUCTION)
+        typedef pairwise_accumulator<T> type;
+#else
+        typedef naive_accumulator<T> type;
+#endif
+    };
+
+    // Maximum of non negative values
+    template<class T>
+    class max_accumulator {
+    public:
+        static const int lanes = 1;
+
+        BOOST_UBLAS_INLINE
+        max_accumulator ():
+            t_ () {}
+
+        template<class S>
+        BOOST_UBLAS_INLINE
+        void add (S, const T &x) {
+            if (t_ < x)
+                t_ = x;
+        }
+        BOOST_UBLAS_INLINE
+        void add_lanes (const T *x) {
+            add (0, x [0]);
+        }
+        BOOST_UBLAS_INLINE
+        T result () const {
+            return t_;
+        }
+
+    private:
+        T t_;
+    };
+
+    // Combinations of partial results
+    template<class T>
+    struct reduce_plus {
+        typedef T result_type;
+        typedef typename sum_accumulator<T>::type accumulator_type;
+
+        static BOOST_UBLAS_INLINE
+        result_type identity () {
+            return result_type ();
+        }
+        static BOOST_UBLAS_INLINE
+        result_type apply (const result_type &t, const result_type &u) {
+            return t + u;
+        }
+    };
+    // Maximum of non negative values
+    template<class T>
+    struct reduce_max {
+        typedef T result_type;
+        typedef max_accumulator<T> accumulator_type;
+
+        static BOOST_UBLAS_INLINE
+        result_type identity () {
+            return result_type ();
+        }
+        static BOOST_UBLAS_INLINE
+        result_type apply (const result_type &t, const result_type &u) {
+            return t < u ? u : t;
+        }
+    };
+
+    // Terms of the reductions. The elements of the driver expression are visited (all
+    // of them if it is dense, its non zeros if it is sparse) and x (i, d) is the term of
+    // index i where d is the element of index i of the driver.
+    template<class E, class R>
+    class reduce_sum_term {
+    public:
+        typedef E driver_type;
+        typedef R result_type;
+
+        BOOST_UBLAS_INLINE
+        explicit reduce_sum_term (const E &e):
+            e_ (e) {}
+
+        BOOST_UBLAS_INLINE
+        const driver_type &driver () const {
+            return e_;
+        }
+        template<class S, class D>
+        BOOST_UBLAS_INLINE
+        result_type operator () (S, const D &d) const {
+            return d;
+        }
+
+    private:
+        const E &e_;
+    };
+    template<class E, class R>
+    class reduce_norm_1_term {
+    public:
+        typedef E driver_type;
+        typedef R result_type;
+
+        BOOST_UBLAS_INLINE
+        explicit reduce_norm_1_term (const E &e):
+            e_ (e) {}
+
+        BOOST_UBLAS_INLINE
+        const driver_type &driver () const {
+            return e_;
+        }
+        template<class S, class D>
+        BOOST_UBLAS_INLINE
+        result_type operator () (S, const D &d) const {
+            return type_traits<typename E::value_type>::norm_1 (d);
+        }
+
+    private:
+        const E &e_;
+    };
+    template<class E, class R>
+    class reduce_norm_2_square_term {
+    public:
+        typedef E driver_type;
+        typedef R result_type;
+
+        BOOST_UBLAS_INLINE
+        explicit reduce_norm_2_square_term (const E &e):
+            e_ (e) {}
+
+        BOOST_UBLAS_INLINE
+        const driver_type &driver () const {
+            return e_;
+        }
+        template<class S, class D>
+        BOOST_UBLAS_INLINE
+        result_type operator () (S, const D &d) const {
+            result_type u (type_traits<typename E::value_type>::norm_2 (d));
+            return u * u;
+        }
+
+    private:
+        const E &e_;
+    };
+    template<class E, class R>
+    class reduce_norm_inf_term {
+    public:
+        typedef E driver_type;
+        typedef R result_type;
+
+        BOOST_UBLAS_INLINE
+        explicit reduce_norm_inf_term (const E &e):
+            e_ (e) {}
+
+        BOOST_UBLAS_INLINE
+        const driver_type &driver () const {
+            return e_;
+        }
+        template<class S, class D>
+        BOOST_UBLAS_INLINE
+        result_type operator () (S, const D &d) const {
+            return type_traits<typename E::value_type>::norm_inf (d);
+        }
+
+    private:
+        const E &e_;
+    };
+    // Storage whose reduction visits the stored elements only: the dense and packed
+    // tags derive from sparse_proxy_tag too, but are reduced over every index
+    template<class E>
+    struct reduce_sparse {
+        static const bool value = boost::is_convertible<typename E::storage_category, sparse_proxy_tag>::value &&
+                                  ! boost::is_convertible<typename E::storage_category, packed_proxy_tag>::value;
+    };
+
+    // The driver is the sparse operand if any; the products commute exactly
+    template<class E1, class E2, class R>
+    class reduce_inner_prod_term {
+    public:
+        typedef E1 driver_type;
+        typedef R result_type;
+
+        BOOST_UBLAS_INLINE
+        reduce_inner_prod_term (const E1 &e1, const E2 &e2):
+            e1_ (e1), e2_ (e2) {}
+
+        BOOST_UBLAS_INLINE
+        const driver_type &driver () const {
+            return e1_;
+        }
+        template<class S, class D>
+        BOOST_UBLAS_INLINE
+        result_type operator () (S i, const D &d) const {
+            return d * e2_ (i);
+        }
+
+    private:
+        const E1 &e1_;
+        const E2 &e2_;
+    };
+
+    // Balanced combination of the results of the chunks, in place
+    template<class O>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    typename O::result_type reduce_tree (std::vector<typename O::result_type> &partial) {
+        typedef typename std::vector<typename O::result_type>::size_type size_type;
+        size_type size (partial.size ());
+        if (size == 0)
+            return O::identity ();
+        while (size > 1) {
+            size_type half (size / 2);
+            for (size_type k = 0; k < half; ++ k)
+                partial [k] = O::apply (partial [2 * k], partial [2 * k + 1]);
+            if (size % 2 != 0)
+                partial [half] = partial [size - 1];
+            size = half + size % 2;
+        }
+        return partial [0];
+    }
+
+    // Chunk of a dense driver, the terms of each lane group computed together
+    template<class O, class X, class S>
+    BOOST_UBLAS_INLINE
+    typename O::result_type reduce_chunk (const X &x, S begin, S end) {
+        typedef typename O::accumulator_type accumulator_type;
+        const S lanes = accumulator_type::lanes;
+        accumulator_type a;
+        S i (begin);
+        for (; i < end && i % lanes != 0; ++ i)
+            a.add (i, x (i, x.driver () (i)));
+        for (; i + lanes <= end; i += lanes) {
+            typename O::result_type t [accumulator_type::lanes];
+            for (S l = 0; l < lanes; ++ l)
+                t [l] = x (i + l, x.driver () (i + l));
+            a.add_lanes (t);
+        }
+        for (; i < end; ++ i)
+            a.add (i, x (i, x.driver () (i)));
+        return a.result ();
+    }
+
+    // Dense (proxy) case
+    template<class O, class X>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    typename O::result_type vector_reduce (const X &x, dense_proxy_tag) {
+        typedef typename X::driver_type::size_type size_type;
+        typedef typename X::driver_type::difference_type difference_type;
+        const size_type chunk = BOOST_UBLAS_REDUCTION_CHUNK_SIZE;
+        size_type size (x.driver ().size ());
+        difference_type chunks ((size + chunk - 1) / chunk);
+        std::vector<typename O::result_type> partial (chunks);
+#if defined (BOOST_UBLAS_PARALLEL_REDUCTION) && defined (_OPENMP)
+#pragma omp parallel for schedule(static) if (size >= BOOST_UBLAS_PARALLEL_REDUCTION_THRESHOLD)
+#endif
+        for (difference_type c = 0; c < chunks; ++ c)
+            partial [c] = reduce_chunk<O> (x, size_type (c) * chunk, (std::min) (size, size_type (c + 1) * chunk));
+        return reduce_tree<O> (partial);
+    }
+    // Packed (proxy) case
+    template<class O, class X>
+    BOOST_UBLAS_INLINE
+    typename O::result_type vector_reduce (const X &x, packed_proxy_tag) {
+        return vector_reduce<O> (x, dense_proxy_tag ());
+    }
+    // Sparse (proxy) case: the non zeros are visited in index order, and the terms of
+    // each chunk are summed in the lanes of the dense case
+    template<class O, class X>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    typename O::result_type vector_reduce (const X &x, sparse_proxy_tag) {
+        typedef typename X::driver_type::size_type size_type;
+        typedef typename O::result_type result_type;
+        const size_type chunk = BOOST_UBLAS_REDUCTION_CHUNK_SIZE;
+        size_type size (x.driver ().size ());
+        std::vector<result_type> partial ((size + chunk - 1) / chunk, O::identity ());
+        typename X::driver_type::const_iterator it (x.driver ().begin ());
+        typename X::driver_type::const_iterator it_end (x.driver ().end ());
+        while (it != it_end) {
+            size_type c (it.index () / chunk);
+            typename O::accumulator_type a;
+            for (; it != it_end && it.index () / chunk == c; ++ it)
+                a.add (it.index (), x (it.index (), *it));
+            partial [c] = a.result ();
+        }
+        return reduce_tree<O> (partial);
+    }
+
+    // Dispatcher
+    template<class O, class X>
+    BOOST_UBLAS_INLINE
+    typename O::result_type vector_reduce (const X &x) {
+        typedef typename X::driver_type::storage_category storage_category;
+        return vector_reduce<O> (x, storage_category ());
+    }
+
+    // Reduction of the major lines of a matrix, in chunks of whole lines
+    template<class O, class E, class F>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    typename O::result_type matrix_reduce (const E &e, F f) {
+        typedef typename E::size_type size_type;
+        typedef typename E::difference_type difference_type;
+        typedef typename boost::mpl::if_<boost::is_same<typename E::orientation_category, column_major_tag>,
+                                         column_major_tag, row_major_tag>::type orientation_category;
+        bool row_major (boost::is_same<orientation_category, row_major_tag>::value);
+        size_type size_M (row_major ? e.size1 () : e.size2 ());
+        size_type size_m (row_major ? e.size2 () : e.size1 ());
+        size_type lines ((std::max) (size_type (1), BOOST_UBLAS_REDUCTION_CHUNK_SIZE / (std::max) (size_m, size_type (1))));
+        difference_type chunks ((size_M + lines - 1) / lines);
+        std::vector<typename O::result_type> partial (chunks);
+#if defined (BOOST_UBLAS_PARALLEL_REDUCTION) && defined (_OPENMP)
+#pragma omp parallel for schedule(static) if (size_M * size_m >= BOOST_UBLAS_PARALLEL_REDUCTION_THRESHOLD)
+#endif
+        for (difference_type c = 0; c < chunks; ++ c) {
+            // Lanes keyed by the position of the element in the major order
+            typename O::accumulator_type a;
+            size_type k_end ((std::min) (size_M, size_type (c + 1) * lines));
+            for (size_type k = size_type (c) * lines; k < k_end; ++ k)
+                for (size_type l = 0; l < size_m; ++ l)
+                    a.add (k * size_m + l, row_major ? f (e (k, l)) : f (e (l, k)));
+            partial [c] = a.result ();
+        }
+        return reduce_tree<O> (partial);
+    }
+
+    // Sums of the absolute values of the lines, in parallel over the lines
+    template<class E, class R>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    R matrix_line_norm_max (const E &e, bool rows) {
+        typedef typename E::size_type size_type;
+        typedef typename E::difference_type difference_type;
+        difference_type lines (rows ? e.size1 () : e.size2 ());
+        size_type size (rows ? e.size2 () : e.size1 ());
+        std::vector<R> partial (lines);
+#if defined (BOOST_UBLAS_PARALLEL_REDUCTION) && defined (_OPENMP)
+#pragma omp parallel for schedule(static) if (e.size1 () * e.size2 () >= BOOST_UBLAS_PARALLEL_REDUCTION_THRESHOLD)
+#endif
+        for (difference_type k = 0; k < lines; ++ k) {
+            typename sum_accumulator<R>::type a;
+            for (size_type l = 0; l < size; ++ l)
+                a.add (l, type_traits<typename E::value_type>::norm_1 (rows ? e (k, l) : e (l, k)));
+            partial [k] = a.result ();
+        }
+        R t = R ();
+        for (difference_type k = 0; k < lines; ++ k)
+            t = reduce_max<R>::apply (t, partial [k]);
+        return t;
+    }
+
+    template<class V, class R>
+    struct reduce_norm_2_square_function {
+        BOOST_UBLAS_INLINE
+        R operator () (const V &v) const {
+            R u (type_traits<V>::norm_2 (v));
+            return u * u;
+        }
+    };
+
+}//namespace detail
+
+    // Reproducible sum
+    template<class E>
+    BOOST_UBLAS_INLINE
+    typename E::value_type
+    reproducible_sum (const vector_expression<E> &e) {
+        typedef typename E::value_type value_type;
+        return detail::vector_reduce<detail::reduce_plus<value_type> > (detail::reduce_sum_term<E, value_type> (e ()));
+    }
+
+    // Reproducible sum of the absolute values
+    template<class E>
+    BOOST_UBLAS_INLINE
+    typename type_traits<typename E::value_type>::real_type
+    reproducible_norm_1 (const vector_expression<E> &e) {
+        typedef typename type_traits<typename E::value_type>::real_type real_type;
+        return detail::vector_reduce<detail::reduce_plus<real_type> > (detail::reduce_norm_1_term<E, real_type> (e ()));
+    }
+
+    // Reproducible euclidean norm
+    template<class E>
+    BOOST_UBLAS_INLINE
+    typename type_traits<typename E::value_type>::real_type
+    reproducible_norm_2 (const vector_expression<E> &e) {
+        typedef typename type_traits<typename E::value_type>::real_type real_type;
+        real_type t (detail::vector_reduce<detail::reduce_plus<real_type> > (detail::reduce_norm_2_square_term<E, real_type> (e ())));
+        return type_traits<real_type>::type_sqrt (t);
+    }
+
+    // Maximum of the absolute values, computed in parallel; the maximum does not depend
+    // on the order of evaluation
+    template<class E>
+    BOOST_UBLAS_INLINE
+    typename type_traits<typename E::value_type>::real_type
+    reproducible_norm_inf (const vector_expression<E> &e) {
+        typedef typename type_traits<typename E::value_type>::real_type real_type;
+        return detail::vector_reduce<detail::reduce_max<real_type> > (detail::reduce_norm_inf_term<E, real_type> (e ()));
+    }
+
+    // Reproducible inner product
+    template<class E1, class E2>
+    BOOST_UBLAS_INLINE
+    typename promote_traits<typename E1::value_type, typename E2::value_type>::promote_type
+    reproducible_inner_prod (const vector_expression<E1> &e1, const vector_expression<E2> &e2) {
+        typedef typename promote_traits<typename E1::value_type, typename E2::value_type>::promote_type value_type;
+        BOOST_UBLAS_CHECK (e1 ().size () == e2 ().size (), bad_size ());
+        if (detail::reduce_sparse<E2>::value && ! detail::reduce_sparse<E1>::value)
+            return detail::vector_reduce<detail::reduce_plus<value_type> > (detail::reduce_inner_prod_term<E2, E1, value_type> (e2 (), e1 ()));
+        return detail::vector_reduce<detail::reduce_plus<value_type> > (detail::reduce_inner_prod_term<E1, E2, value_type> (e1 (), e2 ()));
+    }
+
+    // Reproducible maximum of the sums of the absolute values of the columns
+    template<class E>
+    BOOST_UBLAS_INLINE
+    typename type_traits<typename E::value_type>::real_type
+    reproducible_norm_1 (const matrix_expression<E> &e) {
+        typedef typename type_traits<typename E::value_type>::real_type real_type;
+        return detail::matrix_line_norm_max<E, real_type> (e (), false);
+    }
+
+    // Reproducible Frobenius norm
+    template<class E>
+    BOOST_UBLAS_INLINE
+    typename type_traits<typename E::value_type>::real_type
+    reproducible_norm_frobenius (const matrix_expression<E> &e) {
+        typedef typename type_traits<typename E::value_type>::real_type real_type;
+        real_type t (detail::matrix_reduce<detail::reduce_plus<real_type> > (e (), detail::reduce_norm_2_square_function<typename E::value_type, real_type> ()));
+        return type_traits<real_type>::type_sqrt (t);
+    }
+
+    // Reproducible maximum of the sums of the absolute values of the rows
+    template<class E>
+    BOOST_UBLAS_INLINE
+    typename type_traits<typename E::value_type>::real_type
+    reproducible_norm_inf (const matrix_expression<E> &e) {
+        typedef typename type_traits<typename E::value_type>::real_type real_type;
+        return detail::matrix_line_norm_max<E, real_type> (e (), true);
+    }
+
+}}}
+
+#endif
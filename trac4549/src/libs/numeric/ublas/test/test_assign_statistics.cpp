@@ -0,0 +1,77 @@
+// Collect the statistics of the assignment paths
+#define BOOST_UBLAS_ASSIGN_STATISTICS
+
+#include <boost/numeric/ublas/io.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <cstddef>
+#include <iostream>
+
+namespace ublas = boost::numeric::ublas;
+
+typedef double value_type;
+
+
+void test_assign_statistics()
+{
+	std::cout << "[test_assign_statistics] BEGIN" << std::endl;
+
+	std::size_t n1(5);
+	std::size_t n2(4);
+
+	ublas::matrix<value_type> A(n1,n2,1);
+	ublas::matrix<value_type> C(n1,n2);
+	ublas::compressed_matrix<value_type> S(n1,n2);
+	ublas::compressed_matrix<value_type> T(n1,n2);
+	ublas::vector<value_type> u(n1,2);
+	ublas::vector<value_type> v(n1);
+	T(1,2) = 3;
+
+	ublas::reset_assign_statistics();
+
+	ublas::noalias(C) = 2*A;
+	C.plus_assign(A);
+	C.plus_assign(A);
+	S.plus_assign(T);
+	ublas::noalias(v) = u;
+
+	bool ok(true);
+	ublas::assign_path_statistics const& dense(ublas::assign_statistics(ublas::assign_path_matrix_assign_dense_proxy, false));
+	ok = ok && dense.calls == 1 && dense.elements == n1*n2;
+	ublas::assign_path_statistics const& dense_computed(ublas::assign_statistics(ublas::assign_path_matrix_assign_dense_proxy, true));
+	ok = ok && dense_computed.calls == 2 && dense_computed.elements == 2*n1*n2;
+	ok = ok && ublas::assign_statistics(ublas::assign_path_matrix_assign_sparse_proxy_row_major, true).calls == 1;
+	ok = ok && ublas::assign_statistics(ublas::assign_path_matrix_make_conformant_compressed, false).calls == 1;
+	ok = ok && ublas::assign_statistics(ublas::assign_path_vector_assign_dense_proxy, false).calls == 1;
+	ok = ok && ublas::assign_statistics(ublas::assign_path_vector_assign_sparse_proxy, false).calls == 0;
+
+	ublas::dump_assign_statistics(std::cerr);
+
+	if (ok)
+	{
+		std::cout << "[test_assign_statistics] Path statistics succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_assign_statistics] Path statistics failed." << std::endl;
+	}
+
+	ublas::reset_assign_statistics();
+	if (ublas::assign_statistics(ublas::assign_path_matrix_assign_dense_proxy, true).calls == 0)
+	{
+		std::cout << "[test_assign_statistics] Reset succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_assign_statistics] Reset failed." << std::endl;
+	}
+
+	std::cout << "[test_assign_statistics] END" << std::endl;
+}
+
+
+int main()
+{
+	test_assign_statistics();
+}
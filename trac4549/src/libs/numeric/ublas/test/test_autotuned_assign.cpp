@@ -0,0 +1,138 @@
+// Calibrate every dense assignment, deciding after two timings of each method
+#define BOOST_UBLAS_AUTOTUNED_ASSIGN
+#define BOOST_UBLAS_AUTOTUNE_CALLS 2
+#define BOOST_UBLAS_AUTOTUNE_MIN_SIZE 0
+
+#include <boost/numeric/ublas/io.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <cstddef>
+#include <iostream>
+
+namespace ublas = boost::numeric::ublas;
+
+typedef double value_type;
+
+
+template <typename M1, typename M2>
+bool same_elements(M1 const& A, M2 const& B)
+{
+	if (A.size1() != B.size1() || A.size2() != B.size2())
+	{
+		return false;
+	}
+	for (std::size_t i = 0; i < A.size1(); ++i)
+	{
+		for (std::size_t j = 0; j < A.size2(); ++j)
+		{
+			if (A(i,j) != B(i,j))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+
+template <typename LayoutT>
+void test_autotuned_assign(char const* name)
+{
+	std::cout << "[test_autotuned_assign<" << name << ">] BEGIN" << std::endl;
+
+	std::size_t n1(31);
+	std::size_t n2(17);
+
+	ublas::matrix<value_type,LayoutT> A(n1,n2);
+	ublas::matrix<value_type,LayoutT> RES(n1,n2);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			A(i,j) = 0.5*i - j;
+		}
+	}
+
+	std::size_t entries(ublas::autotuned_assign_table().size());
+
+	// Calibration calls with both methods, then calls with the chosen one
+	ublas::matrix<value_type,LayoutT> C(n1,n2);
+	C = A;
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			RES(i,j) = A(i,j);
+		}
+	}
+	bool ok(true);
+	for (std::size_t k = 0; k < 6; ++k)
+	{
+		ublas::noalias(C) += 2*A;
+		C *= 0.5;
+		for (std::size_t i = 0; i < n1; ++i)
+		{
+			for (std::size_t j = 0; j < n2; ++j)
+			{
+				RES(i,j) = (RES(i,j) + 2*A(i,j))*0.5;
+			}
+		}
+		ok = ok && same_elements(C, RES);
+	}
+	if (ok)
+	{
+		std::cout << "[test_autotuned_assign<" << name << ">] Autotuned assignment succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_autotuned_assign<" << name << ">] Autotuned assignment failed." << std::endl;
+	}
+
+	// One decision for the expression and one for the scalar assignment
+	ok = ublas::autotuned_assign_table().size() == entries + 2;
+	for (std::size_t k = entries; k < ublas::autotuned_assign_table().size(); ++k)
+	{
+		ublas::autotuned_assign_entry const& entry(ublas::autotuned_assign_table()[k]);
+		ok = ok && entry.elements[0] == 2*n1*n2 && entry.elements[1] == 2*n1*n2;
+		std::cerr << "[test_autotuned_assign<" << name << ">] " << entry.signature
+		          << ": indexing " << entry.seconds[0] << "s, iterating " << entry.seconds[1]
+		          << "s, " << (entry.iterating ? "iterating" : "indexing") << std::endl;
+	}
+	if (ok)
+	{
+		std::cout << "[test_autotuned_assign<" << name << ">] Decision table succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_autotuned_assign<" << name << ">] Decision table failed." << std::endl;
+	}
+
+	// Sums of operands of the same orientation above the recursive tile size are calibrated too
+	std::size_t n(64);
+	ublas::matrix<value_type,LayoutT> B(n,n,1);
+	ublas::matrix<value_type,LayoutT> D(n,n,2);
+	ublas::matrix<value_type,LayoutT> S(n,n);
+	entries = ublas::autotuned_assign_table().size();
+	for (std::size_t k = 0; k < 6; ++k)
+	{
+		ublas::noalias(S) = B + D;
+	}
+	ok = ublas::autotuned_assign_table().size() == entries + 1 && same_elements(S, ublas::matrix<value_type,LayoutT>(n,n,3));
+	if (ok)
+	{
+		std::cout << "[test_autotuned_assign<" << name << ">] Calibrated sum succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_autotuned_assign<" << name << ">] Calibrated sum failed." << std::endl;
+	}
+
+	std::cout << "[test_autotuned_assign<" << name << ">] END" << std::endl;
+}
+
+
+int main()
+{
+	test_autotuned_assign<ublas::row_major>("row_major");
+	test_autotuned_assign<ublas::column_major>("column_major");
+}
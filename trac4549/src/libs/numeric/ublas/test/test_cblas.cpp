@@ -0,0 +1,418 @@
+// Every product, inner product and triangular solve by the CBLAS (link with -lblas)
+#define BOOST_UBLAS_CBLAS
+#define BOOST_UBLAS_CBLAS_THRESHOLD 0
+
+#include <boost/numeric/ublas/io.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+#include <boost/numeric/ublas/triangular.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <complex>
+#include <cstddef>
+#include <iostream>
+
+namespace ublas = boost::numeric::ublas;
+
+
+// Multiples of 1/8 of either sign
+template <typename ValueT>
+struct test_value
+{
+	static ValueT get(std::size_t i, std::size_t j)
+	{
+		return ValueT(double((3*i+7*j) % 11)/8 - 0.5);
+	}
+};
+
+template <typename T>
+struct test_value< std::complex<T> >
+{
+	static std::complex<T> get(std::size_t i, std::size_t j)
+	{
+		return std::complex<T>(test_value<T>::get(i, j), test_value<T>::get(j, i+1));
+	}
+};
+
+template <typename M>
+void fill(M& m)
+{
+	for (std::size_t i = 0; i < m.size1(); ++i)
+	{
+		for (std::size_t j = 0; j < m.size2(); ++j)
+		{
+			m(i,j) = test_value<typename M::value_type>::get(i, j);
+		}
+	}
+}
+
+template <typename V>
+void fill_vector(V& v)
+{
+	for (std::size_t i = 0; i < v.size(); ++i)
+	{
+		v(i) = test_value<typename V::value_type>::get(i, 2*i);
+	}
+}
+
+
+// The terms are multiples of 1/64 and their sums small: the results are exact
+// whatever the order of the sums
+template <typename M1, typename M2>
+bool same_elements(M1 const& a, M2 const& b)
+{
+	if (a.size1() != b.size1() || a.size2() != b.size2())
+	{
+		return false;
+	}
+	for (std::size_t i = 0; i < a.size1(); ++i)
+	{
+		for (std::size_t j = 0; j < a.size2(); ++j)
+		{
+			if (a(i,j) != b(i,j))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+template <typename V1, typename V2>
+bool same_vector_elements(V1 const& a, V2 const& b)
+{
+	if (a.size() != b.size())
+	{
+		return false;
+	}
+	for (std::size_t i = 0; i < a.size(); ++i)
+	{
+		if (a(i) != b(i))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+template <typename M1, typename M2, typename M3>
+M3 reference_prod(M1 const& a, M2 const& b, M3 const& c)
+{
+	M3 r(c);
+	for (std::size_t i = 0; i < a.size1(); ++i)
+	{
+		for (std::size_t j = 0; j < b.size2(); ++j)
+		{
+			typename M3::value_type t = typename M3::value_type();
+			for (std::size_t k = 0; k < a.size2(); ++k)
+			{
+				t += a(i,k)*b(k,j);
+			}
+			r(i,j) = t;
+		}
+	}
+	return r;
+}
+
+
+template <typename ValueT, typename Layout1, typename Layout2, typename Layout3>
+void test_cblas_prod(char const* name)
+{
+	std::cout << "[test_cblas_prod<" << name << ">] BEGIN" << std::endl;
+
+	std::size_t n1(29);
+	std::size_t n2(45);
+	std::size_t n(37);
+
+	ublas::matrix<ValueT,Layout1> A(n1,n);
+	ublas::matrix<ValueT,Layout2> B(n,n2);
+	fill(A);
+	fill(B);
+	ublas::matrix<ValueT,Layout3> R(reference_prod(A, B, ublas::matrix<ValueT,Layout3>(n1,n2)));
+
+	bool ok(true);
+
+	// Matrix products (gemm)
+	ublas::matrix<ValueT,Layout3> C(ublas::prod(A, B));
+	ok = ok && same_elements(C, R);
+
+	ublas::matrix<ValueT,Layout3> D(n1,n2);
+	ok = ok && ublas::detail::cblas_matrix_assign<ublas::scalar_assign>(D, ublas::prod(A, B));
+	ok = ok && same_elements(D, R);
+	ublas::noalias(D) += ublas::prod(A, B);
+	ok = ok && same_elements(D, ValueT(2)*R);
+	ublas::noalias(D) -= ublas::prod(A, B);
+	ok = ok && same_elements(D, R);
+
+	ublas::matrix<ValueT,Layout3> E(n1,n2);
+	ublas::axpy_prod(A, B, E);
+	ok = ok && same_elements(E, R);
+	ublas::axpy_prod(A, B, E, false);
+	ok = ok && same_elements(E, ValueT(2)*R);
+
+	// Ranges of the operands and of the result: the leading dimensions of the containers
+	ublas::range r1(3, 20), r2(5, 40), r(1, 30);
+	ublas::matrix<ValueT,Layout3> F(n1,n2, ValueT(1));
+	ublas::matrix_range< ublas::matrix<ValueT,Layout3> > Fp(F, r1, r2);
+	ok = ok && ublas::detail::cblas_matrix_assign<ublas::scalar_assign>(Fp, ublas::prod(ublas::project(A, r1, r), ublas::project(B, r, r2)));
+	ublas::matrix<ValueT,Layout3> Fr(reference_prod(ublas::project(A, r1, r), ublas::project(B, r, r2),
+	                                                ublas::matrix<ValueT,Layout3>(r1.size(), r2.size())));
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			bool inside(i >= r1.start() && i < r1.start()+r1.size() && j >= r2.start() && j < r2.start()+r2.size());
+			ok = ok && F(i,j) == (inside ? Fr(i-r1.start(), j-r2.start()) : ValueT(1));
+		}
+	}
+
+	// Matrix vector products (gemv)
+	ublas::vector<ValueT> x(n), y(n1);
+	fill_vector(x);
+	fill_vector(y);
+	ublas::matrix<ValueT> X(n,1), Y(n1,1);
+	ublas::column(X, 0) = x;
+	ublas::column(Y, 0) = y;
+	ublas::matrix<ValueT> Ax(reference_prod(A, X, ublas::matrix<ValueT>(n1,1)));
+	ublas::matrix<ValueT> yA(reference_prod(ublas::trans(Y), A, ublas::matrix<ValueT>(1,n)));
+
+	ublas::vector<ValueT> u(n1);
+	ok = ok && ublas::detail::cblas_vector_assign<ublas::scalar_assign>(u, ublas::prod(A, x));
+	ok = ok && same_vector_elements(u, ublas::column(Ax, 0));
+	ublas::vector<ValueT> v(ublas::prod(y, A));
+	ok = ok && ublas::detail::cblas_vector_assign<ublas::scalar_assign>(v, ublas::prod(y, A));
+	ok = ok && same_vector_elements(v, ublas::row(yA, 0));
+	ublas::noalias(v) -= ublas::prod(y, A);
+	ok = ok && same_vector_elements(v, ublas::zero_vector<ValueT>(n));
+	ublas::axpy_prod(A, x, u, false);
+	ok = ok && same_vector_elements(u, ValueT(2)*ublas::column(Ax, 0));
+	ublas::axpy_prod(y, A, v);
+	ok = ok && same_vector_elements(v, ublas::row(yA, 0));
+
+	// Inner products (dot), without conjugation
+	ValueT t = ValueT();
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		t += x(i)*ublas::column(B, 3)(i);
+	}
+	ublas::vector<ValueT> b3(ublas::column(B, 3));
+	ValueT s = ValueT();
+	ok = ok && ublas::detail::cblas_inner_prod(x, b3, s) && s == t;
+	ok = ok && ublas::inner_prod(x, b3) == t;
+
+	if (ok)
+	{
+		std::cout << "[test_cblas_prod<" << name << ">] Products succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_cblas_prod<" << name << ">] Products failed." << std::endl;
+	}
+
+	std::cout << "[test_cblas_prod<" << name << ">] END" << std::endl;
+}
+
+
+// Triangular matrix with a diagonal of 2 (1 for the unit tags) and small multiples of
+// 1/8 elsewhere: the products by it of multiples of 1/8, and the solves, are exact
+template <typename M>
+void fill_triangular(M& m, bool lower)
+{
+	typedef typename M::value_type value_type;
+	for (std::size_t i = 0; i < m.size1(); ++i)
+	{
+		for (std::size_t j = 0; j < m.size2(); ++j)
+		{
+			m(i,j) = i == j ? value_type(2) : ((i > j) == lower ? test_value<value_type>::get(i, j) : value_type(7));
+		}
+	}
+}
+
+template <typename ValueT, typename Layout1, typename Layout2, typename Tag>
+bool check_solve(bool lower)
+{
+	std::size_t n(23);
+	std::size_t k(9);
+
+	ublas::matrix<ValueT,Layout1> A(n,n);
+	fill_triangular(A, lower);
+	ublas::matrix<ValueT,Layout1> T(n,n, ValueT());
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		for (std::size_t j = 0; j < n; ++j)
+		{
+			if (i == j)
+			{
+				T(i,j) = ublas::detail::cblas_triangular<Tag>::unit ? ValueT(1) : A(i,j);
+			}
+			else if ((i > j) == lower)
+			{
+				T(i,j) = A(i,j);
+			}
+		}
+	}
+
+	ublas::matrix<ValueT,Layout2> X(n,k);
+	fill(X);
+	ublas::matrix<ValueT,Layout2> B(reference_prod(T, X, ublas::matrix<ValueT,Layout2>(n,k)));
+
+	bool ok(true);
+
+	ublas::matrix<ValueT,Layout2> S(B);
+	ok = ok && ublas::detail::cblas_inplace_solve<Tag>(A, S);
+	ok = ok && same_elements(S, X);
+	ok = ok && same_elements(ublas::solve(A, B, Tag()), X);
+
+	ublas::vector<ValueT> x(ublas::column(X, 2));
+	ublas::vector<ValueT> b(ublas::column(B, 2));
+	ublas::vector<ValueT> s(b);
+	ok = ok && ublas::detail::cblas_inplace_solve<Tag>(A, s);
+	ok = ok && same_vector_elements(s, x);
+	ok = ok && same_vector_elements(ublas::solve(A, b, Tag()), x);
+
+	return ok;
+}
+
+template <typename ValueT, typename Layout1, typename Layout2>
+void test_cblas_solve(char const* name)
+{
+	std::cout << "[test_cblas_solve<" << name << ">] BEGIN" << std::endl;
+
+	bool ok(true);
+	ok = ok && check_solve<ValueT,Layout1,Layout2,ublas::lower_tag>(true);
+	ok = ok && check_solve<ValueT,Layout1,Layout2,ublas::upper_tag>(false);
+	ok = ok && check_solve<ValueT,Layout1,Layout2,ublas::unit_lower_tag>(true);
+	ok = ok && check_solve<ValueT,Layout1,Layout2,ublas::unit_upper_tag>(false);
+
+	if (ok)
+	{
+		std::cout << "[test_cblas_solve<" << name << ">] Solves succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_cblas_solve<" << name << ">] Solves failed." << std::endl;
+	}
+
+	std::cout << "[test_cblas_solve<" << name << ">] END" << std::endl;
+}
+
+
+void test_cblas_singular()
+{
+	std::cout << "[test_cblas_singular] BEGIN" << std::endl;
+
+	std::size_t n(12);
+	ublas::matrix<double> A(n,n);
+	fill_triangular(A, true);
+	A(5,5) = 0;
+	ublas::vector<double> b(n, 1);
+	ublas::matrix<double> B(n,3, 1);
+
+	// A zero on the diagonal is reported before trsv and trsm
+	bool ok(true);
+	try
+	{
+		ublas::detail::cblas_inplace_solve<ublas::lower_tag>(A, b);
+		ok = false;
+	}
+	catch (ublas::singular const&)
+	{
+	}
+	try
+	{
+		ublas::detail::cblas_inplace_solve<ublas::lower_tag>(A, B);
+		ok = false;
+	}
+	catch (ublas::singular const&)
+	{
+	}
+
+	// The unit tags do not read the diagonal
+	try
+	{
+		ok = ok && ublas::detail::cblas_inplace_solve<ublas::unit_lower_tag>(A, b);
+		ok = ok && ublas::detail::cblas_inplace_solve<ublas::unit_lower_tag>(A, B);
+	}
+	catch (ublas::singular const&)
+	{
+		ok = false;
+	}
+
+	if (ok)
+	{
+		std::cout << "[test_cblas_singular] Singular checks succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_cblas_singular] Singular checks failed." << std::endl;
+	}
+
+	std::cout << "[test_cblas_singular] END" << std::endl;
+}
+
+
+void test_cblas_fallback()
+{
+	std::cout << "[test_cblas_fallback] BEGIN" << std::endl;
+
+	ublas::matrix<double> A(10,10);
+	ublas::matrix<double> B(10,10);
+	fill(A);
+	fill(B);
+	ublas::matrix<double> R(reference_prod(A, B, ublas::matrix<double>(10,10)));
+
+	// Storage shared with an operand, other value types or operations keep the generic loops
+	bool ok(!ublas::detail::cblas_matrix_assign<ublas::scalar_assign>(A, ublas::prod(A, B)));
+	ublas::matrix<double> C(10,10);
+	ok = ok && !ublas::detail::cblas_matrix_assign<ublas::scalar_multiplies_assign>(C, ublas::prod(A, B));
+	ok = ok && !ublas::detail::cblas_matrix_assign<ublas::scalar_assign>(C, A + B);
+
+	ublas::matrix<int> I(10,10), J(10,10), K(10,10);
+	for (std::size_t i = 0; i < 10; ++i)
+	{
+		for (std::size_t j = 0; j < 10; ++j)
+		{
+			I(i,j) = int(i+j);
+			J(i,j) = int(i)-int(j);
+		}
+	}
+	ok = ok && !ublas::detail::cblas_matrix_assign<ublas::scalar_assign>(K, ublas::prod(I, J));
+	K = ublas::prod(I, J);
+	ublas::vector<int> p(ublas::row(I, 3)), q(ublas::column(J, 4));
+	int t(0);
+	ok = ok && !ublas::detail::cblas_inner_prod(p, q, t);
+	ok = ok && ublas::inner_prod(p, q) == K(3,4);
+
+	// The generic loops give the same results
+	ublas::matrix<double> D(ublas::prod(A, B));
+	D = ublas::prod(D, ublas::identity_matrix<double>(10));
+	ok = ok && same_elements(D, R);
+
+	if (ok)
+	{
+		std::cout << "[test_cblas_fallback] Products succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_cblas_fallback] Products failed." << std::endl;
+	}
+
+	std::cout << "[test_cblas_fallback] END" << std::endl;
+}
+
+
+int main()
+{
+	test_cblas_prod<double,ublas::row_major,ublas::row_major,ublas::row_major>("double,row_major");
+	test_cblas_prod<double,ublas::column_major,ublas::row_major,ublas::column_major>("double,mixed");
+	test_cblas_prod<float,ublas::column_major,ublas::column_major,ublas::column_major>("float,column_major");
+	test_cblas_prod<std::complex<double>,ublas::row_major,ublas::column_major,ublas::row_major>("complex<double>,mixed");
+	test_cblas_prod<std::complex<float>,ublas::row_major,ublas::row_major,ublas::column_major>("complex<float>,mixed");
+	test_cblas_solve<double,ublas::row_major,ublas::row_major>("double,row_major");
+	test_cblas_solve<double,ublas::column_major,ublas::row_major>("double,mixed");
+	test_cblas_solve<float,ublas::row_major,ublas::column_major>("float,mixed");
+	test_cblas_solve<std::complex<double>,ublas::column_major,ublas::column_major>("complex<double>,column_major");
+	test_cblas_singular();
+	test_cblas_fallback();
+}
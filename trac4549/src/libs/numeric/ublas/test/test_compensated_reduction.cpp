@@ -0,0 +1,150 @@
+// Compensated sums in small chunks
+#define BOOST_UBLAS_COMPENSATED_REDUCTION
+#define BOOST_UBLAS_REDUCTION_CHUNK_SIZE 64
+
+#include <boost/numeric/ublas/io.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/reduction.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_sparse.hpp>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+
+namespace ublas = boost::numeric::ublas;
+
+
+template <typename ValueT>
+void test_compensated_sum(char const* name)
+{
+	std::cout << "[test_compensated_sum<" << name << ">] BEGIN" << std::endl;
+
+	// Large terms which cancel exactly and small ones which are lost by a naive sum
+	std::size_t n(64*21+3);
+	ValueT big(ValueT(2)/std::numeric_limits<ValueT>::epsilon());
+	ublas::vector<ValueT> u(n);
+	ublas::mapped_vector<ValueT> s(n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		u(i) = i % 4 == 0 ? big : (i % 4 == 2 ? -big : ValueT(1));
+		if (i % 3 == 0)
+		{
+			s(i) = u(i);
+		}
+	}
+	ublas::vector<ValueT> sd(s);
+
+	// The sums of the ones and of the big terms are exact
+	ValueT exact(0);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		if (i % 2 != 0)
+		{
+			exact += ValueT(1);
+		}
+	}
+	exact += (n % 4 == 1 || n % 4 == 2) ? big : ValueT(0);
+
+	bool ok(true);
+	ok = ok && ublas::reproducible_sum(u) == exact;
+	ok = ok && ublas::sum(u) != exact;
+	ok = ok && ublas::reproducible_inner_prod(u, ublas::scalar_vector<ValueT>(n, ValueT(1))) == exact;
+
+	// Same results for sparse and dense storage of the same values
+	ok = ok && ublas::reproducible_sum(s) == ublas::reproducible_sum(sd);
+	ok = ok && ublas::reproducible_norm_1(s) == ublas::reproducible_norm_1(sd);
+	ok = ok && ublas::reproducible_norm_2(s) == ublas::reproducible_norm_2(sd);
+	ok = ok && ublas::reproducible_inner_prod(s, u) == ublas::reproducible_inner_prod(sd, u);
+
+	// Terms of decreasing magnitude: only the rounding of the squares is left
+	ublas::vector<ValueT> v(n);
+	long double square(0);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		v(i) = ValueT(1)/ValueT(i+1);
+		square += (long double)(v(i))*(long double)(v(i));
+	}
+	ValueT norm_2(ublas::reproducible_norm_2(v));
+	ok = ok && std::fabs(norm_2-std::sqrt(square)) <= std::numeric_limits<ValueT>::epsilon()*norm_2;
+
+	if (ok)
+	{
+		std::cout << "[test_compensated_sum<" << name << ">] Sums succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_compensated_sum<" << name << ">] Sums failed." << std::endl;
+	}
+
+	std::cout << "[test_compensated_sum<" << name << ">] END" << std::endl;
+}
+
+
+void test_compensated_complex_sum()
+{
+	std::cout << "[test_compensated_complex_sum] BEGIN" << std::endl;
+
+	typedef std::complex<double> value_type;
+
+	// Within a chunk: the results of the chunks are rounded
+	std::size_t n(60);
+	double big(1e17);
+	ublas::vector<value_type> u(n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		u(i) = i == 0 ? value_type(big, -big) : (i == n-1 ? value_type(-big, big) : value_type(1, -1));
+	}
+
+	bool ok(ublas::reproducible_sum(u) == value_type(double(n-2), -double(n-2)));
+
+	if (ok)
+	{
+		std::cout << "[test_compensated_complex_sum] Sums succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_compensated_complex_sum] Sums failed." << std::endl;
+	}
+
+	std::cout << "[test_compensated_complex_sum] END" << std::endl;
+}
+
+
+void test_pairwise_accumulator()
+{
+	std::cout << "[test_pairwise_accumulator] BEGIN" << std::endl;
+
+	// One term per lane, added pairwise whatever the order of the additions
+	ublas::detail::pairwise_accumulator<double> a, b;
+	double x[8] = { 1e16, 1, -1e16, 1, 3, 5, 7, 11 };
+	a.add_lanes(x);
+	for (std::size_t i = 8; i > 0; --i)
+	{
+		b.add(i-1, x[i-1]);
+	}
+
+	bool ok(a.result() == ((x[0]+x[1])+(x[2]+x[3]))+((x[4]+x[5])+(x[6]+x[7])));
+	ok = ok && b.result() == a.result();
+
+	if (ok)
+	{
+		std::cout << "[test_pairwise_accumulator] Sums succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_pairwise_accumulator] Sums failed." << std::endl;
+	}
+
+	std::cout << "[test_pairwise_accumulator] END" << std::endl;
+}
+
+
+int main()
+{
+	test_compensated_sum<double>("double");
+	test_compensated_sum<float>("float");
+	test_compensated_complex_sum();
+	test_pairwise_accumulator();
+}
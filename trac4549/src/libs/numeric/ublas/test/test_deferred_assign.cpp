@@ -0,0 +1,204 @@
+#include <boost/numeric/ublas/deferred_assign.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <cstddef>
+#include <iostream>
+
+namespace ublas = boost::numeric::ublas;
+
+
+template <typename ValueT>
+void test_deferred_vector_assign(char const* name)
+{
+	std::cout << "[test_deferred_vector_assign<" << name << ">] BEGIN" << std::endl;
+
+	std::size_t n(37);
+
+	ublas::vector<ValueT> a(n);
+	ublas::vector<ValueT> b(n);
+	ublas::vector<ValueT> z(n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		a(i) = ValueT(3*i+1)/ValueT(7);
+		b(i) = ValueT(i%5);
+		z(i) = ValueT(i);
+	}
+	ValueT s(3);
+
+	// Reference: one statement after the other
+	ublas::vector<ValueT> x0(n);
+	ublas::vector<ValueT> y0(n);
+	ublas::vector<ValueT> z0(z);
+	x0.assign(a + b);
+	y0.assign(x0 * s);
+	z0.minus_assign(x0);
+	z0.plus_assign(y0 - b);
+
+	ublas::vector<ValueT> x(n);
+	ublas::vector<ValueT> y(n);
+	bool fused = ublas::deferred_vector_assign()
+					.assign(x, a + b)
+					.assign(y, x * s)
+					.minus_assign(z, x)
+					.plus_assign(z, y - b)
+					.evaluate();
+
+	bool ok(fused);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		ok = ok && x(i) == x0(i) && y(i) == y0(i) && z(i) == z0(i);
+	}
+
+	// Ranges are evaluated one after the other
+	ublas::vector_range< ublas::vector<ValueT> > r(y, ublas::range(0, 10));
+	fused = ublas::deferred_vector_assign()
+				.assign(r, ublas::project(a, ublas::range(5, 15)))
+				.plus_assign(r, ublas::project(b, ublas::range(0, 10)))
+				.evaluate();
+	ok = ok && !fused;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		ok = ok && y(i) == (i < 10 ? ValueT(a(i+5) + b(i)) : y0(i));
+	}
+
+	// Different sizes are evaluated one after the other
+	ublas::vector<ValueT> w(n+1, ValueT(1));
+	fused = ublas::deferred_vector_assign()
+				.assign(x, a - b)
+				.plus_assign(w, ublas::scalar_vector<ValueT>(n+1, ValueT(2)))
+				.evaluate();
+	ok = ok && !fused;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		ok = ok && x(i) == ValueT(a(i) - b(i)) && w(i) == ValueT(3);
+	}
+	ok = ok && w(n) == ValueT(3);
+
+	// Products read the whole destination of the previous statement: not fused
+	ublas::vector<ValueT> p(4), q(4), p0(4);
+	ublas::matrix<ValueT> P(4, 4, ValueT(1));
+	for (std::size_t i = 0; i < 4; ++i)
+	{
+		p0(i) = ValueT(i+1);
+	}
+	fused = ublas::deferred_vector_assign()
+				.assign(p, p0)
+				.assign(q, ublas::prod(P, p))
+				.evaluate();
+	ok = ok && !fused;
+	for (std::size_t i = 0; i < 4; ++i)
+	{
+		ok = ok && p(i) == p0(i) && q(i) == ValueT(10);
+	}
+
+	if (ok)
+	{
+		std::cout << "[test_deferred_vector_assign<" << name << ">] Assignments succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_deferred_vector_assign<" << name << ">] Assignments failed." << std::endl;
+	}
+
+	std::cout << "[test_deferred_vector_assign<" << name << ">] END" << std::endl;
+}
+
+
+template <typename ValueT, typename LayoutT>
+void test_deferred_matrix_assign(char const* name)
+{
+	std::cout << "[test_deferred_matrix_assign<" << name << ">] BEGIN" << std::endl;
+
+	std::size_t n1(13);
+	std::size_t n2(7);
+
+	ublas::matrix<ValueT,LayoutT> A(n1,n2);
+	ublas::matrix<ValueT,LayoutT> B(n1,n2);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			A(i,j) = ValueT(i+1)/ValueT(j+3);
+			B(i,j) = ValueT(j)-ValueT(i)/ValueT(9);
+		}
+	}
+
+	ublas::matrix<ValueT,LayoutT> C(n1,n2);
+	ublas::matrix<ValueT,LayoutT> D(n1,n2);
+	bool fused = ublas::deferred_matrix_assign()
+					.assign(C, A + B)
+					.assign(D, C * ValueT(2) - A)
+					.minus_assign(C, B)
+					.evaluate();
+
+	bool ok(fused);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			ValueT c(A(i,j) + B(i,j));
+			ok = ok && D(i,j) == ValueT(c * ValueT(2) - A(i,j));
+			ok = ok && C(i,j) == ValueT(c - B(i,j));
+		}
+	}
+
+	// Mixed orientations and sparse destinations are evaluated one after the other
+	ublas::matrix<ValueT,ublas::column_major> E(n1,n2);
+	ublas::mapped_matrix<ValueT> S(n1,n2);
+	fused = ublas::deferred_matrix_assign()
+				.assign(E, A)
+				.assign(S, E - B)
+				.evaluate();
+	ok = ok && !fused;
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			ok = ok && E(i,j) == A(i,j) && S(i,j) == ValueT(A(i,j) - B(i,j));
+		}
+	}
+
+	// Products and transposes read other elements of the destinations: not fused
+	ublas::matrix<ValueT,LayoutT> F(n2,n2);
+	ublas::matrix<ValueT,LayoutT> G(n2,n2);
+	ublas::matrix<ValueT,LayoutT> H(n2,n2);
+	ublas::matrix<ValueT,LayoutT> F0(ublas::subrange(A, 0, n2, 0, n2));
+	fused = ublas::deferred_matrix_assign()
+				.assign(F, F0)
+				.assign(G, ublas::prod(F, F0))
+				.assign(H, ublas::trans(F))
+				.evaluate();
+	ok = ok && !fused;
+	ublas::matrix<ValueT,LayoutT> G0(ublas::prod(F0, F0));
+	for (std::size_t i = 0; i < n2; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			ok = ok && G(i,j) == G0(i,j) && H(i,j) == F0(j,i);
+		}
+	}
+
+	if (ok)
+	{
+		std::cout << "[test_deferred_matrix_assign<" << name << ">] Assignments succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_deferred_matrix_assign<" << name << ">] Assignments failed." << std::endl;
+	}
+
+	std::cout << "[test_deferred_matrix_assign<" << name << ">] END" << std::endl;
+}
+
+
+int main()
+{
+	test_deferred_vector_assign<double>("double");
+	test_deferred_vector_assign<int>("int");
+	test_deferred_matrix_assign<double,ublas::row_major>("double,row_major");
+	test_deferred_matrix_assign<float,ublas::column_major>("float,column_major");
+}
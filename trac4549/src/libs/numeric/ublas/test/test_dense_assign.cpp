@@ -0,0 +1,196 @@
+// Force the parallel evaluation of every dense assignment
+#define BOOST_UBLAS_PARALLEL_ASSIGN
+#define BOOST_UBLAS_PARALLEL_ASSIGN_THRESHOLD 0
+
+#include <boost/numeric/ublas/io.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <cstddef>
+#include <iostream>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace ublas = boost::numeric::ublas;
+
+typedef double value_type;
+
+
+template <typename M1, typename M2>
+bool same_elements(M1 const& A, M2 const& B)
+{
+	if (A.size1() != B.size1() || A.size2() != B.size2())
+	{
+		return false;
+	}
+	for (std::size_t i = 0; i < A.size1(); ++i)
+	{
+		for (std::size_t j = 0; j < A.size2(); ++j)
+		{
+			if (A(i,j) != B(i,j))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+
+template <typename LayoutT>
+void test_parallel_dense_assign(char const* name)
+{
+	std::cout << "[test_parallel_dense_assign<" << name << ">] BEGIN" << std::endl;
+
+	std::size_t n1(37);
+	std::size_t n2(23);
+
+	ublas::matrix<value_type,LayoutT> A(n1,n2);
+	ublas::matrix<value_type,LayoutT> B(n1,n2);
+	ublas::matrix<value_type,LayoutT> RES(n1,n2);
+
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			A(i,j) = 0.5*i - j;
+			B(i,j) = 1.0/(i+j+1);
+		}
+	}
+
+	// Element-wise expression
+	ublas::matrix<value_type,LayoutT> C(n1,n2);
+	C = 2*A + B;
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			RES(i,j) = 2*A(i,j) + B(i,j);
+		}
+	}
+	bool ok(same_elements(C, RES));
+
+#ifdef _OPENMP
+	// Same results whatever the number of threads
+	for (int threads = 1; threads <= 8; ++threads)
+	{
+		omp_set_num_threads(threads);
+		ublas::matrix<value_type,LayoutT> D(n1,n2);
+		ublas::noalias(D) = 2*A + B;
+		ok = ok && same_elements(D, RES);
+	}
+#endif
+
+	if (ok)
+	{
+		std::cout << "[test_parallel_dense_assign<" << name << ">] Expression assignment succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_parallel_dense_assign<" << name << ">] Expression assignment failed." << std::endl;
+	}
+
+	// Computed assignment through a proxy
+	ublas::matrix_range< ublas::matrix<value_type,LayoutT> > R(C, ublas::range(3, n1-2), ublas::range(1, n2-4));
+	R.minus_assign(ublas::subrange(B, 3, n1-2, 1, n2-4));
+	for (std::size_t i = 3; i < n1-2; ++i)
+	{
+		for (std::size_t j = 1; j < n2-4; ++j)
+		{
+			RES(i,j) -= B(i,j);
+		}
+	}
+	if (same_elements(C, RES))
+	{
+		std::cout << "[test_parallel_dense_assign<" << name << ">] Proxy computed assignment succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_parallel_dense_assign<" << name << ">] Proxy computed assignment failed." << std::endl;
+	}
+
+	// Scalar assignment
+	C *= 3;
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			RES(i,j) *= 3;
+		}
+	}
+	if (same_elements(C, RES))
+	{
+		std::cout << "[test_parallel_dense_assign<" << name << ">] Scalar assignment succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_parallel_dense_assign<" << name << ">] Scalar assignment failed." << std::endl;
+	}
+
+	std::cout << "[test_parallel_dense_assign<" << name << ">] END" << std::endl;
+}
+
+
+template <typename LayoutT, typename OtherLayoutT>
+void test_transposing_dense_assign(char const* name)
+{
+	std::cout << "[test_transposing_dense_assign<" << name << ">] BEGIN" << std::endl;
+
+	// Not multiples of the tile nor of the sub-block sizes
+	std::size_t n1(71);
+	std::size_t n2(45);
+
+	ublas::matrix<value_type,OtherLayoutT> A(n1,n2);
+	ublas::matrix<value_type,LayoutT> AT(n2,n1);
+
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			A(i,j) = i*n2+j;
+			AT(j,i) = 0.25*i-j;
+		}
+	}
+
+	// Opposite orientations
+	ublas::matrix<value_type,LayoutT> B(n1,n2);
+	B.assign(A);
+	if (same_elements(B, A))
+	{
+		std::cout << "[test_transposing_dense_assign<" << name << ">] Layout conversion succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_transposing_dense_assign<" << name << ">] Layout conversion failed." << std::endl;
+	}
+
+	// Transposed expression with a computed assignment
+	B.plus_assign(ublas::trans(AT));
+	bool ok(true);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			ok = ok && B(i,j) == A(i,j)+AT(j,i);
+		}
+	}
+	if (ok)
+	{
+		std::cout << "[test_transposing_dense_assign<" << name << ">] Transposed plus_assign succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_transposing_dense_assign<" << name << ">] Transposed plus_assign failed." << std::endl;
+	}
+
+	std::cout << "[test_transposing_dense_assign<" << name << ">] END" << std::endl;
+}
+
+
+int main()
+{
+	test_parallel_dense_assign<ublas::row_major>("row_major");
+	test_parallel_dense_assign<ublas::column_major>("column_major");
+	test_transposing_dense_assign<ublas::row_major,ublas::column_major>("row_major,column_major");
+	test_transposing_dense_assign<ublas::column_major,ublas::row_major>("column_major,row_major");
+}
@@ -0,0 +1,294 @@
+// Blocked products of every size, in small blocks, with the SIMD micro kernels
+#define BOOST_UBLAS_GEMM
+#define BOOST_UBLAS_GEMM_THRESHOLD 0
+#define BOOST_UBLAS_GEMM_MC 8
+#define BOOST_UBLAS_GEMM_KC 16
+#define BOOST_UBLAS_GEMM_NC 40
+#define BOOST_UBLAS_SIMD
+#define BOOST_UBLAS_PARALLEL_ASSIGN
+#define BOOST_UBLAS_PARALLEL_ASSIGN_THRESHOLD 0
+
+#include <boost/numeric/ublas/io.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace ublas = boost::numeric::ublas;
+
+
+// Multiples of 1/8 of either sign
+template <typename ValueT>
+struct test_value
+{
+	static ValueT get(std::size_t i, std::size_t j)
+	{
+		return ValueT(double((3*i+7*j) % 11)/8 - 0.5);
+	}
+};
+
+template <typename T>
+struct test_value< std::complex<T> >
+{
+	static std::complex<T> get(std::size_t i, std::size_t j)
+	{
+		return std::complex<T>(test_value<T>::get(i, j), test_value<T>::get(j, i+1));
+	}
+};
+
+template <typename M>
+void fill(M& m)
+{
+	for (std::size_t i = 0; i < m.size1(); ++i)
+	{
+		for (std::size_t j = 0; j < m.size2(); ++j)
+		{
+			m(i,j) = test_value<typename M::value_type>::get(i, j);
+		}
+	}
+}
+
+
+// The terms are multiples of 1/64 and their sums small: the products are exact
+// whatever the order of the sums
+template <typename M1, typename M2>
+bool same_elements(M1 const& a, M2 const& b)
+{
+	if (a.size1() != b.size1() || a.size2() != b.size2())
+	{
+		return false;
+	}
+	for (std::size_t i = 0; i < a.size1(); ++i)
+	{
+		for (std::size_t j = 0; j < a.size2(); ++j)
+		{
+			if (a(i,j) != b(i,j))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+template <typename M1, typename M2, typename M3>
+M3 reference_prod(M1 const& a, M2 const& b, M3 const& c)
+{
+	M3 r(c);
+	for (std::size_t i = 0; i < a.size1(); ++i)
+	{
+		for (std::size_t j = 0; j < b.size2(); ++j)
+		{
+			typename M3::value_type t = typename M3::value_type();
+			for (std::size_t k = 0; k < a.size2(); ++k)
+			{
+				t += a(i,k)*b(k,j);
+			}
+			r(i,j) = t;
+		}
+	}
+	return r;
+}
+
+
+template <typename ValueT, typename Layout1, typename Layout2, typename Layout3>
+void test_gemm(char const* name)
+{
+	std::cout << "[test_gemm<" << name << ">] BEGIN" << std::endl;
+
+	// Several blocks of each kind with partial tiles
+	std::size_t n1(29);
+	std::size_t n2(45);
+	std::size_t n(37);
+
+	ublas::matrix<ValueT,Layout1> A(n1,n);
+	ublas::matrix<ValueT,Layout2> B(n,n2);
+	fill(A);
+	fill(B);
+	ublas::matrix<ValueT,Layout3> R(reference_prod(A, B, ublas::matrix<ValueT,Layout3>(n1,n2)));
+
+	bool ok(true);
+
+	ublas::matrix<ValueT,Layout3> C(ublas::prod(A, B));
+	ok = ok && same_elements(C, R);
+
+	ublas::matrix<ValueT,Layout3> D(n1,n2);
+	ok = ok && ublas::detail::gemm_matrix_assign<ublas::scalar_assign>(D, ublas::prod(A, B));
+	ok = ok && same_elements(D, R);
+	ublas::noalias(D) = ublas::prod(A, B);
+	ok = ok && same_elements(D, R);
+	ublas::noalias(D) += ublas::prod(A, B);
+	ok = ok && same_elements(D, ValueT(2)*R);
+	ublas::noalias(D) -= ublas::prod(A, B);
+	ok = ok && same_elements(D, R);
+
+	ublas::matrix<ValueT,Layout3> E(n1,n2);
+	ublas::axpy_prod(A, B, E);
+	ok = ok && same_elements(E, R);
+	ublas::axpy_prod(A, B, E, false);
+	ok = ok && same_elements(E, ValueT(2)*R);
+
+	// Ranges of the operands and of the result
+	ublas::range r1(3, 20), r2(5, 40), r(1, 30);
+	ublas::matrix<ValueT,Layout3> F(n1,n2, ValueT(1));
+	ublas::matrix_range< ublas::matrix<ValueT,Layout3> > Fp(F, r1, r2);
+	ok = ok && ublas::detail::gemm_matrix_assign<ublas::scalar_assign>(Fp, ublas::prod(ublas::project(A, r1, r), ublas::project(B, r, r2)));
+	ublas::matrix<ValueT,Layout3> Fr(reference_prod(ublas::project(A, r1, r), ublas::project(B, r, r2),
+	                                                ublas::matrix<ValueT,Layout3>(r1.size(), r2.size())));
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			bool inside(i >= r1.start() && i < r1.start()+r1.size() && j >= r2.start() && j < r2.start()+r2.size());
+			ok = ok && F(i,j) == (inside ? Fr(i-r1.start(), j-r2.start()) : ValueT(1));
+		}
+	}
+
+	if (ok)
+	{
+		std::cout << "[test_gemm<" << name << ">] Products succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_gemm<" << name << ">] Products failed." << std::endl;
+	}
+
+	std::cout << "[test_gemm<" << name << ">] END" << std::endl;
+}
+
+
+void test_gemm_fallback()
+{
+	std::cout << "[test_gemm_fallback] BEGIN" << std::endl;
+
+	ublas::matrix<double> A(10,10);
+	ublas::matrix<double> B(10,10);
+	fill(A);
+	fill(B);
+
+	// Storage shared with an operand, or other value types, keep the generic loops
+	bool ok(!ublas::detail::gemm_matrix_assign<ublas::scalar_assign>(A, ublas::prod(A, B)));
+	ublas::matrix<int> I(10,10);
+	ublas::matrix<int> J(10,10);
+	ok = ok && !ublas::detail::gemm_matrix_assign<ublas::scalar_assign>(I, ublas::prod(I, J));
+	ublas::matrix<double> C(10,10);
+	ok = ok && ublas::detail::gemm_matrix_assign<ublas::scalar_assign>(C, ublas::prod(A, B));
+	ok = ok && !ublas::detail::gemm_matrix_assign<ublas::scalar_multiplies_assign>(C, ublas::prod(A, B));
+
+	// No terms
+	ublas::matrix<double> E(4,0);
+	ublas::matrix<double> F(0,5);
+	ublas::matrix<double> G(4,5, 1.0);
+	ublas::noalias(G) = ublas::prod(E, F);
+	ok = ok && same_elements(G, ublas::zero_matrix<double>(4,5));
+
+	if (ok)
+	{
+		std::cout << "[test_gemm_fallback] Products succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_gemm_fallback] Products failed." << std::endl;
+	}
+
+	std::cout << "[test_gemm_fallback] END" << std::endl;
+}
+
+
+void test_gemm_threads()
+{
+	std::cout << "[test_gemm_threads] BEGIN" << std::endl;
+
+	// Inexact sums: the blocks of rows are summed alike whatever the number of threads
+	std::size_t n(61);
+	ublas::matrix<double> A(n,n);
+	ublas::matrix<double> B(n,n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		for (std::size_t j = 0; j < n; ++j)
+		{
+			A(i,j) = std::sin(double(i*n+j));
+			B(i,j) = std::cos(double(3*i+j));
+		}
+	}
+	ublas::matrix<double> C(n,n);
+	bool ok(ublas::detail::gemm_matrix_assign<ublas::scalar_assign>(C, ublas::prod(A, B)));
+
+#ifdef _OPENMP
+	for (int threads = 1; threads <= 8; ++threads)
+	{
+		omp_set_num_threads(threads);
+		ublas::matrix<double> D(n,n);
+		ublas::noalias(D) = ublas::prod(A, B);
+		ok = ok && same_elements(D, C);
+	}
+#endif
+
+	if (ok)
+	{
+		std::cout << "[test_gemm_threads] Products succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_gemm_threads] Products failed." << std::endl;
+	}
+
+	std::cout << "[test_gemm_threads] END" << std::endl;
+}
+
+
+template <typename ValueT>
+void test_gemm_kernel(char const* name)
+{
+	std::cout << "[test_gemm_kernel<" << name << ">] BEGIN" << std::endl;
+
+	// The dispatched kernel computes the same sums as the generic one, bit for bit
+	std::size_t mr(ublas::detail::gemm_tile<ValueT>::mr);
+	std::size_t nr(ublas::detail::gemm_tile<ValueT>::nr);
+	std::size_t kc(51);
+	std::vector<ValueT> a(kc*mr), b(kc*nr), ab(mr*nr), ab_generic(mr*nr);
+	for (std::size_t k = 0; k < a.size(); ++k)
+	{
+		a[k] = ValueT(std::sin(double(k)));
+	}
+	for (std::size_t k = 0; k < b.size(); ++k)
+	{
+		b[k] = ValueT(std::cos(double(3*k)));
+	}
+	ublas::detail::gemm_kernel(kc, &a[0], &b[0], &ab[0]);
+	ublas::detail::gemm_generic_kernel(kc, &a[0], &b[0], &ab_generic[0]);
+
+	bool ok(ab == ab_generic);
+
+	if (ok)
+	{
+		std::cout << "[test_gemm_kernel<" << name << ">] Kernels succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_gemm_kernel<" << name << ">] Kernels failed." << std::endl;
+	}
+
+	std::cout << "[test_gemm_kernel<" << name << ">] END" << std::endl;
+}
+
+
+int main()
+{
+	test_gemm<double,ublas::row_major,ublas::row_major,ublas::row_major>("double,row_major");
+	test_gemm<double,ublas::column_major,ublas::row_major,ublas::column_major>("double,mixed");
+	test_gemm<float,ublas::column_major,ublas::column_major,ublas::column_major>("float,column_major");
+	test_gemm<std::complex<double>,ublas::row_major,ublas::column_major,ublas::row_major>("complex<double>,mixed");
+	test_gemm<std::complex<float>,ublas::row_major,ublas::row_major,ublas::column_major>("complex<float>,mixed");
+	test_gemm_fallback();
+	test_gemm_threads();
+	test_gemm_kernel<double>("double");
+	test_gemm_kernel<float>("float");
+}
@@ -0,0 +1,220 @@
+#include <boost/numeric/ublas/io.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/operation_integer.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+
+namespace ublas = boost::numeric::ublas;
+
+
+template <typename ValueT>
+void test_integer_prod(char const* name)
+{
+	std::cout << "[test_integer_prod<" << name << ">] BEGIN" << std::endl;
+
+	std::size_t n1(7);
+	std::size_t n2(5);
+	std::size_t n(9);
+
+	// Large elements, so that the products overflow ValueT but not the sums in a wider type
+	ValueT big((std::numeric_limits<ValueT>::max)()/ValueT(3));
+	ublas::matrix<ValueT> A(n1,n);
+	ublas::matrix<ValueT> B(n,n2);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t k = 0; k < n; ++k)
+		{
+			A(i,k) = ((i+k) % 3 == 0) ? ValueT(0) : ValueT(big - ValueT(i+k));
+		}
+	}
+	for (std::size_t k = 0; k < n; ++k)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			B(k,j) = ValueT(k % 4 == j % 4 ? 3 : -1);
+		}
+	}
+
+	ublas::matrix<boost::intmax_t> C(n1,n2);
+	ublas::integer_prod(A, B, C);
+	ublas::matrix<ValueT> W(n1,n2);
+	ublas::integer_prod(A, B, W);
+	ublas::matrix<ValueT> S(n1,n2);
+	ublas::saturating_prod(A, B, S);
+
+	bool ok(true);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			boost::intmax_t c(0);
+			for (std::size_t k = 0; k < n; ++k)
+			{
+				c += boost::intmax_t(A(i,k))*boost::intmax_t(B(k,j));
+			}
+			ok = ok && C(i,j) == c;
+			ok = ok && W(i,j) == ValueT(c);
+			if (c > boost::intmax_t((std::numeric_limits<ValueT>::max)()))
+			{
+				ok = ok && S(i,j) == (std::numeric_limits<ValueT>::max)();
+			}
+			else if (c < boost::intmax_t((std::numeric_limits<ValueT>::min)()))
+			{
+				ok = ok && S(i,j) == (std::numeric_limits<ValueT>::min)();
+			}
+			else
+			{
+				ok = ok && S(i,j) == ValueT(c);
+			}
+		}
+	}
+
+	if (ok)
+	{
+		std::cout << "[test_integer_prod<" << name << ">] Products succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_integer_prod<" << name << ">] Products failed." << std::endl;
+	}
+
+	std::cout << "[test_integer_prod<" << name << ">] END" << std::endl;
+}
+
+
+void test_saturating_prod_int64()
+{
+	std::cout << "[test_saturating_prod_int64] BEGIN" << std::endl;
+
+	typedef boost::int64_t value_type;
+
+	// A single product overflows the accumulator
+	value_type max((std::numeric_limits<value_type>::max)());
+	value_type min((std::numeric_limits<value_type>::min)());
+	ublas::matrix<value_type> A(2,2);
+	A(0,0) = max/2; A(0,1) = 3;
+	A(1,0) = min/2; A(1,1) = 1;
+	ublas::matrix<value_type> B(2,2);
+	B(0,0) = 3; B(0,1) = 1;
+	B(1,0) = 0; B(1,1) = -1;
+	ublas::matrix<value_type> S(2,2);
+	ublas::saturating_prod(A, B, S);
+
+	bool ok(S(0,0) == max && S(0,1) == max/2-3 && S(1,0) == min && S(1,1) == min/2-1);
+
+	if (ok)
+	{
+		std::cout << "[test_saturating_prod_int64] Products succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_saturating_prod_int64] Products failed." << std::endl;
+	}
+
+	std::cout << "[test_saturating_prod_int64] END" << std::endl;
+}
+
+
+void test_boolean_prod()
+{
+	std::cout << "[test_boolean_prod] BEGIN" << std::endl;
+
+	// More than one word of bits
+	std::size_t n(150);
+
+	ublas::matrix<int> A(n,n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		for (std::size_t j = 0; j < n; ++j)
+		{
+			A(i,j) = ((i*j+i) % 7 == 1) ? 1 : 0;
+		}
+	}
+
+	ublas::matrix<int> P(n,n);
+	ublas::boolean_prod(A, A, P);
+	ublas::matrix<bool> R(n,n);
+	ublas::boolean_prod(A, A, R);
+	ublas::matrix<double> D(n,n);
+	ublas::boolean_prod(A, A, D);
+
+	bool ok(true);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		for (std::size_t j = 0; j < n; ++j)
+		{
+			int p(0);
+			for (std::size_t k = 0; k < n; ++k)
+			{
+				p += A(i,k)*A(k,j);
+			}
+			ok = ok && P(i,j) == p && R(i,j) == (p != 0) && D(i,j) == double(p);
+		}
+	}
+
+	if (ok)
+	{
+		std::cout << "[test_boolean_prod] Products succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_boolean_prod] Products failed." << std::endl;
+	}
+
+	std::cout << "[test_boolean_prod] END" << std::endl;
+}
+
+
+void test_integer_type_check()
+{
+	std::cout << "[test_integer_type_check] BEGIN" << std::endl;
+
+	// Integral types are compared exactly
+	ublas::vector<boost::int64_t> u(3);
+	u(0) = (std::numeric_limits<boost::int64_t>::max)();
+	u(1) = -1;
+	u(2) = 7;
+	ublas::vector<boost::int64_t> v(u);
+
+	bool ok(ublas::detail::expression_type_check(u, v));
+	v(0) -= 1;
+	ok = ok && !ublas::detail::expression_type_check(u, v);
+
+	ublas::matrix<int> A(2,3);
+	for (std::size_t i = 0; i < A.size1(); ++i)
+	{
+		for (std::size_t j = 0; j < A.size2(); ++j)
+		{
+			A(i,j) = int(i*10+j);
+		}
+	}
+	ublas::matrix<int> B(A);
+	ok = ok && ublas::detail::expression_type_check(A, B);
+	B(1,2) += 1;
+	ok = ok && !ublas::detail::expression_type_check(A, B);
+
+	if (ok)
+	{
+		std::cout << "[test_integer_type_check] Checks succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_integer_type_check] Checks failed." << std::endl;
+	}
+
+	std::cout << "[test_integer_type_check] END" << std::endl;
+}
+
+
+int main()
+{
+	test_integer_prod<int>("int");
+	test_integer_prod<short>("short");
+	test_integer_prod<signed char>("signed char");
+	test_saturating_prod_int64();
+	test_boolean_prod();
+	test_integer_type_check();
+}
@@ -0,0 +1,147 @@
+#include <boost/numeric/ublas/banded.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/symmetric.hpp>
+#include <boost/numeric/ublas/triangular.hpp>
+#include <cstddef>
+#include <iostream>
+
+namespace ublas = boost::numeric::ublas;
+
+typedef double value_type;
+
+
+template <typename M1, typename M2>
+bool same_elements(M1 const& A, M2 const& B)
+{
+	if (A.size1() != B.size1() || A.size2() != B.size2())
+	{
+		return false;
+	}
+	for (std::size_t i = 0; i < A.size1(); ++i)
+	{
+		for (std::size_t j = 0; j < A.size2(); ++j)
+		{
+			if (A(i,j) != B(i,j))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+
+template <typename LayoutT>
+void test_packed_assign(char const* name)
+{
+	std::cout << "[test_packed_assign<" << name << ">] BEGIN" << std::endl;
+
+	std::size_t n(9);
+
+	ublas::matrix<value_type,LayoutT> D(n,n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		for (std::size_t j = 0; j < n; ++j)
+		{
+			D(i,j) = i*n+j+1;
+		}
+	}
+
+	// Triangular from triangular and from dense: contiguous copies
+	ublas::triangular_matrix<value_type,ublas::lower,LayoutT> L1(n,n);
+	L1.assign(ublas::triangular_adaptor<ublas::matrix<value_type,LayoutT>,ublas::lower>(D));
+	ublas::triangular_matrix<value_type,ublas::lower,LayoutT> L2(n,n);
+	L2.assign(L1);
+	ublas::matrix<value_type,LayoutT> DU(n,n,0);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		for (std::size_t j = i; j < n; ++j)
+		{
+			DU(i,j) = D(i,j);
+		}
+	}
+	ublas::triangular_matrix<value_type,ublas::upper,LayoutT> U(n,n);
+	U.assign(DU);
+
+	// Read through constant references: out of band mutable elements do not exist
+	ublas::triangular_matrix<value_type,ublas::lower,LayoutT> const& cL1(L1);
+	ublas::triangular_matrix<value_type,ublas::upper,LayoutT> const& cU(U);
+	bool ok(same_elements(L2, L1));
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		for (std::size_t j = 0; j < n; ++j)
+		{
+			ok = ok && cL1(i,j) == (j <= i ? D(i,j) : 0);
+			ok = ok && cU(i,j) == (j >= i ? D(i,j) : 0);
+		}
+	}
+	if (ok)
+	{
+		std::cout << "[test_packed_assign<" << name << ">] Triangular assignment succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_packed_assign<" << name << ">] Triangular assignment failed." << std::endl;
+	}
+
+	// Banded from a narrower band: zeroing at the start of the rows and columns
+	ublas::banded_matrix<value_type,LayoutT> B1(n,n,0,2);
+	ublas::banded_matrix<value_type,LayoutT> B2(n,n,1,2);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		for (std::size_t j = i; j < n && j <= i+2; ++j)
+		{
+			B1(i,j) = D(i,j);
+		}
+		for (std::size_t j = (i > 0 ? i-1 : 0); j < n && j <= i+2; ++j)
+		{
+			B2(i,j) = -1;
+		}
+	}
+	B2.assign(B1);
+	if (same_elements(B2, B1))
+	{
+		std::cout << "[test_packed_assign<" << name << ">] Banded assignment succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_packed_assign<" << name << ">] Banded assignment failed." << std::endl;
+	}
+
+	// Triangular from banded: zeroing of whole rows and columns
+	ublas::triangular_matrix<value_type,ublas::upper,LayoutT> U2(n,n);
+	U2.assign(U);
+	U2.assign(B1);
+	if (same_elements(U2, B1))
+	{
+		std::cout << "[test_packed_assign<" << name << ">] Triangular from banded assignment succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_packed_assign<" << name << ">] Triangular from banded assignment failed." << std::endl;
+	}
+
+	// Symmetric from symmetric
+	ublas::symmetric_matrix<value_type,ublas::lower,LayoutT> S1(n,n);
+	S1.assign(ublas::symmetric_adaptor<ublas::matrix<value_type,LayoutT>,ublas::lower>(D));
+	ublas::symmetric_matrix<value_type,ublas::lower,LayoutT> S2(n,n);
+	S2.assign(S1);
+	if (same_elements(S2, S1))
+	{
+		std::cout << "[test_packed_assign<" << name << ">] Symmetric assignment succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_packed_assign<" << name << ">] Symmetric assignment failed." << std::endl;
+	}
+
+	std::cout << "[test_packed_assign<" << name << ">] END" << std::endl;
+}
+
+
+int main()
+{
+	test_packed_assign<ublas::row_major>("row_major");
+	test_packed_assign<ublas::column_major>("column_major");
+}
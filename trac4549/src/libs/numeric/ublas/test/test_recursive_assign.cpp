@@ -0,0 +1,185 @@
+// Without OpenMP the parallel assignment has no effect on the dispatch
+#define BOOST_UBLAS_PARALLEL_ASSIGN
+#define BOOST_UBLAS_PARALLEL_ASSIGN_THRESHOLD 0
+
+#include <boost/numeric/ublas/io.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+namespace ublas = boost::numeric::ublas;
+
+typedef double value_type;
+
+
+template <typename M1, typename M2>
+bool same_elements(M1 const& A, M2 const& B)
+{
+	if (A.size1() != B.size1() || A.size2() != B.size2())
+	{
+		return false;
+	}
+	for (std::size_t i = 0; i < A.size1(); ++i)
+	{
+		for (std::size_t j = 0; j < A.size2(); ++j)
+		{
+			if (A(i,j) != B(i,j))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+
+// The elements in the order in which the assignment visited them
+std::vector<value_type>& visited()
+{
+	static std::vector<value_type> elements;
+	return elements;
+}
+
+template <typename T1, typename T2>
+struct recording_assign: public ublas::scalar_assign<T1, T2>
+{
+	typedef typename ublas::scalar_assign<T1, T2>::argument1_type argument1_type;
+	typedef typename ublas::scalar_assign<T1, T2>::argument2_type argument2_type;
+
+	static void apply(argument1_type t1, argument2_type t2)
+	{
+		t1 = t2;
+		visited().push_back(t2);
+	}
+};
+
+
+// True if the elements were visited one after the other in the orientation of the destination
+bool visited_in_order(std::size_t size)
+{
+	if (visited().size() != size)
+	{
+		return false;
+	}
+	for (std::size_t k = 0; k < size; ++k)
+	{
+		if (visited()[k] != value_type(k))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+template <typename LayoutT>
+void test_recursive_assign(char const* name)
+{
+	std::cout << "[test_recursive_assign<" << name << ">] BEGIN" << std::endl;
+
+	// Several levels of splitting, not multiples of the tile size
+	std::size_t n1(131);
+	std::size_t n2(77);
+
+	ublas::matrix<value_type,ublas::row_major> B(n1,n2);
+	ublas::matrix<value_type,ublas::column_major> C(n1,n2);
+	ublas::matrix<value_type,ublas::row_major> CT(n2,n1);
+
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			B(i,j) = i*n2+j;
+			C(i,j) = 0.5*j-i;
+			CT(j,i) = 2.0*i+0.25*j;
+		}
+	}
+
+	// Operands of different orientations
+	ublas::matrix<value_type,LayoutT> A(n1,n2);
+	A.assign(B + C);
+	A.minus_assign(B - ublas::trans(CT));
+
+	bool ok(true);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			ok = ok && A(i,j) == (B(i,j)+C(i,j))-(B(i,j)-CT(j,i));
+		}
+	}
+	if (ok)
+	{
+		std::cout << "[test_recursive_assign<" << name << ">] Mixed orientation assignments succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_recursive_assign<" << name << ">] Mixed orientation assignments failed." << std::endl;
+	}
+
+	// Number the elements in the orientation of the destination
+	std::size_t n(64);
+	ublas::matrix<value_type,LayoutT> V(n,n);
+	ublas::matrix<value_type,LayoutT> Z(n,n,0);
+	ublas::matrix<value_type,ublas::row_major> ZR(n,n,0);
+	ublas::matrix<value_type,ublas::column_major> ZC(n,n,0);
+	ublas::matrix<value_type,LayoutT> D(n,n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		for (std::size_t j = 0; j < n; ++j)
+		{
+			V(i,j) = &V(i,j) - &V(0,0);
+		}
+	}
+
+	// Same orientations: traversed in order, not in tiles
+	visited().clear();
+	ublas::matrix_assign<recording_assign>(D, V + Z);
+	ok = visited_in_order(n*n) && same_elements(D, V);
+	visited().clear();
+	ublas::matrix_assign<recording_assign>(D, V - 2*Z);
+	ok = ok && visited_in_order(n*n);
+	// Products are not element wise, whatever the orientations of their operands
+	ublas::matrix<value_type,ublas::row_major> IR(n,n);
+	ublas::matrix<value_type,ublas::column_major> IC(n,n);
+	IR = ublas::identity_matrix<value_type>(n);
+	IC = ublas::identity_matrix<value_type>(n);
+	visited().clear();
+	ublas::matrix_assign<recording_assign>(D, ublas::prod(V, IR));
+	ok = ok && visited_in_order(n*n);
+	visited().clear();
+	ublas::matrix_assign<recording_assign>(D, ublas::prod(V, IC));
+	ok = ok && visited_in_order(n*n) && same_elements(D, V);
+	if (ok)
+	{
+		std::cout << "[test_recursive_assign<" << name << ">] Same orientation traversal succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_recursive_assign<" << name << ">] Same orientation traversal failed." << std::endl;
+	}
+
+	// Different orientations: traversed in tiles
+	visited().clear();
+	ublas::matrix_assign<recording_assign>(D, V + ZR + ZC);
+	ok = visited().size() == n*n && ! visited_in_order(n*n) && same_elements(D, V);
+	if (ok)
+	{
+		std::cout << "[test_recursive_assign<" << name << ">] Mixed orientation traversal succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_recursive_assign<" << name << ">] Mixed orientation traversal failed." << std::endl;
+	}
+
+	std::cout << "[test_recursive_assign<" << name << ">] END" << std::endl;
+}
+
+
+int main()
+{
+	test_recursive_assign<ublas::row_major>("row_major");
+	test_recursive_assign<ublas::column_major>("column_major");
+}
@@ -0,0 +1,185 @@
+// Reduce every expression in parallel, in small chunks
+#define BOOST_UBLAS_PARALLEL_REDUCTION
+#define BOOST_UBLAS_PARALLEL_REDUCTION_THRESHOLD 0
+#define BOOST_UBLAS_REDUCTION_CHUNK_SIZE 64
+
+#include <boost/numeric/ublas/io.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/reduction.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_sparse.hpp>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace ublas = boost::numeric::ublas;
+
+
+// Sum of the terms in chunks of 64 combined by a balanced tree, as documented
+template <typename T>
+T chunked_sum(std::vector<T> const& terms)
+{
+	std::vector<T> partial;
+	for (std::size_t k = 0; k < terms.size(); k += 64)
+	{
+		T t = T();
+		for (std::size_t i = k; i < terms.size() && i < k+64; ++i)
+		{
+			t += terms[i];
+		}
+		partial.push_back(t);
+	}
+	while (partial.size() > 1)
+	{
+		std::vector<T> next;
+		for (std::size_t k = 0; k+1 < partial.size(); k += 2)
+		{
+			next.push_back(partial[k]+partial[k+1]);
+		}
+		if (partial.size() % 2 != 0)
+		{
+			next.push_back(partial.back());
+		}
+		partial.swap(next);
+	}
+	return partial.empty() ? T() : partial[0];
+}
+
+
+template <typename ValueT>
+void test_reproducible_vector_reduction(char const* name)
+{
+	std::cout << "[test_reproducible_vector_reduction<" << name << ">] BEGIN" << std::endl;
+
+	// Several levels of the combination tree, with an odd number of chunks
+	std::size_t n(64*37+5);
+
+	ublas::vector<ValueT> u(n);
+	ublas::vector<ValueT> v(n);
+	ublas::mapped_vector<ValueT> s(n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		u(i) = ValueT(1)/ValueT(i+1) - ValueT(0.3);
+		v(i) = ValueT(std::sin(double(i)));
+		if (i % 7 == 0)
+		{
+			s(i) = u(i);
+		}
+	}
+	ublas::vector<ValueT> sd(s);
+
+	std::vector<ValueT> t1(n), t2(n), tp(n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		t1[i] = std::fabs(u(i));
+		t2[i] = u(i)*u(i);
+		tp[i] = u(i)*v(i);
+	}
+
+	bool ok(true);
+	ValueT norm_1(ublas::reproducible_norm_1(u));
+	ValueT norm_2(ublas::reproducible_norm_2(u));
+	ValueT norm_inf(ublas::reproducible_norm_inf(u));
+	ValueT inner_prod(ublas::reproducible_inner_prod(u, v));
+	ok = ok && norm_1 == chunked_sum(t1);
+	ok = ok && norm_2 == std::sqrt(chunked_sum(t2));
+	ok = ok && norm_inf == ublas::norm_inf(u);
+	ok = ok && inner_prod == chunked_sum(tp);
+
+	// Same results for sparse and dense storage of the same values
+	ok = ok && ublas::reproducible_norm_1(s) == ublas::reproducible_norm_1(sd);
+	ok = ok && ublas::reproducible_norm_2(s) == ublas::reproducible_norm_2(sd);
+	ok = ok && ublas::reproducible_norm_inf(s) == ublas::reproducible_norm_inf(sd);
+	ok = ok && ublas::reproducible_inner_prod(s, v) == ublas::reproducible_inner_prod(sd, v);
+	ok = ok && ublas::reproducible_inner_prod(v, s) == ublas::reproducible_inner_prod(v, sd);
+
+	// The sparse operand drives the loop in either order: an infinity of the dense
+	// operand opposite an element which is not stored is not multiplied
+	ublas::vector<ValueT> w(v);
+	w(1) = std::numeric_limits<ValueT>::infinity();
+	ValueT sparse_dense(ublas::reproducible_inner_prod(s, w));
+	ok = ok && sparse_dense == ublas::reproducible_inner_prod(s, v);
+	ok = ok && ublas::reproducible_inner_prod(w, s) == sparse_dense;
+
+#ifdef _OPENMP
+	// Same results whatever the number of threads
+	for (int threads = 1; threads <= 8; ++threads)
+	{
+		omp_set_num_threads(threads);
+		ok = ok && ublas::reproducible_norm_1(u) == norm_1;
+		ok = ok && ublas::reproducible_norm_2(u) == norm_2;
+		ok = ok && ublas::reproducible_inner_prod(u, v) == inner_prod;
+	}
+#endif
+
+	if (ok)
+	{
+		std::cout << "[test_reproducible_vector_reduction<" << name << ">] Reductions succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_reproducible_vector_reduction<" << name << ">] Reductions failed." << std::endl;
+	}
+
+	std::cout << "[test_reproducible_vector_reduction<" << name << ">] END" << std::endl;
+}
+
+
+template <typename LayoutT>
+void test_reproducible_matrix_reduction(char const* name)
+{
+	std::cout << "[test_reproducible_matrix_reduction<" << name << ">] BEGIN" << std::endl;
+
+	std::size_t n1(53);
+	std::size_t n2(29);
+
+	ublas::matrix<std::complex<double>,LayoutT> A(n1,n2);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			A(i,j) = std::complex<double>(double(i)-double(j)/3, 1.0/(i+j+1));
+		}
+	}
+
+	// Line norms are computed in index order: they match the sequential ones
+	bool ok(true);
+	ok = ok && ublas::reproducible_norm_1(A) == ublas::norm_1(A);
+	ok = ok && ublas::reproducible_norm_inf(A) == ublas::norm_inf(A);
+	double f(ublas::reproducible_norm_frobenius(A));
+	ok = ok && std::fabs(f-ublas::norm_frobenius(A)) <= 1e-12*f;
+
+#ifdef _OPENMP
+	for (int threads = 1; threads <= 8; ++threads)
+	{
+		omp_set_num_threads(threads);
+		ok = ok && ublas::reproducible_norm_frobenius(A) == f;
+	}
+#endif
+
+	if (ok)
+	{
+		std::cout << "[test_reproducible_matrix_reduction<" << name << ">] Reductions succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_reproducible_matrix_reduction<" << name << ">] Reductions failed." << std::endl;
+	}
+
+	std::cout << "[test_reproducible_matrix_reduction<" << name << ">] END" << std::endl;
+}
+
+
+int main()
+{
+	test_reproducible_vector_reduction<double>("double");
+	test_reproducible_vector_reduction<float>("float");
+	test_reproducible_matrix_reduction<ublas::row_major>("row_major");
+	test_reproducible_matrix_reduction<ublas::column_major>("column_major");
+}
@@ -0,0 +1,343 @@
+// Enable the SIMD kernels for contiguous dense storage
+#define BOOST_UBLAS_SIMD
+
+#include <boost/numeric/ublas/io.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <complex>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+namespace ublas = boost::numeric::ublas;
+
+
+template <typename V1, typename V2>
+bool same_elements(V1 const& u, V2 const& v)
+{
+	if (u.size() != v.size())
+	{
+		return false;
+	}
+	for (std::size_t i = 0; i < u.size(); ++i)
+	{
+		if (u(i) != v(i))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+template <typename ValueT, typename ArrayT>
+void test_simd_vector_assign(char const* name)
+{
+	std::cout << "[test_simd_vector_assign<" << name << ">] BEGIN" << std::endl;
+
+	// Not a multiple of any SIMD width, so that the tails are exercised
+	std::size_t n(37);
+
+	ublas::vector<ValueT,ArrayT> u(n);
+	ublas::vector<ValueT,ArrayT> v(n);
+	ublas::vector<ValueT,ArrayT> res(n);
+
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		u(i) = ValueT(3*i+1)/ValueT(7);
+		v(i) = ValueT(i%5)+ValueT(1)/ValueT(3);
+	}
+
+	ublas::vector<ValueT,ArrayT> w(n);
+	w.assign(u);
+	w.plus_assign(v);
+	w.minus_assign(u);
+	w.plus_assign(u);
+	w *= ValueT(3);
+	w /= ValueT(7);
+	w += ublas::scalar_vector<ValueT>(n, ValueT(2));
+
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		ValueT x(u(i));
+		x += v(i);
+		x -= u(i);
+		x += u(i);
+		x *= ValueT(3);
+		x /= ValueT(7);
+		x += ValueT(2);
+		res(i) = x;
+	}
+
+	if (same_elements(w, res))
+	{
+		std::cout << "[test_simd_vector_assign<" << name << ">] Assignments succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_simd_vector_assign<" << name << ">] Assignments failed." << std::endl;
+	}
+
+	std::cout << "[test_simd_vector_assign<" << name << ">] END" << std::endl;
+}
+
+
+template <typename ValueT, typename LayoutT>
+void test_simd_matrix_assign(char const* name)
+{
+	std::cout << "[test_simd_matrix_assign<" << name << ">] BEGIN" << std::endl;
+
+	std::size_t n1(13);
+	std::size_t n2(7);
+
+	ublas::matrix<ValueT,LayoutT> A(n1,n2);
+	ublas::matrix<ValueT,LayoutT> B(n1,n2);
+	ublas::matrix<ValueT,LayoutT> RES(n1,n2);
+
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			A(i,j) = ValueT(i+1)/ValueT(j+3);
+			B(i,j) = ValueT(j)-ValueT(i)/ValueT(9);
+		}
+	}
+
+	ublas::matrix<ValueT,LayoutT> C(n1,n2);
+	C.assign(A);
+	C.minus_assign(B);
+	C.plus_assign(A);
+	C *= ValueT(5);
+	C /= ValueT(3);
+
+	bool ok(true);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			ValueT x(A(i,j));
+			x -= B(i,j);
+			x += A(i,j);
+			x *= ValueT(5);
+			x /= ValueT(3);
+			ok = ok && C(i,j) == x;
+		}
+	}
+
+	// Mixed layouts do not go through the kernels but must still work
+	ublas::matrix<ValueT,ublas::column_major> D(n1,n2);
+	D.assign(C);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			ok = ok && D(i,j) == C(i,j);
+		}
+	}
+
+	if (ok)
+	{
+		std::cout << "[test_simd_matrix_assign<" << name << ">] Assignments succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_simd_matrix_assign<" << name << ">] Assignments failed." << std::endl;
+	}
+
+	std::cout << "[test_simd_matrix_assign<" << name << ">] END" << std::endl;
+}
+
+
+template <typename ValueT, typename ExprValueT>
+void test_simd_convert_assign(char const* name)
+{
+	std::cout << "[test_simd_convert_assign<" << name << ">] BEGIN" << std::endl;
+
+	std::size_t n(37);
+	std::size_t n1(9);
+	std::size_t n2(5);
+
+	// Values which are not exactly representable in float, and large integers
+	ublas::vector<ExprValueT> e(n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		e(i) = ExprValueT(ExprValueT(16777213+2*i)/ExprValueT(3));
+	}
+	ublas::matrix<ExprValueT> E(n1,n2);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			E(i,j) = ExprValueT(ExprValueT(16777213+2*(i*n2+j))/ExprValueT(3));
+		}
+	}
+
+	bool ok(true);
+
+	ublas::vector<ValueT> v(n);
+	v.assign(e);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		ValueT x(e(i));
+		ok = ok && v(i) == x;
+	}
+
+	ublas::matrix<ValueT> M(n1,n2);
+	M = E;
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			ValueT x(E(i,j));
+			ok = ok && M(i,j) == x;
+		}
+	}
+
+	// Computed assignments keep the generic loop
+	v.plus_assign(e);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		ValueT x(e(i));
+		x += e(i);
+		ok = ok && v(i) == x;
+	}
+
+	if (ok)
+	{
+		std::cout << "[test_simd_convert_assign<" << name << ">] Assignments succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_simd_convert_assign<" << name << ">] Assignments failed." << std::endl;
+	}
+
+	std::cout << "[test_simd_convert_assign<" << name << ">] END" << std::endl;
+}
+
+
+template <typename ValueT, typename LayoutT>
+void test_simd_swap(char const* name)
+{
+	std::cout << "[test_simd_swap<" << name << ">] BEGIN" << std::endl;
+
+	std::size_t n1(23);
+	std::size_t n2(19);
+
+	ublas::matrix<ValueT,LayoutT> A(n1,n2);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			A(i,j) = ValueT(i*n2+j);
+		}
+	}
+	ublas::matrix<ValueT,LayoutT> A0(A);
+
+	bool ok(true);
+
+	// Rows and columns, contiguous or not depending on the layout
+	ublas::row(A, 2).swap(ublas::row(A, 9));
+	ublas::column(A, 1).swap(ublas::column(A, 5));
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		std::size_t ii(i == 2 ? 9 : (i == 9 ? 2 : i));
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			std::size_t jj(j == 1 ? 5 : (j == 5 ? 1 : j));
+			ok = ok && A(i,j) == A0(ii,jj);
+		}
+	}
+
+	// Sub-matrices of two matrices
+	A = A0;
+	ublas::matrix<ValueT,LayoutT> B(n1,n2);
+	B.assign(ublas::scalar_matrix<ValueT>(n1, n2, ValueT(-1)));
+	ublas::project(A, ublas::range(0,13), ublas::range(1,12)).swap(ublas::project(B, ublas::range(10,23), ublas::range(8,19)));
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			bool in_a(i < 13 && j >= 1 && j < 12);
+			bool in_b(i >= 10 && j >= 8);
+			ok = ok && A(i,j) == (in_a ? ValueT(-1) : A0(i,j));
+			ok = ok && B(i,j) == (in_b ? A0(i-10,j-7) : ValueT(-1));
+		}
+	}
+
+	// Ranges of vectors
+	ublas::vector<ValueT> u(n1);
+	ublas::vector<ValueT> v(n1);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		u(i) = ValueT(i);
+		v(i) = ValueT(100+i);
+	}
+	ublas::project(u, ublas::range(1,20)).swap(ublas::project(v, ublas::range(4,23)));
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		ok = ok && u(i) == ((i >= 1 && i < 20) ? ValueT(100+i+3) : ValueT(i));
+		ok = ok && v(i) == ((i >= 4) ? ValueT(i-3) : ValueT(100+i));
+	}
+
+	// Pivots of a partial pivoting LU factorization, on contiguous storage and not
+	ublas::vector<std::size_t> pm(n1);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		pm(i) = i+(i*7)%(n1-i);
+	}
+	ublas::matrix<ValueT,LayoutT> P(A0);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			std::swap(P(i,j), P(pm(i),j));
+		}
+	}
+	A = A0;
+	ublas::matrix_swap_rows(pm, A);
+	ublas::matrix<ValueT,LayoutT> C(A0);
+	ublas::matrix_slice< ublas::matrix<ValueT,LayoutT> > S(C, ublas::slice(0,1,n1), ublas::slice(0,1,n2));
+	ublas::matrix_swap_rows(pm, S);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			ok = ok && A(i,j) == P(i,j) && C(i,j) == P(i,j);
+		}
+	}
+
+	if (ok)
+	{
+		std::cout << "[test_simd_swap<" << name << ">] Swaps succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_simd_swap<" << name << ">] Swaps failed." << std::endl;
+	}
+
+	std::cout << "[test_simd_swap<" << name << ">] END" << std::endl;
+}
+
+
+int main()
+{
+	test_simd_vector_assign< double, ublas::unbounded_array<double> >("double");
+	test_simd_vector_assign< float, ublas::unbounded_array<float> >("float");
+	test_simd_vector_assign< double, std::vector<double> >("double,std::vector");
+	test_simd_vector_assign< int, ublas::unbounded_array<int> >("int");
+	test_simd_matrix_assign<double,ublas::row_major>("double,row_major");
+	test_simd_matrix_assign<float,ublas::column_major>("float,column_major");
+	test_simd_convert_assign<float,double>("float,double");
+	test_simd_convert_assign<double,float>("double,float");
+	test_simd_convert_assign<double,int>("double,int");
+	test_simd_convert_assign<float,int>("float,int");
+	test_simd_convert_assign<double,long>("double,long");
+	test_simd_convert_assign< std::complex<float>,std::complex<double> >("complex<float>,complex<double>");
+	test_simd_convert_assign< std::complex<double>,std::complex<float> >("complex<double>,complex<float>");
+	test_simd_swap<double,ublas::row_major>("double,row_major");
+	test_simd_swap<float,ublas::column_major>("float,column_major");
+	test_simd_swap<int,ublas::row_major>("int,row_major");
+	test_simd_swap< std::complex<double>,ublas::column_major >("complex<double>,column_major");
+}
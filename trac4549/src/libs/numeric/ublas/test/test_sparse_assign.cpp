@@ -0,0 +1,225 @@
+#include <boost/numeric/ublas/io.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_sparse.hpp>
+#include <cstddef>
+#include <iostream>
+
+namespace ublas = boost::numeric::ublas;
+
+typedef double value_type;
+
+
+template <typename M1, typename M2>
+bool same_elements(M1 const& A, M2 const& B)
+{
+	if (A.size1() != B.size1() || A.size2() != B.size2())
+	{
+		return false;
+	}
+	for (std::size_t i = 0; i < A.size1(); ++i)
+	{
+		for (std::size_t j = 0; j < A.size2(); ++j)
+		{
+			if (A(i,j) != B(i,j))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+
+template <typename MatrixT>
+void test_sparse_fill_in(char const* name)
+{
+	std::cout << "[test_sparse_fill_in<" << name << ">] BEGIN" << std::endl;
+
+	std::size_t n1(6);
+	std::size_t n2(5);
+
+	// Sparse patterns overlapping only in part, with empty rows and columns
+	// on both sides and fill-in at the start and the end of the slices
+	MatrixT A(n1,n2);
+	MatrixT B(n1,n2);
+	ublas::matrix<value_type> RES(n1,n2,0);
+
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			if (i != 2 && (i+j) % 3 == 0)
+			{
+				A(i,j) = i*n2+j+1;
+				RES(i,j) += i*n2+j+1;
+			}
+			if (j != 3 && (i*j) % 4 == 1 + i % 2)
+			{
+				B(i,j) = 100+i*n2+j;
+				RES(i,j) += 100+i*n2+j;
+			}
+		}
+	}
+	B(0,0) = 50;
+	RES(0,0) += 50;
+	B(n1-1,n2-1) = 60;
+	RES(n1-1,n2-1) += 60;
+	// Explicit zero: no fill-in is expected for it
+	B(2,1) = 0;
+
+	std::cerr << "[test_sparse_fill_in<" << name << ">] A: " << A << std::endl;
+	std::cerr << "[test_sparse_fill_in<" << name << ">] B: " << B << std::endl;
+
+	std::size_t nnz(A.nnz());
+
+	// Goes through make_conformant
+	A.plus_assign(B);
+
+	std::cerr << "[test_sparse_fill_in<" << name << ">] A+B: " << A << std::endl;
+
+	if (same_elements(A, RES))
+	{
+		std::cout << "[test_sparse_fill_in<" << name << ">] Fill-in plus_assign succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_sparse_fill_in<" << name << ">] Fill-in plus_assign failed." << std::endl;
+	}
+
+	// A second assignment with the same pattern must not add any element
+	nnz = A.nnz();
+	A.minus_assign(B);
+	RES -= B;
+
+	if (A.nnz() == nnz && same_elements(A, RES))
+	{
+		std::cout << "[test_sparse_fill_in<" << name << ">] Conformant minus_assign succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_sparse_fill_in<" << name << ">] Conformant minus_assign failed." << std::endl;
+	}
+
+	// Fill-in into an empty matrix
+	MatrixT C(n1,n2);
+	C.plus_assign(B);
+
+	if (same_elements(C, B))
+	{
+		std::cout << "[test_sparse_fill_in<" << name << ">] Fill-in into an empty matrix succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_sparse_fill_in<" << name << ">] Fill-in into an empty matrix failed." << std::endl;
+	}
+
+	std::cout << "[test_sparse_fill_in<" << name << ">] END" << std::endl;
+}
+
+
+template <typename VectorT, typename MatrixT>
+void test_sparse_gallop(char const* name)
+{
+	std::cout << "[test_sparse_gallop<" << name << ">] BEGIN" << std::endl;
+
+	// Gaps much longer than BOOST_UBLAS_GALLOP_THRESHOLD between the elements
+	// of the sparser operand, in both directions
+	std::size_t n(200);
+
+	VectorT u(n);
+	VectorT v(n);
+	ublas::vector<value_type> res(n,0);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		u(i) = i+1;
+		res(i) += i+1;
+		if (i % 61 == 7)
+		{
+			v(i) = 1000+i;
+			res(i) += 1000+i;
+		}
+	}
+
+	u.plus_assign(v);
+	bool ok(true);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		ok = ok && u(i) == res(i);
+	}
+	v.plus_assign(u);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		ok = ok && v(i) == res(i) + (i % 61 == 7 ? 1000+i : 0);
+	}
+	if (ok)
+	{
+		std::cout << "[test_sparse_gallop<" << name << ">] Vector plus_assign succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_sparse_gallop<" << name << ">] Vector plus_assign failed." << std::endl;
+	}
+
+	std::size_t n1(7);
+	std::size_t n2(150);
+
+	MatrixT A(n1,n2);
+	MatrixT B(n1,n2);
+	MatrixT C(n2,n1);
+	ublas::matrix<value_type> RES(n1,n2,0);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			A(i,j) = i*n2+j+1;
+			C(j,i) = -1;
+			RES(i,j) += i*n2+j+1;
+			if (i != 3 && (j+i) % 47 == 5)
+			{
+				B(i,j) = 0.5*j;
+				RES(i,j) += 0.5*j;
+			}
+		}
+	}
+
+	// Long gaps along the rows of row major and within the columns of column major targets
+	A.plus_assign(B);
+	C.minus_assign(ublas::trans(B));
+	ok = same_elements(A, RES);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			ok = ok && C(j,i) == -1 - B(i,j);
+		}
+	}
+	// Denser operand than the target
+	ublas::matrix<value_type> D(B);
+	B.minus_assign(A);
+	ok = ok && same_elements(B, D - RES);
+	if (ok)
+	{
+		std::cout << "[test_sparse_gallop<" << name << ">] Matrix plus_assign succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_sparse_gallop<" << name << ">] Matrix plus_assign failed." << std::endl;
+	}
+
+	std::cout << "[test_sparse_gallop<" << name << ">] END" << std::endl;
+}
+
+
+int main()
+{
+	test_sparse_fill_in< ublas::compressed_matrix<value_type,ublas::row_major> >("compressed_matrix<row_major>");
+	test_sparse_fill_in< ublas::compressed_matrix<value_type,ublas::column_major> >("compressed_matrix<column_major>");
+	test_sparse_fill_in< ublas::mapped_matrix<value_type,ublas::row_major> >("mapped_matrix<row_major>");
+	test_sparse_fill_in< ublas::mapped_matrix<value_type,ublas::column_major> >("mapped_matrix<column_major>");
+	test_sparse_fill_in< ublas::mapped_matrix<value_type,ublas::row_major,ublas::map_array<std::size_t,value_type> > >("mapped_matrix<row_major,map_array>");
+	test_sparse_gallop< ublas::compressed_vector<value_type>, ublas::compressed_matrix<value_type,ublas::row_major> >("compressed<row_major>");
+	test_sparse_gallop< ublas::compressed_vector<value_type>, ublas::compressed_matrix<value_type,ublas::column_major> >("compressed<column_major>");
+	test_sparse_gallop< ublas::mapped_vector<value_type>, ublas::mapped_matrix<value_type,ublas::row_major> >("mapped<row_major>");
+}
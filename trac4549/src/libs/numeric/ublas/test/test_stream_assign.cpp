@@ -0,0 +1,133 @@
+// Store every plain dense assignment with non temporal stores
+#define BOOST_UBLAS_STREAMING_STORES
+#define BOOST_UBLAS_STREAMING_THRESHOLD 0
+
+#include <boost/numeric/ublas/io.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <cstddef>
+#include <iostream>
+
+namespace ublas = boost::numeric::ublas;
+
+
+template <typename ValueT>
+void test_stream_vector_assign(char const* name)
+{
+	std::cout << "[test_stream_vector_assign<" << name << ">] BEGIN" << std::endl;
+
+	// Not a multiple of the store width, so that heads and tails are exercised
+	std::size_t n(37);
+
+	ublas::vector<ValueT> u(n);
+	ublas::vector<ValueT> v(n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		u(i) = ValueT(3*i+1)/ValueT(7);
+		v(i) = ValueT(i%5);
+	}
+
+	bool ok(true);
+	ublas::vector<ValueT> w(n);
+	w.assign(u + 2*v);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		ok = ok && w(i) == ValueT(u(i) + 2*v(i));
+	}
+	w.assign(ublas::scalar_vector<ValueT>(n, ValueT(5)));
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		ok = ok && w(i) == ValueT(5);
+	}
+	ublas::streaming_vector_assign(w, u);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		ok = ok && w(i) == u(i);
+	}
+	ublas::streaming_vector_assign_scalar(w, ValueT(-1));
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		ok = ok && w(i) == ValueT(-1);
+	}
+	if (ok)
+	{
+		std::cout << "[test_stream_vector_assign<" << name << ">] Assignments succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_stream_vector_assign<" << name << ">] Assignments failed." << std::endl;
+	}
+
+	std::cout << "[test_stream_vector_assign<" << name << ">] END" << std::endl;
+}
+
+
+template <typename ValueT, typename LayoutT>
+void test_stream_matrix_assign(char const* name)
+{
+	std::cout << "[test_stream_matrix_assign<" << name << ">] BEGIN" << std::endl;
+
+	// Odd sizes, so that the slices start at every alignment
+	std::size_t n1(13);
+	std::size_t n2(7);
+
+	ublas::matrix<ValueT,LayoutT> A(n1,n2);
+	ublas::matrix<ValueT,ublas::column_major> B(n1,n2);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			A(i,j) = ValueT(i*n2+j)/ValueT(3);
+			B(i,j) = ValueT(i)-ValueT(j);
+		}
+	}
+
+	bool ok(true);
+	ublas::matrix<ValueT,LayoutT> C(n1,n2);
+	C.assign(A - B);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			ok = ok && C(i,j) == ValueT(A(i,j) - B(i,j));
+		}
+	}
+	ublas::streaming_matrix_assign(C, B);
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			ok = ok && C(i,j) == B(i,j);
+		}
+	}
+	ublas::streaming_matrix_assign_scalar(C, ValueT(2));
+	for (std::size_t i = 0; i < n1; ++i)
+	{
+		for (std::size_t j = 0; j < n2; ++j)
+		{
+			ok = ok && C(i,j) == ValueT(2);
+		}
+	}
+	if (ok)
+	{
+		std::cout << "[test_stream_matrix_assign<" << name << ">] Assignments succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_stream_matrix_assign<" << name << ">] Assignments failed." << std::endl;
+	}
+
+	std::cout << "[test_stream_matrix_assign<" << name << ">] END" << std::endl;
+}
+
+
+int main()
+{
+	test_stream_vector_assign<double>("double");
+	test_stream_vector_assign<float>("float");
+	test_stream_vector_assign<int>("int");
+	test_stream_matrix_assign<double,ublas::row_major>("double,row_major");
+	test_stream_matrix_assign<double,ublas::column_major>("double,column_major");
+	test_stream_matrix_assign<float,ublas::row_major>("float,row_major");
+	test_stream_matrix_assign<int,ublas::column_major>("int,column_major");
+}
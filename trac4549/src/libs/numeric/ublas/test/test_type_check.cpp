@@ -0,0 +1,98 @@
+// Sampled type checks
+#define BOOST_UBLAS_TYPE_CHECK 1
+#define BOOST_UBLAS_TYPE_CHECK_SAMPLES 100
+
+#include <boost/numeric/ublas/exception.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/triangular.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_sparse.hpp>
+#include <cstddef>
+#include <iostream>
+
+namespace ublas = boost::numeric::ublas;
+
+typedef double value_type;
+
+
+template <typename LayoutT>
+void test_sampled_type_check(char const* name)
+{
+	std::cout << "[test_sampled_type_check<" << name << ">] BEGIN" << std::endl;
+
+	// More elements than samples
+	std::size_t n(300);
+
+	ublas::compressed_matrix<value_type,LayoutT> A(n,n);
+	ublas::compressed_matrix<value_type,LayoutT> B(n,n);
+	ublas::compressed_vector<value_type> u(n*n);
+	ublas::compressed_vector<value_type> v(n*n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		A(i,i) = i+1;
+		B(i,(i*7) % n) = 0.5*i;
+		u(i*n+i) = i+1;
+		v(i*7) = 0.5*i;
+	}
+
+	bool ok(true);
+	try
+	{
+		A.plus_assign(B);
+		u.plus_assign(v);
+	}
+	catch (ublas::external_logic const&)
+	{
+		ok = false;
+	}
+	if (ok)
+	{
+		std::cout << "[test_sampled_type_check<" << name << ">] Sampled check of a valid assignment succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_sampled_type_check<" << name << ">] Sampled check of a valid assignment failed." << std::endl;
+	}
+
+	// Fewer elements than samples: all of them are compared, so elements
+	// outside of the triangle are detected
+	std::size_t m(9);
+
+	ublas::matrix<value_type,LayoutT> D(m,m);
+	for (std::size_t i = 0; i < m; ++i)
+	{
+		for (std::size_t j = 0; j < m; ++j)
+		{
+			D(i,j) = i*m+j+1;
+		}
+	}
+	ublas::triangular_matrix<value_type,ublas::upper,LayoutT> U(m,m);
+	ok = false;
+	try
+	{
+		U.assign(D);
+	}
+	catch (ublas::external_logic const&)
+	{
+		ok = true;
+	}
+	if (ok)
+	{
+		std::cout << "[test_sampled_type_check<" << name << ">] Check of an invalid assignment succeeded." << std::endl;
+	}
+	else
+	{
+		std::cout << "[test_sampled_type_check<" << name << ">] Check of an invalid assignment failed." << std::endl;
+	}
+
+	std::cout << "[test_sampled_type_check<" << name << ">] END" << std::endl;
+}
+
+
+int main()
+{
+	test_sampled_type_check<ublas::row_major>("row_major");
+	test_sampled_type_check<ublas::column_major>("column_major");
+}